@@ -33,4 +33,6 @@
 
 #cmakedefine ENABLE_DISCORD
 
+#cmakedefine ENABLE_PROFILER
+
 #endif /*CONFIG_H*/
@@ -25,7 +25,9 @@
 #include "audio/dummy_sound_source.hpp"
 #include "audio/sound_file.hpp"
 #include "audio/stream_sound_source.hpp"
+#include "supertux/memory_usage.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 
 SoundManager::SoundManager() :
   m_device(alcOpenDevice(nullptr)),
@@ -33,6 +35,8 @@ SoundManager::SoundManager() :
   m_sound_enabled(false),
   m_sound_volume(0),
   m_buffers(),
+  m_buffer_sizes(),
+  m_buffer_bytes(0),
   m_sources(),
   m_update_list(),
   m_music_source(),
@@ -109,6 +113,28 @@ SoundManager::load_file_into_buffer(SoundFile& file)
   return buffer;
 }
 
+ALuint
+SoundManager::add_buffer(const std::string& filename, SoundFile& file)
+{
+  ALuint buffer = load_file_into_buffer(file);
+  m_buffers.insert(std::make_pair(filename, buffer));
+  m_buffer_sizes[filename] = file.m_size;
+  m_buffer_bytes += file.m_size;
+  return buffer;
+}
+
+void
+SoundManager::get_memory_usage(MemoryUsage& usage) const
+{
+  usage.add_category("sounds", "audio", m_buffer_bytes, m_buffer_sizes.size());
+  if (usage.wants_entries())
+  {
+    for (const auto& it : m_buffer_sizes) {
+      usage.add_entry(it.first, it.second);
+    }
+  }
+}
+
 std::unique_ptr<OpenALSoundSource>
 SoundManager::intern_create_sound_source(const std::string& filename)
 {
@@ -130,8 +156,7 @@ SoundManager::intern_create_sound_source(const std::string& filename)
     if (file->m_size < 100000) {
       log_debug << "Adding \"" << filename <<
         "\" into the buffer, file size: " << file->m_size << std::endl;
-      buffer = load_file_into_buffer(*file);
-      m_buffers.insert(std::make_pair(filename, buffer));
+      buffer = add_buffer(filename, *file);
     } else {
       log_debug << "Playing \"" << filename <<
         "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
@@ -176,8 +201,7 @@ SoundManager::preload(const std::string& filename)
     if (file->m_size >= 100000)
       return;
 
-    ALuint buffer = load_file_into_buffer(*file);
-    m_buffers.insert(std::make_pair(filename, buffer));
+    add_buffer(filename, *file);
   } catch(std::exception& e) {
     log_warning << "Error while preloading sound file: " << e.what() << std::endl;
   }
@@ -435,6 +459,8 @@ SoundManager::set_listener_orientation(const Vector& at, const Vector& up)
 void
 SoundManager::update()
 {
+  PROFILE_SCOPE("SoundManager::update");
+
   static Uint32 lasttime = SDL_GetTicks();
   Uint32 now = SDL_GetTicks();
 
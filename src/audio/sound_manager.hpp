@@ -28,6 +28,7 @@
 #include "math/vector.hpp"
 #include "util/currenton.hpp"
 
+class MemoryUsage;
 class SoundFile;
 class SoundSource;
 class StreamSoundSource;
@@ -103,10 +104,16 @@ public:
   /** Unsubscribe from updates for stream_sound_source. */
   void remove_from_update(StreamSoundSource* sss);
 
+  /** Adds the samples of the sounds kept in buffers */
+  void get_memory_usage(MemoryUsage& usage) const;
+
 private:
   /** creates a new sound source, might throw exceptions, never returns nullptr */
   std::unique_ptr<OpenALSoundSource> intern_create_sound_source(const std::string& filename);
 
+  /** Loads @c file into a buffer that is kept for @c filename */
+  ALuint add_buffer(const std::string& filename, SoundFile& file);
+
   void check_alc_error(const char* message) const;
 
 private:
@@ -116,6 +123,10 @@ private:
   int m_sound_volume;
 
   std::map<std::string, ALuint> m_buffers;
+
+  /** Bytes of the samples in m_buffers */
+  std::map<std::string, size_t> m_buffer_sizes;
+  size_t m_buffer_bytes;
   std::vector<std::unique_ptr<OpenALSoundSource> > m_sources;
 
   std::vector<StreamSoundSource*> m_update_list;
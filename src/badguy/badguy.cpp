@@ -28,6 +28,7 @@
 #include "object/water_drop.hpp"
 #include "sprite/sprite.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/activation_manager.hpp"
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
@@ -38,8 +39,8 @@ static const float SQUISH_TIME = 2;
 static const float GEAR_TIME = 2;
 static const float BURN_TIME = 1;
 
-static const float X_OFFSCREEN_DISTANCE = 1280;
-static const float Y_OFFSCREEN_DISTANCE = 800;
+const float BadGuy::X_OFFSCREEN_DISTANCE = 1280;
+const float BadGuy::Y_OFFSCREEN_DISTANCE = 800;
 
 BadGuy::BadGuy(const Vector& pos, const std::string& sprite_name_, int layer_,
                const std::string& light_sprite_name) :
@@ -196,7 +197,7 @@ BadGuy::update(float dt_sec)
 
     case STATE_BURNING: {
       m_is_active_flag = false;
-      m_col.m_movement = m_physic.get_movement(dt_sec);
+      m_col.set_movement(m_physic.get_movement(dt_sec));
       if ( m_sprite->animation_done() ) {
         remove_me();
       }
@@ -209,12 +210,12 @@ BadGuy::update(float dt_sec)
         remove_me();
         break;
       }
-      m_col.m_movement = m_physic.get_movement(dt_sec);
+      m_col.set_movement(m_physic.get_movement(dt_sec));
       break;
 
     case STATE_MELTING: {
       m_is_active_flag = false;
-      m_col.m_movement = m_physic.get_movement(dt_sec);
+      m_col.set_movement(m_physic.get_movement(dt_sec));
       if ( m_sprite->animation_done() || on_ground() ) {
         Sector::get().add<WaterDrop>(m_col.m_bbox.p1(), get_water_sprite(), m_physic.get_velocity());
         remove_me();
@@ -224,7 +225,7 @@ BadGuy::update(float dt_sec)
 
     case STATE_GROUND_MELTING:
       m_is_active_flag = false;
-      m_col.m_movement = m_physic.get_movement(dt_sec);
+      m_col.set_movement(m_physic.get_movement(dt_sec));
       if ( m_sprite->animation_done() ) {
         remove_me();
       }
@@ -232,7 +233,7 @@ BadGuy::update(float dt_sec)
 
     case STATE_INSIDE_MELTING: {
       m_is_active_flag = false;
-      m_col.m_movement = m_physic.get_movement(dt_sec);
+      m_col.set_movement(m_physic.get_movement(dt_sec));
       if ( on_ground() && m_sprite->animation_done() ) {
         m_sprite->set_action(m_dir == Direction::LEFT ? "gear-left" : "gear-right", 1);
         set_state(STATE_GEAR);
@@ -249,11 +250,17 @@ BadGuy::update(float dt_sec)
 
     case STATE_FALLING:
       m_is_active_flag = false;
-      m_col.m_movement = m_physic.get_movement(dt_sec);
+      m_col.set_movement(m_physic.get_movement(dt_sec));
       break;
   }
 
   m_on_ground_flag = false;
+
+  // inactive badguys do nothing until is_offscreen() turns false,
+  // which the activation manager can tell without updating them
+  if (m_state == STATE_INACTIVE && can_sleep()) {
+    Sector::get().get_activation_manager().make_dormant(*this, m_col.m_bbox.get_middle());
+  }
 }
 
 Direction
@@ -289,7 +296,7 @@ BadGuy::deactivate()
 void
 BadGuy::active_update(float dt_sec)
 {
-  m_col.m_movement = m_physic.get_movement(dt_sec);
+  m_col.set_movement(m_physic.get_movement(dt_sec));
   if (m_frozen)
     m_sprite->stop_animation();
 }
@@ -486,6 +493,7 @@ BadGuy::collision_bullet(Bullet& bullet, const CollisionHit& hit)
 void
 BadGuy::kill_squished(GameObject& object)
 {
+  wake_up();
   if (!is_active()) return;
 
   SoundManager::current()->play("sounds/squish.wav", get_pos());
@@ -506,6 +514,7 @@ BadGuy::kill_squished(GameObject& object)
 void
 BadGuy::kill_fall()
 {
+  wake_up();
   if (!is_active()) return;
 
   if (m_frozen) {
@@ -564,6 +573,10 @@ BadGuy::run_dead_script()
 void
 BadGuy::set_state(State state_)
 {
+  // state changes may come from other objects or scripts, which
+  // needs the badguy to be updated again
+  wake_up();
+
   if (m_state == state_)
     return;
 
@@ -625,6 +638,14 @@ BadGuy::is_offscreen() const
   return true;
 }
 
+bool
+BadGuy::can_sleep() const
+{
+  // while sleeping, update() can't remove the badguy once it leaves
+  // the sector, so only let it sleep where that can't happen
+  return is_valid() && !Editor::is_active() && Sector::get().inside_static(m_col.m_bbox);
+}
+
 void
 BadGuy::try_activate()
 {
@@ -709,6 +730,7 @@ BadGuy::get_floor_normal() const
 void
 BadGuy::freeze()
 {
+  wake_up();
   set_group(COLGROUP_MOVING_STATIC);
   m_frozen = true;
 
@@ -731,6 +753,7 @@ BadGuy::freeze()
 void
 BadGuy::unfreeze()
 {
+  wake_up();
   set_group(m_colgroup_active);
   m_frozen = false;
 
@@ -763,6 +786,8 @@ BadGuy::is_in_water() const
 void
 BadGuy::ignite()
 {
+  wake_up();
+
   if (!is_flammable() || m_ignited) {
     return;
   }
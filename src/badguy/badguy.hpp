@@ -33,6 +33,12 @@ class Bullet;
 class BadGuy : public MovingSprite,
                public ExposedObject<BadGuy, scripting::BadGuy>
 {
+public:
+  /** Badguys further away than this from the camera and the players
+      are deactivated */
+  static const float X_OFFSCREEN_DISTANCE;
+  static const float Y_OFFSCREEN_DISTANCE;
+
 public:
   BadGuy(const Vector& pos, const std::string& sprite_name, int layer = LAYER_OBJECTS,
          const std::string& light_sprite_name = "images/objects/lightmap_light/lightmap_light-medium.sprite");
@@ -164,7 +170,8 @@ protected:
   /** called each frame when the badguy is activated. */
   virtual void active_update(float dt_sec);
 
-  /** called each frame when the badguy is not activated. */
+  /** called each frame when the badguy is not activated. Not called
+      while the badguy sleeps in the sector's ActivationManager. */
   virtual void inactive_update(float dt_sec);
 
   /** called immediately before the first call to initialize */
@@ -227,6 +234,10 @@ protected:
 private:
   void try_activate();
 
+  /** Returns true if the badguy may be left out of the updates until
+      the camera or a player comes close */
+  bool can_sleep() const;
+
 protected:
   Physic m_physic;
 
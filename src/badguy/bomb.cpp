@@ -75,7 +75,7 @@ Bomb::active_update(float dt_sec)
     explode();
   }
   else if (!is_grabbed()) {
-    m_col.m_movement = m_physic.get_movement(dt_sec);
+    m_col.set_movement(m_physic.get_movement(dt_sec));
   }
 }
 
@@ -119,7 +119,7 @@ void
 Bomb::grab(MovingObject& object, const Vector& pos, Direction dir_)
 {
   Portable::grab(object, pos, dir_);
-  m_col.m_movement = pos - get_pos();
+  m_col.set_movement(pos - get_pos());
   m_dir = dir_;
 
   // We actually face the opposite direction of Tux here to make the fuse more
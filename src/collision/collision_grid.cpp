@@ -0,0 +1,298 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/collision_grid.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+
+#include "collision/collision_object.hpp"
+#include "math/rectf.hpp"
+
+namespace {
+
+const float CELL_SIZE = 128.0f;
+
+/** Objects spanning more cells than this go to the list of large
+    objects instead of being registered in every cell */
+const int64_t MAX_CELLS_PER_OBJECT = 64;
+
+/** Keeps cell coordinates of degenerate rectangles within int range */
+const float MAX_COORDINATE = 1.0e9f;
+
+int to_cell(float coordinate)
+{
+  const float clamped = std::max(-MAX_COORDINATE, std::min(coordinate, MAX_COORDINATE));
+  return static_cast<int>(floorf(clamped / CELL_SIZE));
+}
+
+uint64_t cell_key(int x, int y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+int cell_key_x(uint64_t key)
+{
+  return static_cast<int>(static_cast<uint32_t>(key >> 32));
+}
+
+int cell_key_y(uint64_t key)
+{
+  return static_cast<int>(static_cast<uint32_t>(key & 0xffffffff));
+}
+
+int64_t cell_count(const Rect& cells)
+{
+  return static_cast<int64_t>(cells.get_width()) * static_cast<int64_t>(cells.get_height());
+}
+
+bool is_large(const Rect& cells)
+{
+  return cell_count(cells) > MAX_CELLS_PER_OBJECT;
+}
+
+Rect to_cells(float left, float top, float right, float bottom)
+{
+  // collision::intersects() treats touching edges as overlapping, so
+  // the right and bottom edges are inclusive here as well
+  return Rect(to_cell(left), to_cell(top),
+              to_cell(right) + 1, to_cell(bottom) + 1);
+}
+
+/** The cells of a rectangle given by its corners */
+Rect to_cells(const Vector& p1, const Vector& p2)
+{
+  return to_cells(p1.x, p1.y, p2.x, p2.y);
+}
+
+/** The area an object can be found in during a collision step,
+    covering both its current and its anticipated position. Kept as
+    corners, going through Rectf would round the right and bottom
+    edges. */
+Vector get_area_p1(const Rectf& bbox, const Rectf& dest)
+{
+  return Vector(std::min(bbox.get_left(), dest.get_left()),
+                std::min(bbox.get_top(), dest.get_top()));
+}
+
+Vector get_area_p2(const Rectf& bbox, const Rectf& dest)
+{
+  return Vector(std::max(bbox.get_right(), dest.get_right()),
+                std::max(bbox.get_bottom(), dest.get_bottom()));
+}
+
+size_t index_of(const std::vector<CollisionObject*>& objects, const CollisionObject* object)
+{
+  auto it = std::find(objects.begin(), objects.end(), object);
+  assert(it != objects.end());
+  return static_cast<size_t>(it - objects.begin());
+}
+
+} // namespace
+
+CollisionGrid::CollisionGrid() :
+  m_cells(),
+  m_large_objects(),
+  m_overlapping(),
+  m_next_order(1),
+  m_generation(0)
+{
+}
+
+void
+CollisionGrid::add(CollisionObject& object)
+{
+  object.m_grid = this;
+  object.m_grid_order = m_next_order++;
+  object.m_grid_p1 = get_area_p1(object.m_bbox, object.m_dest);
+  object.m_grid_p2 = get_area_p2(object.m_bbox, object.m_dest);
+  link(object, to_cells(object.m_grid_p1, object.m_grid_p2));
+  m_generation += 1;
+}
+
+void
+CollisionGrid::remove(CollisionObject& object)
+{
+  unlink(object);
+  object.m_grid = nullptr;
+  object.m_grid_order = 0;
+  m_generation += 1;
+}
+
+void
+CollisionGrid::update(CollisionObject& object)
+{
+  const Vector p1 = get_area_p1(object.m_bbox, object.m_dest);
+  const Vector p2 = get_area_p2(object.m_bbox, object.m_dest);
+  if (p1 == object.m_grid_p1 && p2 == object.m_grid_p2)
+    return;
+
+  object.m_grid_p1 = p1;
+  object.m_grid_p2 = p2;
+
+  const Rect cells = to_cells(p1, p2);
+  if (cells == object.m_grid_cells)
+  {
+    store_area(object);
+  }
+  else
+  {
+    unlink(object);
+    link(object, cells);
+  }
+  m_generation += 1;
+}
+
+void
+CollisionGrid::query(const Rectf& rect, uint64_t after_order,
+                     std::vector<CollisionObject*>& result) const
+{
+  result.clear();
+
+  const Rect cells = to_cells(rect.get_left(), rect.get_top(),
+                              rect.get_right(), rect.get_bottom());
+
+  if (cell_count(cells) <= static_cast<int64_t>(m_cells.size()))
+  {
+    for (int x = cells.left; x < cells.right; ++x) {
+      for (int y = cells.top; y < cells.bottom; ++y) {
+        auto it = m_cells.find(cell_key(x, y));
+        if (it != m_cells.end()) {
+          append_overlapping(it->second, rect, after_order, result);
+        }
+      }
+    }
+  }
+  else
+  {
+    // huge query rectangle, cheaper to walk the occupied cells
+    for (const auto& cell : m_cells) {
+      if (cells.contains(cell_key_x(cell.first), cell_key_y(cell.first))) {
+        append_overlapping(cell.second, rect, after_order, result);
+      }
+    }
+  }
+
+  append_overlapping(m_large_objects, rect, after_order, result);
+
+  std::sort(result.begin(), result.end(),
+            [](const CollisionObject* lhs, const CollisionObject* rhs) {
+              return lhs->m_grid_order < rhs->m_grid_order;
+            });
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+void
+CollisionGrid::append_overlapping(const Cell& cell, const Rectf& rect, uint64_t after_order,
+                                  std::vector<CollisionObject*>& result) const
+{
+  m_overlapping.clear();
+  cell.areas.get_overlapping(rect, m_overlapping);
+
+  for (const auto index : m_overlapping) {
+    CollisionObject* object = cell.objects[index];
+    if (object->m_grid_order > after_order) {
+      result.push_back(object);
+    }
+  }
+}
+
+void
+CollisionGrid::link(CollisionObject& object, const Rect& cells)
+{
+  object.m_grid_cells = cells;
+
+  auto insert = [&object](Cell& cell) {
+    cell.objects.push_back(&object);
+    cell.areas.push_back(object.m_grid_p1.x, object.m_grid_p1.y,
+                         object.m_grid_p2.x, object.m_grid_p2.y);
+  };
+
+  if (is_large(cells))
+  {
+    insert(m_large_objects);
+  }
+  else
+  {
+    for (int x = cells.left; x < cells.right; ++x) {
+      for (int y = cells.top; y < cells.bottom; ++y) {
+        insert(m_cells[cell_key(x, y)]);
+      }
+    }
+  }
+}
+
+void
+CollisionGrid::unlink(CollisionObject& object)
+{
+  const Rect& cells = object.m_grid_cells;
+
+  auto erase = [&object](Cell& cell) {
+    const size_t index = index_of(cell.objects, &object);
+    cell.objects[index] = cell.objects.back();
+    cell.objects.pop_back();
+    cell.areas.swap_remove(index);
+  };
+
+  if (is_large(cells))
+  {
+    erase(m_large_objects);
+  }
+  else
+  {
+    for (int x = cells.left; x < cells.right; ++x) {
+      for (int y = cells.top; y < cells.bottom; ++y) {
+        auto it = m_cells.find(cell_key(x, y));
+        assert(it != m_cells.end());
+        erase(it->second);
+
+        // drop emptied cells, otherwise the map keeps every cell any
+        // object ever passed through
+        if (it->second.objects.empty()) {
+          m_cells.erase(it);
+        }
+      }
+    }
+  }
+}
+
+void
+CollisionGrid::store_area(CollisionObject& object)
+{
+  const Rect& cells = object.m_grid_cells;
+
+  auto store = [&object](Cell& cell) {
+    cell.areas.set(index_of(cell.objects, &object),
+                   object.m_grid_p1.x, object.m_grid_p1.y,
+                   object.m_grid_p2.x, object.m_grid_p2.y);
+  };
+
+  if (is_large(cells))
+  {
+    store(m_large_objects);
+  }
+  else
+  {
+    for (int x = cells.left; x < cells.right; ++x) {
+      for (int y = cells.top; y < cells.bottom; ++y) {
+        store(m_cells[cell_key(x, y)]);
+      }
+    }
+  }
+}
+
+/* EOF */
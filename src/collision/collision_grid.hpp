@@ -0,0 +1,107 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_COLLISION_COLLISION_GRID_HPP
+#define HEADER_SUPERTUX_COLLISION_COLLISION_GRID_HPP
+
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+#include "collision/packed_rects.hpp"
+#include "math/rect.hpp"
+
+class CollisionObject;
+class Rectf;
+
+/** Uniform grid broadphase for the CollisionSystem. Every object is
+    registered in all cells touched by its bounding box and its
+    anticipated destination, so a query only has to look at the
+    objects near the queried rectangle instead of all objects of the
+    sector. Each cell also keeps a packed copy of the area of its
+    objects, so queries only hand out the objects that actually
+    overlap the queried rectangle without touching the others.
+
+    Moving or resizing an object through the CollisionObject setters
+    keeps the grid up to date. Direct writes to m_bbox are only picked
+    up when the CollisionSystem moves the object in its next update, so
+    they must not be used on objects already in a sector. */
+class CollisionGrid final
+{
+public:
+  CollisionGrid();
+
+  void add(CollisionObject& object);
+  void remove(CollisionObject& object);
+
+  /** Refreshes the stored area of the object after its bounding box
+      or destination changed, moving it to different cells if needed */
+  void update(CollisionObject& object);
+
+  /** Fills @c result with every object whose bounding box or
+      destination may overlap @c rect and that was added after the
+      object with order @c after_order. The objects are returned
+      without duplicates and in the order they were added to the
+      grid. */
+  void query(const Rectf& rect, uint64_t after_order,
+             std::vector<CollisionObject*>& result) const;
+
+  /** Changes every time an object moves or is added or removed, so
+      that running iterations over a query result can tell when it is
+      outdated */
+  uint32_t get_generation() const { return m_generation; }
+
+private:
+  struct Cell
+  {
+    Cell() : objects(), areas() {}
+
+    std::vector<CollisionObject*> objects;
+
+    /** The union of bounding box and destination of each object,
+        in the same order as @c objects */
+    PackedRects areas;
+  };
+
+private:
+  void link(CollisionObject& object, const Rect& cells);
+  void unlink(CollisionObject& object);
+  void store_area(CollisionObject& object);
+
+  void append_overlapping(const Cell& cell, const Rectf& rect, uint64_t after_order,
+                          std::vector<CollisionObject*>& result) const;
+
+private:
+  std::unordered_map<uint64_t, Cell> m_cells;
+
+  /** Objects covering too many cells to be copied into each of them,
+      these are checked in every query */
+  Cell m_large_objects;
+
+  /** Scratch space for the indices handed out by PackedRects */
+  mutable std::vector<size_t> m_overlapping;
+
+  uint64_t m_next_order;
+  uint32_t m_generation;
+
+private:
+  CollisionGrid(const CollisionGrid&) = delete;
+  CollisionGrid& operator=(const CollisionGrid&) = delete;
+};
+
+#endif
+
+/* EOF */
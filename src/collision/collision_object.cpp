@@ -17,7 +17,9 @@
 
 #include "collision/collision_object.hpp"
 
+#include "collision/collision_grid.hpp"
 #include "collision/collision_listener.hpp"
+#include "collision/collision_system.hpp"
 #include "supertux/game_object.hpp"
 
 CollisionObject::CollisionObject(CollisionGroup group, CollisionListener& listener) :
@@ -25,7 +27,14 @@ CollisionObject::CollisionObject(CollisionGroup group, CollisionListener& listen
   m_bbox(),
   m_movement(),
   m_group(group),
-  m_dest()
+  m_dest(),
+  m_system(nullptr),
+  m_active(false),
+  m_grid(nullptr),
+  m_grid_order(0),
+  m_grid_p1(),
+  m_grid_p2(),
+  m_grid_cells()
 {
 }
 
@@ -53,6 +62,38 @@ CollisionObject::collision_tile(uint32_t tile_attributes)
   m_listener.collision_tile(tile_attributes);
 }
 
+void
+CollisionObject::set_group(CollisionGroup group)
+{
+  if (group == m_group)
+    return;
+
+  const CollisionGroup old_group = m_group;
+  m_group = group;
+
+  if (m_system) {
+    m_system->update_group(*this, old_group);
+  }
+}
+
+void
+CollisionObject::set_movement(const Vector& movement)
+{
+  m_movement = movement;
+
+  if (m_system && !m_active && movement != Vector(0.0f, 0.0f)) {
+    m_system->activate(*this);
+  }
+}
+
+void
+CollisionObject::update_grid()
+{
+  if (m_grid) {
+    m_grid->update(*this);
+  }
+}
+
 bool
 CollisionObject::is_valid() const
 {
@@ -22,13 +22,17 @@
 
 #include "collision/collision_group.hpp"
 #include "collision/collision_hit.hpp"
+#include "math/rect.hpp"
 #include "math/rectf.hpp"
 
+class CollisionGrid;
 class CollisionListener;
+class CollisionSystem;
 class GameObject;
 
 class CollisionObject
 {
+  friend class CollisionGrid;
   friend class CollisionSystem;
 
 public:
@@ -59,6 +63,11 @@ public:
     return m_movement;
   }
 
+  /** Sets the movement that will happen till next frame. Objects
+      outside of the moving collision groups are only moved by the
+      CollisionSystem after they were given a movement through here. */
+  void set_movement(const Vector& movement);
+
   /** places the moving object at a specific position. Be careful when
       using this function. There are no collision detection checks
       performed here so bad things could happen. */
@@ -66,6 +75,7 @@ public:
   {
     m_dest.move(pos - get_pos());
     m_bbox.set_pos(pos);
+    update_grid();
   }
 
   Vector get_pos() const
@@ -88,6 +98,7 @@ public:
   {
     m_dest.set_width(w);
     m_bbox.set_width(w);
+    update_grid();
   }
 
   /** sets the moving object's bbox to a specific size. Be careful
@@ -97,6 +108,7 @@ public:
   {
     m_dest.set_size(w, h);
     m_bbox.set_size(w, h);
+    update_grid();
   }
 
   CollisionGroup get_group() const
@@ -104,6 +116,11 @@ public:
     return m_group;
   }
 
+  /** Moves the object to another collision group, this has to go
+      through here so the CollisionSystem can keep its per-group lists
+      up to date */
+  void set_group(CollisionGroup group);
+
   bool is_valid() const;
 
   CollisionListener& get_listener()
@@ -111,6 +128,11 @@ public:
     return m_listener;
   }
 
+private:
+  /** Tells the broadphase grid the object is registered in that its
+      bounding box changed */
+  void update_grid();
+
 private:
   CollisionListener& m_listener;
 
@@ -119,13 +141,13 @@ public:
       this isn't necessarily the bounding box for graphics) */
   Rectf m_bbox;
 
+private:
   /** The movement that will happen till next frame */
   Vector m_movement;
 
   /** The collision group */
   CollisionGroup m_group;
 
-private:
   /** this is only here for internal collision detection use (don't touch this
       from outside collision detection code)
 
@@ -133,6 +155,25 @@ private:
       during collision detection */
   Rectf m_dest;
 
+  /** The CollisionSystem the object is registered in, if any */
+  CollisionSystem* m_system;
+
+  /** Whether the object is in the list of objects the
+      CollisionSystem has to move in its next update */
+  bool m_active;
+
+  /** The CollisionGrid the object is registered in, if any */
+  CollisionGrid* m_grid;
+
+  /** Broadphase bookkeeping of the CollisionGrid: the order in which
+      the object was added, the corners of the area covered by its
+      bounding box and destination and the range of cells it
+      currently occupies */
+  uint64_t m_grid_order;
+  Vector m_grid_p1;
+  Vector m_grid_p2;
+  Rect m_grid_cells;
+
 private:
   CollisionObject(const CollisionObject&) = delete;
   CollisionObject& operator=(const CollisionObject&) = delete;
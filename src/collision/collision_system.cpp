@@ -17,6 +17,8 @@
 
 #include "collision/collision_system.hpp"
 
+#include <assert.h>
+
 #include "collision/collision.hpp"
 #include "editor/editor.hpp"
 #include "math/aatriangle.hpp"
@@ -26,6 +28,7 @@
 #include "supertux/constants.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
+#include "util/profiler.hpp"
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 
@@ -40,22 +43,107 @@ const float DELTA = .002f;
 
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
-  m_objects()
+  m_objects(),
+  m_grid(),
+  m_groups(),
+  m_active(),
+  m_moved(),
+  m_candidates(),
+  m_tested_pairs(0)
 {
 }
 
 void
 CollisionSystem::add(CollisionObject* object)
 {
+  // m_dest is only meaningful during update(), start it out at the
+  // object's position so it doesn't inflate the area in the grid
+  object->m_dest = object->m_bbox;
+
+  object->m_system = this;
   m_objects.push_back(object);
+  m_grid.add(*object);
+
+  // the object was added last, so this keeps the list ordered
+  m_groups[object->get_group()].push_back(object);
+
+  if (object->m_movement != Vector(0.0f, 0.0f)) {
+    activate(*object);
+  }
 }
 
 void
 CollisionSystem::remove(CollisionObject* object)
 {
+  remove_from_group(*object, object->get_group());
+
+  if (object->m_active) {
+    m_active.erase(std::find(m_active.begin(), m_active.end(), object));
+    object->m_active = false;
+  }
+
+  m_grid.remove(*object);
   m_objects.erase(
     std::find(m_objects.begin(), m_objects.end(),
               object));
+  object->m_system = nullptr;
+}
+
+void
+CollisionSystem::update_group(CollisionObject& object, CollisionGroup old_group)
+{
+  remove_from_group(object, old_group);
+
+  auto& objects = m_groups[object.get_group()];
+  objects.insert(std::lower_bound(objects.begin(), objects.end(), &object,
+                                  [](const CollisionObject* lhs, const CollisionObject* rhs) {
+                                    return lhs->m_grid_order < rhs->m_grid_order;
+                                  }),
+                 &object);
+}
+
+void
+CollisionSystem::remove_from_group(CollisionObject& object, CollisionGroup group)
+{
+  auto& objects = m_groups[group];
+  auto it = std::lower_bound(objects.begin(), objects.end(), &object,
+                             [](const CollisionObject* lhs, const CollisionObject* rhs) {
+                               return lhs->m_grid_order < rhs->m_grid_order;
+                             });
+  assert(it != objects.end() && *it == &object);
+  objects.erase(it);
+}
+
+void
+CollisionSystem::activate(CollisionObject& object)
+{
+  assert(!object.m_active);
+  object.m_active = true;
+  m_active.push_back(&object);
+}
+
+void
+CollisionSystem::collect_moved_objects()
+{
+  m_moved.clear();
+
+  const auto is_moving = [](CollisionGroup group) {
+    return (group == COLGROUP_MOVING ||
+            group == COLGROUP_MOVING_STATIC ||
+            group == COLGROUP_MOVING_ONLY_STATIC);
+  };
+
+  for (const auto& group : { COLGROUP_MOVING, COLGROUP_MOVING_STATIC, COLGROUP_MOVING_ONLY_STATIC }) {
+    m_moved.insert(m_moved.end(), m_groups[group].begin(), m_groups[group].end());
+  }
+
+  for (const auto& object : m_active) {
+    object->m_active = false;
+    if (!is_moving(object->get_group())) {
+      m_moved.push_back(object);
+    }
+  }
+  m_active.clear();
 }
 
 void
@@ -93,6 +181,68 @@ CollisionSystem::draw(DrawingContext& context)
   }
 }
 
+template<typename F>
+void
+CollisionSystem::for_each_candidate(const Rectf& rect, const CollisionObject* after, F func) const
+{
+  uint64_t after_order = after ? after->m_grid_order : 0;
+  Rectf query_rect = rect;
+  uint32_t generation = m_grid.get_generation();
+
+  // only update() iterates candidates and it never nests the
+  // iterations, so the scratch buffer can be shared
+  m_grid.query(query_rect, after_order, m_candidates);
+
+  size_t i = 0;
+  while (i < m_candidates.size())
+  {
+    CollisionObject& candidate = *m_candidates[i];
+    after_order = candidate.m_grid_order;
+    m_tested_pairs += 1;
+    func(candidate);
+    i += 1;
+
+    // collision responses may have moved objects around
+    if (generation != m_grid.get_generation() || !(rect == query_rect))
+    {
+      query_rect = rect;
+      generation = m_grid.get_generation();
+      m_grid.query(query_rect, after_order, m_candidates);
+      i = 0;
+    }
+  }
+}
+
+template<typename F>
+void
+CollisionSystem::for_each_in_groups(std::initializer_list<CollisionGroup> groups, F func) const
+{
+  uint64_t after_order = 0;
+  while (true)
+  {
+    // the lists may change in func(), so look up the next object
+    // anew each time instead of holding on to iterators
+    CollisionObject* next = nullptr;
+    for (const auto& group : groups)
+    {
+      const auto& objects = m_groups[group];
+      auto it = std::upper_bound(objects.begin(), objects.end(), after_order,
+                                 [](uint64_t order, const CollisionObject* object) {
+                                   return order < object->m_grid_order;
+                                 });
+      if (it != objects.end() && (!next || (*it)->m_grid_order < next->m_grid_order)) {
+        next = *it;
+      }
+    }
+
+    if (!next)
+      break;
+
+    after_order = next->m_grid_order;
+    func(*next);
+  }
+}
+
 namespace {
 
 /** r1 is supposed to be moving, r2 a solid object */
@@ -186,44 +336,39 @@ CollisionSystem::collision_tilemap(collision::Constraints* constraints,
     // test with all tiles in this rectangle
     const Rect test_tiles = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2));
 
-    for (int x = test_tiles.left; x < test_tiles.right; ++x)
+    solids->for_each_flagged_tile(test_tiles, [&](int x, int y, uint32_t flags)
     {
-      for (int y = test_tiles.top; y < test_tiles.bottom; ++y)
-      {
-        const Tile& tile = solids->get_tile(x, y);
-
-        // skip non-solid tiles
-        if (!tile.is_solid ())
-          continue;
-        Rectf tile_bbox = solids->get_tile_bbox(x, y);
-
-        /* If the tile is a unisolid tile, the "is_solid()" function above
-         * didn't do a thorough check. Calculate the position and (relative)
-         * movement of the object and determine whether or not the tile is
-         * solid with regard to those parameters. */
-        if (tile.is_unisolid ()) {
-          Vector relative_movement = movement
-            - solids->get_movement(/* actual = */ true);
-
-          if (!tile.is_solid (tile_bbox, object.get_bbox(), relative_movement))
-            continue;
-        }
-
-        if (tile.is_slope ()) { // slope tile
-          AATriangle triangle;
-          int slope_data = tile.get_data();
-          if (solids->get_flip() & VERTICAL_FLIP)
-            slope_data = AATriangle::vertical_flip(slope_data);
-          triangle = AATriangle(tile_bbox, slope_data);
-
-          collision::rectangle_aatriangle(constraints, dest, triangle,
-              solids->get_movement(/* actual = */ false));
-        } else { // normal rectangular tile
-          check_collisions(constraints, movement, dest, tile_bbox, nullptr, nullptr,
-              solids->get_movement(/* actual = */ false));
-        }
+      // skip non-solid tiles
+      if (!(flags & Tile::SOLID))
+        return;
+      Rectf tile_bbox = solids->get_tile_bbox(x, y);
+
+      /* If the tile is a unisolid tile, the SOLID flag above didn't do
+       * a thorough check. Calculate the position and (relative)
+       * movement of the object and determine whether or not the tile is
+       * solid with regard to those parameters. */
+      if (flags & Tile::UNISOLID) {
+        Vector relative_movement = movement
+          - solids->get_movement(/* actual = */ true);
+
+        if (!solids->get_tile(x, y).is_solid (tile_bbox, object.get_bbox(), relative_movement))
+          return;
       }
-    }
+
+      if (flags & Tile::SLOPE) { // slope tile
+        AATriangle triangle;
+        int slope_data = TileMap::get_flags_slope_data(flags);
+        if (solids->get_flip() & VERTICAL_FLIP)
+          slope_data = AATriangle::vertical_flip(slope_data);
+        triangle = AATriangle(tile_bbox, slope_data);
+
+        collision::rectangle_aatriangle(constraints, dest, triangle,
+            solids->get_movement(/* actual = */ false));
+      } else { // normal rectangular tile
+        check_collisions(constraints, movement, dest, tile_bbox, nullptr, nullptr,
+            solids->get_movement(/* actual = */ false));
+      }
+    });
   }
 }
 
@@ -244,22 +389,24 @@ CollisionSystem::collision_tile_attributes(const Rectf& dest, const Vector& mov)
     // For ice (only), add a little fudge to recognize tiles Tux is standing on.
     const Rect test_tiles_ice = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2 + SHIFT_DELTA));
 
-    for (int x = test_tiles.left; x < test_tiles.right; ++x) {
-      int y;
-      for (y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
+    auto is_collisionful = [&](int x, int y, uint32_t flags) {
+      return !(flags & Tile::UNISOLID) ||
+             solids->get_tile(x, y).is_collisionful(solids->get_tile_bbox(x, y), dest, mov);
+    };
 
-        if ( tile.is_collisionful( solids->get_tile_bbox(x, y), dest, mov) ) {
-          result |= tile.get_attributes();
-        }
+    solids->for_each_flagged_tile(test_tiles, [&](int x, int y, uint32_t flags) {
+      if (is_collisionful(x, y, flags)) {
+        result |= TileMap::get_flags_attributes(flags);
       }
-      for (; y < test_tiles_ice.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-        if ( tile.is_collisionful( solids->get_tile_bbox(x, y), dest, mov) ) {
-          result |= (tile.get_attributes() & Tile::ICE);
-        }
+    });
+
+    const Rect test_tiles_below(test_tiles.left, std::max(test_tiles.top, test_tiles.bottom),
+                                test_tiles.right, test_tiles_ice.bottom);
+    solids->for_each_flagged_tile(test_tiles_below, [&](int x, int y, uint32_t flags) {
+      if (is_collisionful(x, y, flags)) {
+        result |= (flags & Tile::ICE);
       }
-    }
+    });
   }
 
   return result;
@@ -344,19 +491,19 @@ CollisionSystem::collision_static(collision::Constraints* constraints,
   collision_tilemap(constraints, movement, dest, object);
 
   // collision with other (static) objects
-  for (auto& static_object : m_objects)
+  for_each_candidate(dest, nullptr, [&](CollisionObject& static_object)
   {
-    if (static_object->get_group() != COLGROUP_STATIC &&
-        static_object->get_group() != COLGROUP_MOVING_STATIC)
-      continue;
-    if (!static_object->is_valid())
-      continue;
-
-    if (static_object != &object) {
-      check_collisions(constraints, movement, dest, static_object->m_bbox,
-                       &object, static_object);
+    if (static_object.get_group() != COLGROUP_STATIC &&
+        static_object.get_group() != COLGROUP_MOVING_STATIC)
+      return;
+    if (!static_object.is_valid())
+      return;
+
+    if (&static_object != &object) {
+      check_collisions(constraints, movement, dest, static_object.m_bbox,
+                       &object, &static_object);
     }
-  }
+  });
 }
 
 void
@@ -481,6 +628,8 @@ CollisionSystem::collision_static_constrains(CollisionObject& object)
 void
 CollisionSystem::update()
 {
+  PROFILE_SCOPE("CollisionSystem::update");
+
   if (Editor::is_active()) {
     return;
     //Oběcts in editor shouldn't collide.
@@ -488,8 +637,13 @@ CollisionSystem::update()
 
   using namespace collision;
 
+  // objects outside the moving groups keep their position unless
+  // they were given a movement, so only the moving groups and the
+  // activated objects need a destination
+  collect_moved_objects();
+
   // calculate destination positions of the objects
-  for (const auto& object : m_objects)
+  for (const auto& object : m_moved)
   {
     const Vector mov = object->get_movement();
 
@@ -501,88 +655,99 @@ CollisionSystem::update()
 
     object->m_dest = object->get_bbox();
     object->m_dest.move(object->get_movement());
+    m_grid.update(*object);
   }
 
   // part1: COLGROUP_MOVING vs COLGROUP_STATIC and tilemap
-  for (const auto& object : m_objects) {
-    if ((object->get_group() != COLGROUP_MOVING
-        && object->get_group() != COLGROUP_MOVING_STATIC
-        && object->get_group() != COLGROUP_MOVING_ONLY_STATIC)
-       || !object->is_valid())
-      continue;
-
-    collision_static_constrains(*object);
-  }
+  for_each_in_groups({ COLGROUP_MOVING, COLGROUP_MOVING_STATIC, COLGROUP_MOVING_ONLY_STATIC },
+                     [this](CollisionObject& object)
+  {
+    if (!object.is_valid())
+      return;
+
+    collision_static_constrains(object);
+    m_grid.update(object);
+  });
 
   // part2: COLGROUP_MOVING vs tile attributes
-  for (const auto& object : m_objects) {
-    if ((object->get_group() != COLGROUP_MOVING
-        && object->get_group() != COLGROUP_MOVING_STATIC
-        && object->get_group() != COLGROUP_MOVING_ONLY_STATIC)
-       || !object->is_valid())
-      continue;
-
-    uint32_t tile_attributes = collision_tile_attributes(object->m_dest, object->get_movement());
+  for_each_in_groups({ COLGROUP_MOVING, COLGROUP_MOVING_STATIC, COLGROUP_MOVING_ONLY_STATIC },
+                     [this](CollisionObject& object)
+  {
+    if (!object.is_valid())
+      return;
+
+    uint32_t tile_attributes = collision_tile_attributes(object.m_dest, object.get_movement());
     if (tile_attributes >= Tile::FIRST_INTERESTING_FLAG) {
-      object->collision_tile(tile_attributes);
+      object.collision_tile(tile_attributes);
     }
-  }
+  });
 
   // part2.5: COLGROUP_MOVING vs COLGROUP_TOUCHABLE
-  for (const auto& object : m_objects)
+  for_each_in_groups({ COLGROUP_MOVING, COLGROUP_MOVING_STATIC },
+                     [this](CollisionObject& object)
   {
-    if ((object->get_group() != COLGROUP_MOVING
-        && object->get_group() != COLGROUP_MOVING_STATIC)
-       || !object->is_valid())
-      continue;
+    if (!object.is_valid())
+      return;
 
-    for (auto& object_2 : m_objects) {
-      if (object_2->get_group() != COLGROUP_TOUCHABLE
-         || !object_2->is_valid())
-        continue;
+    for_each_candidate(object.m_dest, nullptr, [&object](CollisionObject& object_2)
+    {
+      if (object_2.get_group() != COLGROUP_TOUCHABLE
+         || !object_2.is_valid())
+        return;
 
-      if (intersects(object->m_dest, object_2->m_dest)) {
+      if (intersects(object.m_dest, object_2.m_dest)) {
         Vector normal;
         CollisionHit hit;
-        get_hit_normal(object->m_dest, object_2->m_dest,
+        get_hit_normal(object.m_dest, object_2.m_dest,
                        hit, normal);
-        if (!object->collides(*object_2, hit))
-          continue;
-        if (!object_2->collides(*object, hit))
-          continue;
+        if (!object.collides(object_2, hit))
+          return;
+        if (!object_2.collides(object, hit))
+          return;
 
-        object->collision(*object_2, hit);
-        object_2->collision(*object, hit);
+        object.collision(object_2, hit);
+        object_2.collision(object, hit);
       }
-    }
-  }
+    });
+  });
 
   // part3: COLGROUP_MOVING vs COLGROUP_MOVING
-  for (auto i = m_objects.begin(); i != m_objects.end(); ++i)
+  for_each_in_groups({ COLGROUP_MOVING, COLGROUP_MOVING_STATIC },
+                     [this](CollisionObject& object)
   {
-    auto object = *i;
-
-    if ((object->get_group() != COLGROUP_MOVING
-        && object->get_group() != COLGROUP_MOVING_STATIC)
-       || !object->is_valid())
-      continue;
-
-    for (auto i2 = i+1; i2 != m_objects.end(); ++i2) {
-      auto object_2 = *i2;
-      if ((object_2->get_group() != COLGROUP_MOVING
-          && object_2->get_group() != COLGROUP_MOVING_STATIC)
-         || !object_2->is_valid())
-        continue;
+    if (!object.is_valid())
+      return;
 
-      collision_object(object, object_2);
-    }
+    // only look at objects added after this one, so every pair is
+    // handled once
+    for_each_candidate(object.m_dest, &object, [this, &object](CollisionObject& object_2)
+    {
+      if ((object_2.get_group() != COLGROUP_MOVING
+          && object_2.get_group() != COLGROUP_MOVING_STATIC)
+         || !object_2.is_valid())
+        return;
+
+      collision_object(&object, &object_2);
+      m_grid.update(object);
+      m_grid.update(object_2);
+    });
+  });
+
+  // apply object movement, this includes objects that left the
+  // moving groups during the collision responses
+  for (const auto& object : m_moved) {
+    object->m_bbox = object->m_dest;
+    object->m_movement = Vector(0, 0);
+    m_grid.update(*object);
   }
 
-  // apply object movement
-  for (const auto& object : m_objects) {
-    object->m_bbox = object->m_dest;
+  // movements given during the collision responses came too late for
+  // this update and are dropped like those of the moved objects
+  for (const auto& object : m_active) {
+    object->m_active = false;
     object->m_movement = Vector(0, 0);
   }
+  m_active.clear();
 }
 
 bool
@@ -594,26 +759,28 @@ CollisionSystem::is_free_of_tiles(const Rectf& rect, const bool ignoreUnisolid)
     // test with all tiles in this rectangle
     const Rect test_tiles = solids->get_tiles_overlapping(rect);
 
-    for (int x = test_tiles.left; x < test_tiles.right; ++x) {
-      for (int y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-
-        if (!(tile.get_attributes() & Tile::SOLID))
-          continue;
-        if (tile.is_unisolid () && ignoreUnisolid)
-          continue;
-        if (tile.is_slope ()) {
-          AATriangle triangle;
-          const Rectf tbbox = solids->get_tile_bbox(x, y);
-          triangle = AATriangle(tbbox, tile.get_data());
-          Constraints constraints;
-          if (!collision::rectangle_aatriangle(&constraints, rect, triangle))
-            continue;
-        }
-        // We have a solid tile that overlaps the given rectangle.
-        return false;
+    bool is_free = true;
+    solids->for_each_flagged_tile(test_tiles, [&](int x, int y, uint32_t flags) {
+      if (!is_free)
+        return;
+      if (!(flags & Tile::SOLID))
+        return;
+      if ((flags & Tile::UNISOLID) && ignoreUnisolid)
+        return;
+      if (flags & Tile::SLOPE) {
+        AATriangle triangle;
+        const Rectf tbbox = solids->get_tile_bbox(x, y);
+        triangle = AATriangle(tbbox, TileMap::get_flags_slope_data(flags));
+        Constraints constraints;
+        if (!collision::rectangle_aatriangle(&constraints, rect, triangle))
+          return;
       }
-    }
+      // We have a solid tile that overlaps the given rectangle.
+      is_free = false;
+    });
+
+    if (!is_free)
+      return false;
   }
 
   return true;
@@ -626,7 +793,9 @@ CollisionSystem::is_free_of_statics(const Rectf& rect, const CollisionObject* ig
 
   if (!is_free_of_tiles(rect, ignoreUnisolid)) return false;
 
-  for (const auto& object : m_objects) {
+  std::vector<CollisionObject*> candidates;
+  m_grid.query(rect, 0, candidates);
+  for (const auto& object : candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if (object->get_group() == COLGROUP_STATIC) {
@@ -644,7 +813,9 @@ CollisionSystem::is_free_of_movingstatics(const Rectf& rect, const CollisionObje
 
   if (!is_free_of_tiles(rect)) return false;
 
-  for (const auto& object : m_objects) {
+  std::vector<CollisionObject*> candidates;
+  m_grid.query(rect, 0, candidates);
+  for (const auto& object : candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -679,7 +850,9 @@ CollisionSystem::free_line_of_sight(const Vector& line_start, const Vector& line
   }
 
   // check if no object is in the way
-  for (const auto& object : m_objects) {
+  std::vector<CollisionObject*> candidates;
+  m_grid.query(Rectf(lsx, lsy, lex, ley), 0, candidates);
+  for (const auto& object : candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -697,7 +870,14 @@ CollisionSystem::get_nearby_objects (const Vector& center, float max_distance) c
 {
   std::vector<CollisionObject*> ret;
 
-  for (const auto& object : m_objects) {
+  // anchored at the middle, so the bbox of every object within
+  // max_distance overlaps this square
+  const Rectf area(center - Vector(max_distance, max_distance),
+                   Sizef(2.0f * max_distance, 2.0f * max_distance));
+
+  std::vector<CollisionObject*> candidates;
+  m_grid.query(area, 0, candidates);
+  for (const auto& object : candidates) {
     float distance = object->get_bbox().distance(center);
     if (distance <= max_distance)
       ret.push_back(object);
@@ -18,10 +18,14 @@
 #ifndef HEADER_SUPERTUX_COLLISION_COLLISION_SYSTEM_HPP
 #define HEADER_SUPERTUX_COLLISION_COLLISION_SYSTEM_HPP
 
+#include <array>
+#include <initializer_list>
 #include <vector>
 #include <stdint.h>
 
 #include "collision/collision.hpp"
+#include "collision/collision_grid.hpp"
+#include "collision/collision_group.hpp"
 
 class CollisionObject;
 class DrawingContext;
@@ -31,6 +35,8 @@ class Vector;
 
 class CollisionSystem final
 {
+  friend class CollisionObject;
+
 public:
   CollisionSystem(Sector& sector);
 
@@ -52,6 +58,10 @@ public:
 
   std::vector<CollisionObject*> get_nearby_objects(const Vector& center, float max_distance) const;
 
+  /** Number of object pairs tested for collisions so far, after the
+      grid picked them as candidates */
+  size_t get_tested_pairs() const { return m_tested_pairs; }
+
 private:
   /** Does collision detection of an object against all other static
       objects (and the tilemap) in the level. Collision response is
@@ -75,9 +85,53 @@ private:
 
   void collision_static_constrains(CollisionObject& object);
 
+  /** Calls @c func for all objects overlapping @c rect in the order
+      they were added, skipping the objects added before @c after when
+      given. The candidates are refreshed whenever @c rect or the grid
+      changes during the iteration, so collision responses that move
+      objects around are seen just like with a scan over all objects. */
+  template<typename F>
+  void for_each_candidate(const Rectf& rect, const CollisionObject* after, F func) const;
+
+  /** Calls @c func for all objects that are in one of @c groups at the
+      time they are reached, in the order they were added. Only the
+      per-group lists are looked at, objects switching groups during
+      the iteration are handled like in a scan over all objects. */
+  template<typename F>
+  void for_each_in_groups(std::initializer_list<CollisionGroup> groups, F func) const;
+
+  /** Moves the object from the list of @c old_group to the list of
+      its current group */
+  void update_group(CollisionObject& object, CollisionGroup old_group);
+  void remove_from_group(CollisionObject& object, CollisionGroup group);
+
+  /** Remembers that the object was given a movement, so update()
+      moves it even if it is not in one of the moving groups */
+  void activate(CollisionObject& object);
+
+  /** Fills m_moved with the objects that update() has to move: all
+      objects of the moving groups and the activated ones */
+  void collect_moved_objects();
+
 private:
   Sector& m_sector;
   std::vector<CollisionObject*>  m_objects;
+  CollisionGrid m_grid;
+
+  /** The objects of each collision group, in the order they were
+      added */
+  std::array<std::vector<CollisionObject*>, COLGROUP_TOUCHABLE + 1> m_groups;
+
+  /** Objects given a movement since the last update() */
+  std::vector<CollisionObject*> m_active;
+
+  /** The objects moved during the running update() */
+  std::vector<CollisionObject*> m_moved;
+
+  /** Scratch space for the candidates of for_each_candidate() */
+  mutable std::vector<CollisionObject*> m_candidates;
+
+  mutable size_t m_tested_pairs;
 
 private:
   CollisionSystem(const CollisionSystem&) = delete;
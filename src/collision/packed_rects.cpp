@@ -0,0 +1,156 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/packed_rects.hpp"
+
+#if defined(__AVX__)
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define SUPERTUX_PACKED_RECTS_SSE2
+#endif
+
+#include "math/rectf.hpp"
+
+namespace {
+
+/** Appends the set bits of an overlap mask as indices starting at
+    @c base */
+void append_mask(int mask, size_t base, std::vector<size_t>& result)
+{
+  for (size_t bit = 0; mask != 0; ++bit, mask >>= 1) {
+    if (mask & 1) {
+      result.push_back(base + bit);
+    }
+  }
+}
+
+} // namespace
+
+PackedRects::PackedRects() :
+  m_left(),
+  m_top(),
+  m_right(),
+  m_bottom()
+{
+}
+
+void
+PackedRects::push_back(float left, float top, float right, float bottom)
+{
+  m_left.push_back(left);
+  m_top.push_back(top);
+  m_right.push_back(right);
+  m_bottom.push_back(bottom);
+}
+
+void
+PackedRects::set(size_t index, float left, float top, float right, float bottom)
+{
+  m_left[index] = left;
+  m_top[index] = top;
+  m_right[index] = right;
+  m_bottom[index] = bottom;
+}
+
+void
+PackedRects::swap_remove(size_t index)
+{
+  m_left[index] = m_left.back();
+  m_top[index] = m_top.back();
+  m_right[index] = m_right.back();
+  m_bottom[index] = m_bottom.back();
+
+  m_left.pop_back();
+  m_top.pop_back();
+  m_right.pop_back();
+  m_bottom.pop_back();
+}
+
+void
+PackedRects::clear()
+{
+  m_left.clear();
+  m_top.clear();
+  m_right.clear();
+  m_bottom.clear();
+}
+
+void
+PackedRects::get_overlapping(const Rectf& rect, std::vector<size_t>& result) const
+{
+  const size_t count = m_left.size();
+  size_t i = 0;
+
+#if defined(__AVX__)
+  const __m256 left = _mm256_set1_ps(rect.get_left());
+  const __m256 top = _mm256_set1_ps(rect.get_top());
+  const __m256 right = _mm256_set1_ps(rect.get_right());
+  const __m256 bottom = _mm256_set1_ps(rect.get_bottom());
+
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m256 apart_x = _mm256_or_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_right[i]), left, _CMP_LT_OQ),
+                                        _mm256_cmp_ps(_mm256_loadu_ps(&m_left[i]), right, _CMP_GT_OQ));
+    const __m256 apart_y = _mm256_or_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_bottom[i]), top, _CMP_LT_OQ),
+                                        _mm256_cmp_ps(_mm256_loadu_ps(&m_top[i]), bottom, _CMP_GT_OQ));
+    append_mask(~_mm256_movemask_ps(_mm256_or_ps(apart_x, apart_y)) & 0xff, i, result);
+  }
+#elif defined(SUPERTUX_PACKED_RECTS_SSE2)
+  const __m128 left = _mm_set1_ps(rect.get_left());
+  const __m128 top = _mm_set1_ps(rect.get_top());
+  const __m128 right = _mm_set1_ps(rect.get_right());
+  const __m128 bottom = _mm_set1_ps(rect.get_bottom());
+
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 apart_x = _mm_or_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_right[i]), left),
+                                     _mm_cmpgt_ps(_mm_loadu_ps(&m_left[i]), right));
+    const __m128 apart_y = _mm_or_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_bottom[i]), top),
+                                     _mm_cmpgt_ps(_mm_loadu_ps(&m_top[i]), bottom));
+    append_mask(~_mm_movemask_ps(_mm_or_ps(apart_x, apart_y)) & 0xf, i, result);
+  }
+#endif
+
+  // remainder that doesn't fill a whole register
+  get_overlapping_from(rect, i, result);
+}
+
+void
+PackedRects::get_overlapping_scalar(const Rectf& rect, std::vector<size_t>& result) const
+{
+  get_overlapping_from(rect, 0, result);
+}
+
+void
+PackedRects::get_overlapping_from(const Rectf& rect, size_t begin, std::vector<size_t>& result) const
+{
+  const float left = rect.get_left();
+  const float top = rect.get_top();
+  const float right = rect.get_right();
+  const float bottom = rect.get_bottom();
+
+  for (size_t i = begin; i < m_left.size(); ++i)
+  {
+    if (m_right[i] < left || m_left[i] > right ||
+        m_bottom[i] < top || m_top[i] > bottom)
+      continue;
+
+    result.push_back(i);
+  }
+}
+
+/* EOF */
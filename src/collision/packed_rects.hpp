@@ -0,0 +1,69 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_COLLISION_PACKED_RECTS_HPP
+#define HEADER_SUPERTUX_COLLISION_PACKED_RECTS_HPP
+
+#include <stddef.h>
+#include <vector>
+
+class Rectf;
+
+/** A list of rectangles stored as separate arrays of left, top,
+    right and bottom coordinates, so that overlap tests can check
+    several rectangles at once with SSE2 or AVX. */
+class PackedRects final
+{
+public:
+  PackedRects();
+
+  size_t size() const { return m_left.size(); }
+  bool empty() const { return m_left.empty(); }
+
+  void push_back(float left, float top, float right, float bottom);
+  void set(size_t index, float left, float top, float right, float bottom);
+
+  /** Removes the rectangle at @c index by moving the last one into
+      its place */
+  void swap_remove(size_t index);
+
+  void clear();
+
+  /** Appends the indices of all rectangles overlapping @c rect to
+      @c result, in ascending order. Touching edges count as
+      overlapping, same as in collision::intersects(). */
+  void get_overlapping(const Rectf& rect, std::vector<size_t>& result) const;
+
+  /** Same as get_overlapping(), but without SIMD */
+  void get_overlapping_scalar(const Rectf& rect, std::vector<size_t>& result) const;
+
+private:
+  void get_overlapping_from(const Rectf& rect, size_t begin, std::vector<size_t>& result) const;
+
+private:
+  std::vector<float> m_left;
+  std::vector<float> m_top;
+  std::vector<float> m_right;
+  std::vector<float> m_bottom;
+
+private:
+  PackedRects(const PackedRects&) = delete;
+  PackedRects& operator=(const PackedRects&) = delete;
+};
+
+#endif
+
+/* EOF */
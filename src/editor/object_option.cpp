@@ -23,7 +23,10 @@
 #include "editor/object_menu.hpp"
 #include "gui/menu.hpp"
 #include "object/tilemap.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "util/gettext.hpp"
+#include "util/tile_encoding.hpp"
 #include "util/writer.hpp"
 #include "video/color.hpp"
 
@@ -459,7 +462,11 @@ TilesObjectOption::save(Writer& write) const
 {
   write.write("width", m_tilemap->get_width());
   write.write("height", m_tilemap->get_height());
-  write.write("tiles", m_tilemap->get_tiles(), m_tilemap->get_width());
+  if (g_config->editor_compress_tiles) {
+    write.write("tiles-rle", TileEncoding::encode(m_tilemap->get_tiles()));
+  } else {
+    write.write("tiles", m_tilemap->get_tiles(), m_tilemap->get_width());
+  }
 }
 
 std::string
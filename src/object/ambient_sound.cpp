@@ -39,7 +39,7 @@ AmbientSound::AmbientSound(const ReaderMapping& mapping) :
   targetvolume(),
   currentvolume(0)
 {
-  m_col.m_group = COLGROUP_DISABLED;
+  set_group(COLGROUP_DISABLED);
 
   float w, h;
   mapping.get("x", m_col.m_bbox.get_left(), 0.0f);
@@ -88,7 +88,7 @@ AmbientSound::AmbientSound(const Vector& pos, float factor, float bias, float vo
   targetvolume(),
   currentvolume()
 {
-  m_col.m_group = COLGROUP_DISABLED;
+  set_group(COLGROUP_DISABLED);
 
   m_col.m_bbox.set_pos(pos);
   m_col.m_bbox.set_size(32, 32);
@@ -227,7 +227,7 @@ AmbientSound::set_pos(const Vector& pos)
 void
 AmbientSound::set_pos(float x, float y)
 {
-  m_col.m_bbox.set_pos(Vector(x, y));
+  m_col.set_pos(Vector(x, y));
 }
 
 float
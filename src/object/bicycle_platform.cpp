@@ -43,7 +43,7 @@ BicyclePlatformChild::update(float dt_sec)
   angle = math::positive_fmodf(angle, math::TAU);
 
   Vector dest = m_parent.m_center + Vector(cosf(angle), sinf(angle)) * m_parent.m_radius - (m_col.m_bbox.get_size().as_vector() * 0.5);
-  m_col.m_movement = dest - get_pos();
+  m_col.set_movement(dest - get_pos());
 }
 
 HitResponse
@@ -19,12 +19,10 @@
 #include "math/random.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
-#include "video/surface_batch.hpp"
 
 CloudParticleSystem::CloudParticleSystem() :
   ParticleSystem(128),
   ExposedObject<CloudParticleSystem, scripting::Clouds>(this),
-  cloudimage(Surface::from_file("images/particles/cloud.png")),
 
   m_current_speed(1.f),
   m_target_speed(1.f),
@@ -41,7 +39,6 @@ CloudParticleSystem::CloudParticleSystem() :
 CloudParticleSystem::CloudParticleSystem(const ReaderMapping& reader) :
   ParticleSystem(reader, 128),
   ExposedObject<CloudParticleSystem, scripting::Clouds>(this),
-  cloudimage(Surface::from_file("images/particles/cloud.png")),
 
   m_current_speed(1.f),
   m_target_speed(1.f),
@@ -61,6 +58,11 @@ CloudParticleSystem::~CloudParticleSystem()
 
 void CloudParticleSystem::init()
 {
+  particles.textures = { Surface::from_file("images/particles/cloud.png") };
+  for (int i = 0; i < CHANNEL_COUNT; ++i) {
+    particles.add_channel();
+  }
+
   virtual_width = 2000.0;
 
   // create some random clouds
@@ -96,37 +98,31 @@ void CloudParticleSystem::update(float dt_sec)
     }
   }
 
-  for (auto& particle : particles) {
-    auto cloudParticle = dynamic_cast<CloudParticle*>(particle.get());
-    if (!cloudParticle)
-      continue;
-    cloudParticle->pos.x += cloudParticle->speed * dt_sec * m_current_speed;
-    
+  particles.move(Vector(dt_sec * m_current_speed, 0.0f));
+
+  auto& target_alpha = particles.channel(TARGET_ALPHA);
+  auto& target_time_remaining = particles.channel(TARGET_TIME_REMAINING);
+
+  for (size_t i = 0; i < particles.size(); ++i) {
     // Update alpha
-    if (cloudParticle->target_time_remaining > 0.f) {
-      if (dt_sec >= cloudParticle->target_time_remaining) {
-        cloudParticle->alpha = cloudParticle->target_alpha;
-        cloudParticle->target_time_remaining = 0.f;
-        if (cloudParticle->alpha == 0.f) {
-          // Remove this particle
-          // But not right here, else it'd mess with the iterator
-        }
+    if (target_time_remaining[i] > 0.f) {
+      if (dt_sec >= target_time_remaining[i]) {
+        particles.alpha[i] = target_alpha[i];
+        target_time_remaining[i] = 0.f;
       } else {
-        float amount = dt_sec / cloudParticle->target_time_remaining;
-        cloudParticle->alpha += (cloudParticle->target_alpha - cloudParticle->alpha) * amount;
-        cloudParticle->target_time_remaining -= dt_sec;
+        float amount = dt_sec / target_time_remaining[i];
+        particles.alpha[i] += (target_alpha[i] - particles.alpha[i]) * amount;
+        target_time_remaining[i] -= dt_sec;
       }
     }
   }
 
   // Clear dead clouds
-  // Scroll through the vector backwards, because removing an element affects
-  //   the index of all elements after it (prevents buggy behavior)
+  // Scroll through the particles backwards, so that the one moved into
+  //   the place of a removed one has been checked already
   for (int i = static_cast<int>(particles.size()) - 1; i >= 0; --i) {
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-    
-    if (particle->target_alpha == 0.f && particle->target_time_remaining == 0.f)
-      particles.erase(particles.begin()+i);
+    if (target_alpha[i] == 0.f && target_time_remaining[i] == 0.f)
+      particles.swap_remove(i);
   }
 }
 
@@ -140,16 +136,13 @@ int CloudParticleSystem::add_clouds(int amount, float fade_time)
   int amount_to_add = target_amount - m_current_real_amount;
 
   for (int i = 0; i < amount_to_add; ++i) {
-    auto particle = std::make_unique<CloudParticle>();
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(virtual_height);
-    particle->texture = cloudimage;
-    particle->speed = -graphicsRandom.randf(25.0, 54.0);
-    particle->alpha = (fade_time == 0.f) ? 1.f : 0.f;
-    particle->target_alpha = 1.f;
-    particle->target_time_remaining = fade_time;
-
-    particles.push_back(std::move(particle));
+    const float x = graphicsRandom.randf(virtual_width);
+    const float y = graphicsRandom.randf(virtual_height);
+    const size_t index = particles.add(x, y, 0);
+    particles.speed[index] = -graphicsRandom.randf(25.0, 54.0);
+    particles.alpha[index] = (fade_time == 0.f) ? 1.f : 0.f;
+    particles.channel(TARGET_ALPHA)[index] = 1.f;
+    particles.channel(TARGET_TIME_REMAINING)[index] = fade_time;
   }
 
   m_current_real_amount = target_amount;
@@ -168,13 +161,14 @@ int CloudParticleSystem::remove_clouds(int amount, float fade_time)
   int i = 0;
   for (; i < amount_to_remove && i < static_cast<int>(particles.size()); ++i) {
   
-    auto particle = dynamic_cast<CloudParticle*>(particles.at(i).get());
-    if (particle->target_alpha != 1.f || particle->target_time_remaining != 0.f) {
+    auto& target_alpha = particles.channel(TARGET_ALPHA)[i];
+    auto& target_time_remaining = particles.channel(TARGET_TIME_REMAINING)[i];
+    if (target_alpha != 1.f || target_time_remaining != 0.f) {
       // Skip that one, it doesn't count
       --i;
     } else {
-      particle->target_alpha = 0.f;
-      particle->target_time_remaining = fade_time;
+      target_alpha = 0.f;
+      target_time_remaining = fade_time;
     }
   }
 
@@ -218,38 +212,7 @@ void CloudParticleSystem::draw(DrawingContext& context)
     return;
 
   context.push_transform();
-
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles) {
-    if (particle->alpha != 1.f) {
-      const auto& batch_it = batches.emplace(
-          particle->texture->clone(),
-          SurfaceBatch(
-              particle->texture,
-              Color(1.f, 1.f, 1.f, particle->alpha)
-          ));
-      batch_it.first->second.draw(particle->pos, particle->angle);
-    } else {
-      auto it = batches.find(particle->texture);
-      if (it == batches.end()) {
-        const auto& batch_it = batches.emplace(particle->texture,
-          SurfaceBatch(particle->texture));
-        batch_it.first->second.draw(particle->pos, particle->angle);
-      } else {
-        it->second.draw(particle->pos, particle->angle);
-      }
-    }
-  }
-
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    // FIXME: What is the colour used for?
-    // RESOLVED : That's the tint and the alpha
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), batch.get_color(), z_pos);
-  }
-
+  particles.draw(context.color(), z_pos);
   context.pop_transform();
 }
 
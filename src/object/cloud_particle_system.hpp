@@ -60,22 +60,13 @@ private:
   int remove_clouds(int amount, float fade_time);
 
 private:
-  class CloudParticle : public Particle
-  {
-  public:
-    float speed;
-    float target_alpha;
-    float target_time_remaining;
-
-    CloudParticle() :
-      speed(),
-      target_alpha(),
-      target_time_remaining()
-    {}
+  /** Per particle properties besides the ones of ParticlePool */
+  enum Channel {
+    TARGET_ALPHA,
+    TARGET_TIME_REMAINING,
+    CHANNEL_COUNT
   };
 
-  SurfacePtr cloudimage;
-
   float m_current_speed;
   float m_target_speed;
   float m_speed_fade_time_remaining;
@@ -150,6 +150,7 @@ Explosion::collision(GameObject& other, const CollisionHit& )
 
   auto badguy = dynamic_cast<BadGuy*>(&other);
   if (badguy != nullptr) {
+    badguy->wake_up();
     badguy->kill_fall();
   }
 
@@ -59,11 +59,11 @@ FallBlock::update(float dt_sec)
       }
       break;
     case FALL:
-      m_col.m_movement = physic.get_movement (dt_sec);
+      m_col.set_movement(physic.get_movement (dt_sec));
       set_group(COLGROUP_MOVING_STATIC);
       break;
     case LAND:
-      m_col.m_movement = physic.get_movement (dt_sec);
+      m_col.set_movement(physic.get_movement (dt_sec));
 	    set_group(COLGROUP_MOVING_STATIC);
       break;
   }
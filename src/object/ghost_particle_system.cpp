@@ -45,22 +45,22 @@ GhostParticleSystem::~GhostParticleSystem()
 void
 GhostParticleSystem::init()
 {
-  ghosts[0] = Surface::from_file("images/particles/ghost0.png");
-  ghosts[1] = Surface::from_file("images/particles/ghost1.png");
+  particles.textures = {
+    Surface::from_file("images/particles/ghost0.png"),
+    Surface::from_file("images/particles/ghost1.png")
+  };
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
   // create two ghosts
   size_t ghostcount = 2;
   for (size_t i=0; i<ghostcount; ++i) {
-    auto particle = std::make_unique<GhostParticle>();
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    const float x = graphicsRandom.randf(virtual_width);
+    const float y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
     int size = graphicsRandom.rand(2);
-    particle->texture = ghosts[size];
-    particle->speed = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
-                                           180.0f + static_cast<float>(size) * 10.0f);
-    particles.push_back(std::move(particle));
+    const size_t index = particles.add(x, y, static_cast<uint8_t>(size));
+    particles.speed[index] = graphicsRandom.randf(std::max(50.0f, static_cast<float>(size) * 10.0f),
+                                                  180.0f + static_cast<float>(size) * 10.0f);
   }
 }
 
@@ -70,13 +70,12 @@ GhostParticleSystem::update(float dt_sec)
   if (!enabled)
     return;
 
-  for (const auto& part : particles) {
-    const auto& particle = dynamic_cast<GhostParticle*>(part.get());
-    particle->pos.y -= particle->speed * dt_sec;
-    particle->pos.x -= particle->speed * dt_sec;
-    if (particle->pos.y > static_cast<float>(SCREEN_HEIGHT)) {
-      particle->pos.y = fmodf(particle->pos.y , virtual_height);
-      particle->pos.x = graphicsRandom.randf(virtual_width);
+  particles.move(Vector(-dt_sec, -dt_sec));
+
+  for (size_t i = 0; i < particles.size(); ++i) {
+    if (particles.y[i] > static_cast<float>(SCREEN_HEIGHT)) {
+      particles.y[i] = fmodf(particles.y[i], virtual_height);
+      particles.x[i] = graphicsRandom.randf(virtual_width);
     }
   }
 }
@@ -39,19 +39,6 @@ public:
     return "images/engine/editor/ghostparticles.png";
   }
 
-private:
-  class GhostParticle : public Particle
-  {
-  public:
-    float speed;
-
-    GhostParticle() :
-      speed()
-    {}
-  };
-
-  SurfacePtr ghosts[2];
-
 private:
   GhostParticleSystem(const GhostParticleSystem&) = delete;
   GhostParticleSystem& operator=(const GhostParticleSystem&) = delete;
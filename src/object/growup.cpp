@@ -43,7 +43,7 @@ GrowUp::GrowUp(Direction direction) :
 void
 GrowUp::update(float dt_sec)
 {
-  m_col.m_movement = physic.get_movement(dt_sec);
+  m_col.set_movement(physic.get_movement(dt_sec));
 }
 
 void
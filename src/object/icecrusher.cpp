@@ -155,6 +155,7 @@ IceCrusher::collision(GameObject& other, const CollisionHit& hit)
   }
   auto badguy = dynamic_cast<BadGuy*>(&other);
   if (badguy) {
+    badguy->wake_up();
     badguy->kill_fall();
   }
 
@@ -296,7 +297,7 @@ IceCrusher::update(float dt_sec)
 
   switch (state) {
     case IDLE:
-      m_col.m_movement = Vector (0, 0);
+      m_col.set_movement(Vector (0, 0));
       if (found_victim_down() && !sideways)
         set_state(CRUSHING);
 		  if (found_victim_right() && sideways)
@@ -305,22 +306,25 @@ IceCrusher::update(float dt_sec)
         set_state(CRUSHING_LEFT);
       break;
     case CRUSHING:
-      m_col.m_movement = physic.get_movement (dt_sec);
-      if (m_col.m_movement.y > MAX_DROP_SPEED)
-        m_col.m_movement.y = MAX_DROP_SPEED;
+    {
+      Vector movement = physic.get_movement (dt_sec);
+      if (movement.y > MAX_DROP_SPEED)
+        movement.y = MAX_DROP_SPEED;
+      m_col.set_movement(movement);
       break;
+    }
 	  case CRUSHING_RIGHT:
-	    m_col.m_movement = physic.get_movement(dt_sec);
+	    m_col.set_movement(physic.get_movement(dt_sec));
 	    physic.set_velocity_x((physic.get_velocity_x() + 10.f));
       break;
 	  case CRUSHING_LEFT:
-	    m_col.m_movement = physic.get_movement(dt_sec);
+	    m_col.set_movement(physic.get_movement(dt_sec));
 	    physic.set_velocity_x((physic.get_velocity_x() - 10.f));
       break;
     case RECOVERING:
       if (m_col.m_bbox.get_top() <= start_position.y+1) {
         set_pos(start_position);
-        m_col.m_movement = Vector (0, 0);
+        m_col.set_movement(Vector (0, 0));
         if (ic_size == LARGE)
           cooldown_timer = PAUSE_TIME_LARGE;
         else
@@ -329,15 +333,15 @@ IceCrusher::update(float dt_sec)
       }
       else {
         if (ic_size == LARGE)
-          m_col.m_movement = Vector (0, RECOVER_SPEED_LARGE);
+          m_col.set_movement(Vector (0, RECOVER_SPEED_LARGE));
         else
-          m_col.m_movement = Vector (0, RECOVER_SPEED_NORMAL);
+          m_col.set_movement(Vector (0, RECOVER_SPEED_NORMAL));
       }
       break;
 	  case RECOVERING_RIGHT:
       if (m_col.m_bbox.get_left() <= start_position.x+1) {
         set_pos(start_position);
-        m_col.m_movement = Vector (0, 0);
+        m_col.set_movement(Vector (0, 0));
         if (ic_size == LARGE)
           cooldown_timer = PAUSE_TIME_LARGE;
         else
@@ -345,13 +349,13 @@ IceCrusher::update(float dt_sec)
         set_state(IDLE);
       }
       else {
-          m_col.m_movement = Vector (RECOVER_SPEED_LARGE, 0);
+          m_col.set_movement(Vector (RECOVER_SPEED_LARGE, 0));
       }
       break;
 	  case RECOVERING_LEFT:
       if (m_col.m_bbox.get_left() >= start_position.x-1) {
         set_pos(start_position);
-        m_col.m_movement = Vector (0, 0);
+        m_col.set_movement(Vector (0, 0));
         if (ic_size == LARGE)
           cooldown_timer = PAUSE_TIME_LARGE;
         else
@@ -359,7 +363,7 @@ IceCrusher::update(float dt_sec)
         set_state(IDLE);
       }
       else {
-          m_col.m_movement = Vector (-RECOVER_SPEED_LARGE, 0);
+          m_col.set_movement(Vector (-RECOVER_SPEED_LARGE, 0));
       }
       break;
     default:
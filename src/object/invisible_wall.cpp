@@ -32,7 +32,7 @@ InvisibleWall::InvisibleWall(const ReaderMapping& mapping):
 
   m_col.m_bbox.set_size(width, height);
 
-  m_col.m_group = COLGROUP_STATIC;
+  set_group(COLGROUP_STATIC);
 }
 
 ObjectSettings
@@ -51,7 +51,7 @@ InvisibleWall::get_settings()
 
 void
 InvisibleWall::after_editor_set() {
-  m_col.m_bbox.set_size(width, height);
+  m_col.set_size(width, height);
 }
 
 HitResponse
@@ -0,0 +1,267 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "object/particle_pool.hpp"
+
+#include <assert.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define SUPERTUX_PARTICLE_POOL_SSE2
+#endif
+
+#include "math/rectf.hpp"
+#include "video/canvas.hpp"
+#include "video/surface.hpp"
+
+namespace {
+
+/** @c value modulo @c size, with the sign of @c value like fmodf(),
+    computed the same way as the SSE2 version */
+inline float wrap_value(float value, float size)
+{
+  const float quotient = static_cast<float>(static_cast<int>(value / size));
+  return value - quotient * size;
+}
+
+} // namespace
+
+ParticlePool::ParticlePool() :
+  textures(),
+  x(),
+  y(),
+  speed(),
+  angle(),
+  alpha(),
+  texture(),
+  m_channels(),
+  m_wrapped_x(),
+  m_wrapped_y()
+{
+}
+
+size_t
+ParticlePool::add(float x_, float y_, uint8_t texture_)
+{
+  x.push_back(x_);
+  y.push_back(y_);
+  speed.push_back(0.0f);
+  angle.push_back(0.0f);
+  alpha.push_back(1.0f);
+  texture.push_back(texture_);
+  for (auto& channel : m_channels) {
+    channel.push_back(0.0f);
+  }
+  return x.size() - 1;
+}
+
+size_t
+ParticlePool::add_channel()
+{
+  assert(empty());
+  m_channels.emplace_back();
+  return m_channels.size() - 1;
+}
+
+void
+ParticlePool::swap_remove(size_t index)
+{
+  x[index] = x.back();
+  y[index] = y.back();
+  speed[index] = speed.back();
+  angle[index] = angle.back();
+  alpha[index] = alpha.back();
+  texture[index] = texture.back();
+  for (auto& channel : m_channels) {
+    channel[index] = channel.back();
+  }
+
+  shrink(size() - 1);
+}
+
+void
+ParticlePool::shrink(size_t count)
+{
+  if (count >= size())
+    return;
+
+  x.resize(count);
+  y.resize(count);
+  speed.resize(count);
+  angle.resize(count);
+  alpha.resize(count);
+  texture.resize(count);
+  for (auto& channel : m_channels) {
+    channel.resize(count);
+  }
+}
+
+void
+ParticlePool::clear()
+{
+  shrink(0);
+}
+
+void
+ParticlePool::move(const Vector& direction)
+{
+#ifdef SUPERTUX_PARTICLE_POOL_SSE2
+  const size_t count = size();
+  const size_t simd_count = count - count % 4;
+  const __m128 dx = _mm_set1_ps(direction.x);
+  const __m128 dy = _mm_set1_ps(direction.y);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    const __m128 s = _mm_loadu_ps(&speed[i]);
+    _mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(s, dx)));
+    _mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(s, dy)));
+  }
+
+  for (size_t i = simd_count; i < count; ++i) {
+    x[i] += speed[i] * direction.x;
+    y[i] += speed[i] * direction.y;
+  }
+#else
+  move_scalar(direction);
+#endif
+}
+
+void
+ParticlePool::move_scalar(const Vector& direction)
+{
+  for (size_t i = 0; i < size(); ++i) {
+    x[i] += speed[i] * direction.x;
+    y[i] += speed[i] * direction.y;
+  }
+}
+
+void
+ParticlePool::wrap(const Vector& scroll, const Sizef& size_,
+                   std::vector<float>& wrapped_x, std::vector<float>& wrapped_y) const
+{
+#ifdef SUPERTUX_PARTICLE_POOL_SSE2
+  const size_t count = size();
+  const size_t simd_count = count - count % 4;
+  wrapped_x.resize(count);
+  wrapped_y.resize(count);
+
+  const __m128 scroll_x = _mm_set1_ps(scroll.x);
+  const __m128 scroll_y = _mm_set1_ps(scroll.y);
+  const __m128 width = _mm_set1_ps(size_.width);
+  const __m128 height = _mm_set1_ps(size_.height);
+
+  for (size_t i = 0; i < simd_count; i += 4) {
+    const __m128 px = _mm_sub_ps(_mm_loadu_ps(&x[i]), scroll_x);
+    const __m128 qx = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(px, width)));
+    _mm_storeu_ps(&wrapped_x[i], _mm_sub_ps(px, _mm_mul_ps(qx, width)));
+
+    const __m128 py = _mm_sub_ps(_mm_loadu_ps(&y[i]), scroll_y);
+    const __m128 qy = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_div_ps(py, height)));
+    _mm_storeu_ps(&wrapped_y[i], _mm_sub_ps(py, _mm_mul_ps(qy, height)));
+  }
+
+  for (size_t i = simd_count; i < count; ++i) {
+    wrapped_x[i] = wrap_value(x[i] - scroll.x, size_.width);
+    wrapped_y[i] = wrap_value(y[i] - scroll.y, size_.height);
+  }
+#else
+  wrap_scalar(scroll, size_, wrapped_x, wrapped_y);
+#endif
+}
+
+void
+ParticlePool::wrap_scalar(const Vector& scroll, const Sizef& size_,
+                          std::vector<float>& wrapped_x, std::vector<float>& wrapped_y) const
+{
+  wrapped_x.resize(size());
+  wrapped_y.resize(size());
+  for (size_t i = 0; i < size(); ++i) {
+    wrapped_x[i] = wrap_value(x[i] - scroll.x, size_.width);
+    wrapped_y[i] = wrap_value(y[i] - scroll.y, size_.height);
+  }
+}
+
+void
+ParticlePool::draw(Canvas& canvas, int layer)
+{
+  draw_positions(canvas, x.data(), y.data(), nullptr, layer);
+}
+
+void
+ParticlePool::draw_wrapped(Canvas& canvas, const Vector& scroll, const Sizef& size_, int layer)
+{
+  wrap(scroll, size_, m_wrapped_x, m_wrapped_y);
+  draw_positions(canvas, m_wrapped_x.data(), m_wrapped_y.data(), &size_, layer);
+}
+
+void
+ParticlePool::draw_positions(Canvas& canvas, const float* pos_x, const float* pos_y,
+                             const Sizef* wrap_size, int layer) const
+{
+  for (size_t tex = 0; tex < textures.size(); ++tex)
+  {
+    const SurfacePtr& surface = textures[tex];
+    const Rectf region = surface->get_region();
+    const Sizef surface_size(static_cast<float>(surface->get_width()),
+                             static_cast<float>(surface->get_height()));
+
+    size_t count = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      if (texture[i] == tex) {
+        count += 1;
+      }
+    }
+    if (count == 0)
+      continue;
+
+    std::vector<Rectf> srcrects(count, region);
+    std::vector<Rectf> dstrects;
+    std::vector<float> angles;
+    dstrects.reserve(count);
+    angles.reserve(count);
+
+    for (size_t i = 0; i < size(); ++i)
+    {
+      if (texture[i] != tex)
+        continue;
+
+      Vector pos(pos_x[i], pos_y[i]);
+      if (wrap_size) {
+        // wrap around to the right only once the particle is
+        // completely off screen on the left
+        if (pos.x + surface_size.width < 0.0f) pos.x += wrap_size->width;
+        if (pos.y < 0.0f) pos.y += wrap_size->height;
+      }
+
+      if (alpha[i] != 1.0f) {
+        canvas.draw_surface_batch(surface, { region }, { Rectf(pos, surface_size) }, { angle[i] },
+                                  Color(1.0f, 1.0f, 1.0f, alpha[i]), layer);
+      } else {
+        dstrects.emplace_back(pos, surface_size);
+        angles.push_back(angle[i]);
+      }
+    }
+
+    if (!dstrects.empty()) {
+      srcrects.resize(dstrects.size());
+      canvas.draw_surface_batch(surface, std::move(srcrects), std::move(dstrects), std::move(angles),
+                                Color::WHITE, layer);
+    }
+  }
+}
+
+/* EOF */
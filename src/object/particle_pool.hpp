@@ -0,0 +1,118 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_OBJECT_PARTICLE_POOL_HPP
+#define HEADER_SUPERTUX_OBJECT_PARTICLE_POOL_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "math/sizef.hpp"
+#include "math/vector.hpp"
+#include "video/surface_ptr.hpp"
+
+class Canvas;
+
+/** The particles of a ParticleSystem, stored as one array per
+    property instead of one object per particle, so that they can be
+    moved and wrapped around the screen several at a time with SSE2.
+    Particle systems that need more properties than the common ones
+    get additional float channels. */
+class ParticlePool final
+{
+public:
+  ParticlePool();
+
+  size_t size() const { return x.size(); }
+  bool empty() const { return x.empty(); }
+
+  /** Adds a particle drawn with textures[texture] and returns its
+      index. The other properties start out as zero, alpha as one. */
+  size_t add(float x_, float y_, uint8_t texture_);
+
+  /** Removes the particle at @c index by moving the last one into its
+      place */
+  void swap_remove(size_t index);
+
+  /** Removes particles from the end until there are @c count left */
+  void shrink(size_t count);
+
+  void clear();
+
+  /** Adds a property to all particles and returns its index for
+      channel(), only to be used while the pool is empty */
+  size_t add_channel();
+
+  std::vector<float>& channel(size_t index) { return m_channels[index]; }
+
+  /** Moves every particle by its speed times @c direction */
+  void move(const Vector& direction);
+
+  /** Same as move(), but without SIMD */
+  void move_scalar(const Vector& direction);
+
+  /** Stores the particle positions relative to @c scroll, wrapped
+      into a rectangle of @c size, in @c wrapped_x and @c wrapped_y.
+      Both lie within (-size, size), the sign of negative ones is
+      left for draw() to fix, as that depends on the texture width. */
+  void wrap(const Vector& scroll, const Sizef& size,
+            std::vector<float>& wrapped_x, std::vector<float>& wrapped_y) const;
+
+  /** Same as wrap(), but without SIMD */
+  void wrap_scalar(const Vector& scroll, const Sizef& size,
+                   std::vector<float>& wrapped_x, std::vector<float>& wrapped_y) const;
+
+  /** Draws all particles at their positions. Particles of a texture
+      with full alpha go into a single batch. */
+  void draw(Canvas& canvas, int layer);
+
+  /** Draws all particles wrapped around a virtual screen of @c size
+      that scrolls with @c scroll, see ParticleSystem */
+  void draw_wrapped(Canvas& canvas, const Vector& scroll, const Sizef& size, int layer);
+
+private:
+  void draw_positions(Canvas& canvas, const float* pos_x, const float* pos_y,
+                      const Sizef* wrap_size, int layer) const;
+
+public:
+  std::vector<SurfacePtr> textures;
+
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> speed;
+
+  /** angle at which to draw the particle */
+  std::vector<float> angle;
+  std::vector<float> alpha;
+  std::vector<uint8_t> texture;
+
+private:
+  std::vector<std::vector<float> > m_channels;
+
+  /** Scratch space for draw_wrapped() */
+  std::vector<float> m_wrapped_x;
+  std::vector<float> m_wrapped_y;
+
+private:
+  ParticlePool(const ParticlePool&) = delete;
+  ParticlePool& operator=(const ParticlePool&) = delete;
+};
+
+#endif
+
+/* EOF */
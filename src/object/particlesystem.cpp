@@ -16,15 +16,12 @@
 
 #include "object/particlesystem.hpp"
 
-#include <math.h>
-
 #include "supertux/globals.hpp"
 #include "util/reader.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
-#include "video/surface_batch.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -85,42 +82,9 @@ ParticleSystem::draw(DrawingContext& context)
   context.push_transform();
   context.set_translation(Vector(max_particle_size,max_particle_size));
 
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles)
-  {
-    // remap x,y coordinates onto screencoordinates
-    Vector pos;
-
-    // horizontal wrap when particle goes off screen to the left
-    const int particle_width = particle->texture->get_width();
-    pos.x = fmodf(particle->pos.x - scrollx, virtual_width);
-    if ((pos.x + static_cast<float>(particle_width)) < 0) pos.x += virtual_width;
-
-    pos.y = fmodf(particle->pos.y - scrolly, virtual_height);
-    if (pos.y < 0) pos.y += virtual_height;
-
-    //if(pos.x > virtual_width) pos.x -= virtual_width;
-    //if(pos.y > virtual_height) pos.y -= virtual_height;
-
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture, SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(pos, particle->angle);
-    } else {
-      it->second.draw(pos, particle->angle);
-    }
-  }
-
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    context.color().draw_surface_batch(surface,
-                                       batch.move_srcrects(),
-                                       batch.move_dstrects(),
-                                       batch.move_angles(),
-                                       batch.get_color(),
-                                       z_pos);
-  }
+  // remap x,y coordinates onto screencoordinates
+  particles.draw_wrapped(context.color(), Vector(scrollx, scrolly),
+                         Sizef(virtual_width, virtual_height), z_pos);
 
   context.pop_transform();
 }
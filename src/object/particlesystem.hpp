@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "math/vector.hpp"
+#include "object/particle_pool.hpp"
 #include "squirrel/exposed_object.hpp"
 #include "scripting/particlesystem.hpp"
 #include "supertux/game_object.hpp"
@@ -41,7 +42,8 @@ class ReaderMapping;
 
   Classes that implement a particle system should subclass from this
   class, initialize particles in the constructor and move them in the
-  simulate function.
+  simulate function. Particles are kept in a ParticlePool, the
+  Particle class is only used by CustomParticleSystem.
  */
 class ParticleSystem : public GameObject//,
                        //public ExposedObject<ParticleSystem, scripting::ParticleSystem>
@@ -92,7 +94,7 @@ protected:
 protected:
   float max_particle_size;
   int z_pos;
-  std::vector<std::unique_ptr<Particle> > particles;
+  ParticlePool particles;
   float virtual_width;
   float virtual_height;
   bool enabled;
@@ -24,7 +24,6 @@
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
 #include "video/drawing_context.hpp"
-#include "video/surface_batch.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -62,32 +61,18 @@ ParticleSystem_Interactive::draw(DrawingContext& context)
     return;
 
   context.push_transform();
-
-  std::unordered_map<SurfacePtr, SurfaceBatch> batches;
-  for (const auto& particle : particles) {
-    auto it = batches.find(particle->texture);
-    if (it == batches.end()) {
-      const auto& batch_it = batches.emplace(particle->texture,
-        SurfaceBatch(particle->texture));
-      batch_it.first->second.draw(particle->pos, particle->angle);
-    } else {
-      it->second.draw(particle->pos, particle->angle);
-    }
-  }
-
-  for(auto& it : batches) {
-    auto& surface = it.first;
-    auto& batch = it.second;
-    // FIXME: What is the colour used for?
-    context.color().draw_surface_batch(surface, batch.move_srcrects(),
-      batch.move_dstrects(), batch.move_angles(), Color::WHITE, z_pos);
-  }
-
+  particles.draw(context.color(), z_pos);
   context.pop_transform();
 }
 
 int
 ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
+{
+  return collision_at(object->pos, movement);
+}
+
+int
+ParticleSystem_Interactive::collision_at(const Vector& pos, const Vector& movement)
 {
   using namespace collision;
 
@@ -95,18 +80,18 @@ ParticleSystem_Interactive::collision(Particle* object, const Vector& movement)
   float x1, x2;
   float y1, y2;
 
-  x1 = object->pos.x;
+  x1 = pos.x;
   x2 = x1 + 32 + movement.x;
   if (x2 < x1) {
     x1 = x2;
-    x2 = object->pos.x;
+    x2 = pos.x;
   }
 
-  y1 = object->pos.y;
+  y1 = pos.y;
   y2 = y1 + 32 + movement.y;
   if (y2 < y1) {
     y1 = y2;
-    y2 = object->pos.y;
+    y2 = pos.y;
   }
   bool water = false;
 
@@ -51,6 +51,11 @@ public:
 protected:
   virtual int collision(Particle* particle, const Vector& movement);
 
+  /** Checks the tiles a particle at @c pos would move through, returns
+      -1 for none, 0 for water, 1 for a hit from above and 2 for a hit
+      from the side */
+  int collision_at(const Vector& pos, const Vector& movement);
+
 private:
   ParticleSystem_Interactive(const ParticleSystem_Interactive&) = delete;
   ParticleSystem_Interactive& operator=(const ParticleSystem_Interactive&) = delete;
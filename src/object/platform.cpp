@@ -54,7 +54,7 @@ Platform::finish_construction()
     init_path_pos(m_col.m_bbox.p1(), false);
   }
 
-  m_col.m_bbox.set_pos(get_path()->get_base());
+  m_col.set_pos(get_path()->get_base());
 }
 
 ObjectSettings
@@ -118,8 +118,8 @@ Platform::update(float dt_sec)
 
   get_walker()->update(dt_sec);
   Vector new_pos = get_walker()->get_pos();
-    m_col.m_movement = new_pos - get_pos();
-    m_speed = m_col.m_movement / dt_sec;
+    m_col.set_movement(new_pos - get_pos());
+    m_speed = m_col.get_movement() / dt_sec;
 }
 
 void
@@ -40,7 +40,7 @@ void
 PneumaticPlatformChild::update(float dt_sec)
 {
   const float offset_y = m_left ? m_parent.m_offset_y : -m_parent.m_offset_y;
-  m_col.m_movement = Vector(0, (m_parent.m_start_y + offset_y) - get_pos().y);
+  m_col.set_movement(Vector(0, (m_parent.m_start_y + offset_y) - get_pos().y));
 }
 
 HitResponse
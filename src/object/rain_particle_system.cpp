@@ -16,7 +16,7 @@
 
 #include "object/rain_particle_system.hpp"
 
-#include <assert.h>
+#include <algorithm>
 #include <math.h>
 
 #include "math/easing.hpp"
@@ -83,8 +83,10 @@ RainParticleSystem::~RainParticleSystem()
 
 void RainParticleSystem::init()
 {
-  rainimages[0] = Surface::from_file("images/particles/rain0.png");
-  rainimages[1] = Surface::from_file("images/particles/rain1.png");
+  particles.textures = {
+    Surface::from_file("images/particles/rain0.png"),
+    Surface::from_file("images/particles/rain1.png")
+  };
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
@@ -118,20 +120,16 @@ void RainParticleSystem::set_amount(float amount)
   
   if (delta > 0) {
     for (int i=0; i<delta; ++i) {
-      auto particle = std::make_unique<RainParticle>();
-      particle->pos.x = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
-      particle->pos.y = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
+      const float x = static_cast<float>(graphicsRandom.rand(int(virtual_width)));
+      const float y = static_cast<float>(graphicsRandom.rand(int(virtual_height)));
       int rainsize = graphicsRandom.rand(2);
-      particle->texture = rainimages[rainsize];
+      const size_t index = particles.add(x, y, static_cast<uint8_t>(rainsize));
       do {
-        particle->speed = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
-      } while(particle->speed < 1);
-      particles.push_back(std::move(particle));
+        particles.speed[index] = ((static_cast<float>(rainsize) + 1.0f) * 45.0f + graphicsRandom.randf(3.6f));
+      } while(particles.speed[index] < 1);
     }
   } else if (delta < 0) {
-    for (int i=0; i>delta; --i) {
-      particles.pop_back();
-    }
+    particles.shrink(particles.size() - std::min(particles.size(), static_cast<size_t>(-delta)));
   }
 
   m_current_real_amount = real_amount;
@@ -139,8 +137,7 @@ void RainParticleSystem::set_amount(float amount)
 
 void RainParticleSystem::set_angle(float angle)
 {
-  for (auto& particle : particles)
-    particle->angle = angle;
+  std::fill(particles.angle.begin(), particles.angle.end(), angle);
 }
 
 void RainParticleSystem::update(float dt_sec)
@@ -196,40 +193,52 @@ void RainParticleSystem::update(float dt_sec)
     set_angle(m_current_angle);
   }
 
-  for (auto& it : particles) {
-    auto particle = dynamic_cast<RainParticle*>(it.get());
-    assert(particle);
-
-    float movement = particle->speed * dt_sec * Sector::get().get_gravity() * m_current_speed * 1.41421353f;
-    float abs_x = Sector::get().get_camera().get_translation().x;
-    float abs_y = Sector::get().get_camera().get_translation().y;
-    particle->pos.y += movement * cos((particle->angle + 45.f) * 3.14159265f / 180.f);
-    particle->pos.x -= movement * sin((particle->angle + 45.f) * 3.14159265f / 180.f);
-    int col = collision(particle, Vector(-movement, movement));
-    if ((particle->pos.y > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
+  const float gravity_speed = dt_sec * Sector::get().get_gravity() * m_current_speed * 1.41421353f;
+  const float abs_x = Sector::get().get_camera().get_translation().x;
+  const float abs_y = Sector::get().get_camera().get_translation().y;
+
+  // drops usually all fall at the same angle, so the direction only
+  // has to be calculated again when it changes
+  float direction_angle = 0.f;
+  Vector direction(-sinf(45.f * 3.14159265f / 180.f), cosf(45.f * 3.14159265f / 180.f));
+
+  auto& xs = particles.x;
+  auto& ys = particles.y;
+  for (size_t i = 0; i < particles.size(); ++i) {
+    if (particles.angle[i] != direction_angle) {
+      direction_angle = particles.angle[i];
+      direction = Vector(-sinf((direction_angle + 45.f) * 3.14159265f / 180.f),
+                         cosf((direction_angle + 45.f) * 3.14159265f / 180.f));
+    }
+
+    float movement = particles.speed[i] * gravity_speed;
+    ys[i] += movement * direction.y;
+    xs[i] += movement * direction.x;
+    int col = collision_at(Vector(xs[i], ys[i]), Vector(-movement, movement));
+    if ((ys[i] > static_cast<float>(SCREEN_HEIGHT) + abs_y) || (col >= 0)) {
       //Create rainsplash
-      if ((particle->pos.y <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
+      if ((ys[i] <= static_cast<float>(SCREEN_HEIGHT) + abs_y) && (col >= 1)){
         bool vertical = (col == 2);
         if (!vertical) { //check if collision happened from above
           int splash_x, splash_y; // move outside if statement when
                                   // uncommenting the else statement below.
-          splash_x = int(particle->pos.x);
-          splash_y = int(particle->pos.y) - (int(particle->pos.y) % 32) + 32;
+          splash_x = int(xs[i]);
+          splash_y = int(ys[i]) - (int(ys[i]) % 32) + 32;
           Sector::get().add<RainSplash>(Vector(static_cast<float>(splash_x), static_cast<float>(splash_y)),
                                              vertical);
         }
         // Uncomment the following to display vertical splashes, too
         /* else {
-           splash_x = int(particle->pos.x) - (int(particle->pos.x) % 32) + 32;
-           splash_y = int(particle->pos.y);
+           splash_x = int(xs[i]) - (int(xs[i]) % 32) + 32;
+           splash_y = int(ys[i]);
            Sector::get().add<RainSplash>(Vector(splash_x, splash_y),vertical);
            } */
       }
       int new_x = graphicsRandom.rand(int(virtual_width)) + int(abs_x);
       int new_y = 0;
       //FIXME: Don't move particles over solid tiles
-      particle->pos.x = static_cast<float>(new_x);
-      particle->pos.y = static_cast<float>(new_y);
+      xs[i] = static_cast<float>(new_x);
+      ys[i] = static_cast<float>(new_y);
     }
   }
 }
@@ -63,18 +63,6 @@ private:
   void set_angle(float angle);
 
 private:
-  class RainParticle : public Particle
-  {
-  public:
-    float speed;
-
-    RainParticle() :
-      speed()
-    {}
-  };
-
-  SurfacePtr rainimages[2];
-
   float m_current_speed;
   float m_target_speed;
   float m_speed_fade_time_remaining;
@@ -74,7 +74,7 @@ void
 Rock::update(float dt_sec)
 {
   if (!is_grabbed())
-    m_col.m_movement = physic.get_movement(dt_sec);
+    m_col.set_movement(physic.get_movement(dt_sec));
 }
 
 void
@@ -144,8 +144,8 @@ void
 Rock::grab(MovingObject& object, const Vector& pos, Direction dir_)
 {
   Portable::grab(object, pos, dir_);
-  m_col.m_movement = pos - get_pos();
-  last_movement = m_col.m_movement;
+  m_col.set_movement(pos - get_pos());
+  last_movement = m_col.get_movement();
   set_group(COLGROUP_TOUCHABLE); //needed for lanterns catching willowisps
   on_ground = false;
 
@@ -62,7 +62,7 @@ void
 SkullTile::update(float dt_sec)
 {
   if (falling) {
-    m_col.m_movement = physic.get_movement(dt_sec);
+    m_col.set_movement(physic.get_movement(dt_sec));
     if (!Sector::get().inside(m_col.m_bbox)) {
       remove_me();
       return;
@@ -61,9 +61,14 @@ SnowParticleSystem::~SnowParticleSystem()
 
 void SnowParticleSystem::init()
 {
-  snowimages[0] = Surface::from_file("images/particles/snow2.png");
-  snowimages[1] = Surface::from_file("images/particles/snow1.png");
-  snowimages[2] = Surface::from_file("images/particles/snow0.png");
+  particles.textures = {
+    Surface::from_file("images/particles/snow2.png"),
+    Surface::from_file("images/particles/snow1.png"),
+    Surface::from_file("images/particles/snow0.png")
+  };
+  for (int i = 0; i < CHANNEL_COUNT; ++i) {
+    particles.add_channel();
+  }
 
   virtual_width = static_cast<float>(SCREEN_WIDTH) * 2.0f;
 
@@ -72,26 +77,25 @@ void SnowParticleSystem::init()
   // create some random snowflakes
   int snowflakecount = static_cast<int>(virtual_width / 10.0f);
   for (int i = 0; i < snowflakecount; ++i) {
-    auto particle = std::make_unique<SnowParticle>();
     int snowsize = graphicsRandom.rand(3);
 
-    particle->pos.x = graphicsRandom.randf(virtual_width);
-    particle->pos.y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
-    particle->anchorx = particle->pos.x + (graphicsRandom.randf(-0.5, 0.5) * 16);
+    const float x = graphicsRandom.randf(virtual_width);
+    const float y = graphicsRandom.randf(static_cast<float>(SCREEN_HEIGHT));
+    const size_t index = particles.add(x, y, static_cast<uint8_t>(snowsize));
+
+    particles.channel(ANCHOR_X)[index] = x + (graphicsRandom.randf(-0.5, 0.5) * 16);
     // drift will change with wind gusts
-    particle->drift_speed = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
-    particle->wobble = 0.0;
+    particles.channel(DRIFT_SPEED)[index] = graphicsRandom.randf(-0.5f, 0.5f) * 0.3f;
+    particles.channel(WOBBLE)[index] = 0.0;
 
-    particle->texture = snowimages[snowsize];
-    particle->flake_size = static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f)); // since it ranges from 0 to 2
+    // since it ranges from 0 to 2
+    particles.channel(FLAKE_SIZE)[index] = static_cast<float>(static_cast<int>(powf(static_cast<float>(snowsize) + 3.0f, 4.0f)));
 
-    particle->speed = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
+    particles.speed[index] = 6.32f * (1.0f + (2.0f - static_cast<float>(snowsize)) / 2.0f + graphicsRandom.randf(1.8f));
 
     // Spinning
-    particle->angle = graphicsRandom.randf(360.0);
-    particle->spin_speed = graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED);
-
-    particles.push_back(std::move(particle));
+    particles.angle[index] = graphicsRandom.randf(360.0);
+    particles.channel(SPIN_SPEED)[index] = graphicsRandom.randf(-SNOW::SPIN_SPEED,SNOW::SPIN_SPEED);
   }
 }
 
@@ -137,26 +141,29 @@ void SnowParticleSystem::update(float dt_sec)
 
   float sq_g = sqrtf(Sector::get().get_gravity());
 
-  for (auto& part : particles) {
-    auto particle = dynamic_cast<SnowParticle*>(part.get());
-    if (!particle)
-      continue;
+  // Falling
+  particles.move(Vector(0.0f, dt_sec * sq_g));
+
+  auto& wobble = particles.channel(WOBBLE);
+  auto& anchorx = particles.channel(ANCHOR_X);
+  auto& drift_speed = particles.channel(DRIFT_SPEED);
+  auto& spin_speed = particles.channel(SPIN_SPEED);
+  auto& flake_size = particles.channel(FLAKE_SIZE);
 
+  for (size_t i = 0; i < particles.size(); ++i) {
     float anchor_delta;
 
-    // Falling
-    particle->pos.y += particle->speed * dt_sec * sq_g;
     // Drifting (speed approaches wind at a rate dependent on flake size)
-    particle->drift_speed += (gust_current_velocity - particle->drift_speed) / static_cast<float>(particle->flake_size) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->anchorx += particle->drift_speed * dt_sec;
+    drift_speed[i] += (gust_current_velocity - drift_speed[i]) / flake_size[i] + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    anchorx[i] += drift_speed[i] * dt_sec;
     // Wobbling (particle approaches anchorx)
-    particle->pos.x += particle->wobble * dt_sec * sq_g;
-    anchor_delta = (particle->anchorx - particle->pos.x);
-    particle->wobble += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
-    particle->wobble *= SNOW::WOBBLE_DECAY;
+    particles.x[i] += wobble[i] * dt_sec * sq_g;
+    anchor_delta = (anchorx[i] - particles.x[i]);
+    wobble[i] += (SNOW::WOBBLE_FACTOR * anchor_delta) + graphicsRandom.randf(-SNOW::EPSILON, SNOW::EPSILON);
+    wobble[i] *= SNOW::WOBBLE_DECAY;
     // Spinning
-    particle->angle += particle->spin_speed * dt_sec;
-    particle->angle = fmodf(particle->angle, 360.0);
+    particles.angle[i] += spin_speed[i] * dt_sec;
+    particles.angle[i] = fmodf(particles.angle[i], 360.0);
   }
 }
 
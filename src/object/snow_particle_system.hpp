@@ -41,28 +41,16 @@ public:
   void init();
 
 private:
-  class SnowParticle : public Particle
-  {
-  public:
-    float speed;
-    float wobble;
-    float anchorx;
-    float drift_speed;
-
+  /** Per particle properties besides the ones of ParticlePool */
+  enum Channel {
+    WOBBLE,
+    ANCHOR_X,
+    DRIFT_SPEED,
     // Turning speed
-    float spin_speed;
-
+    SPIN_SPEED,
     // for inertia
-    unsigned int flake_size;
-
-    SnowParticle() :
-      speed(),
-      wobble(),
-      anchorx(),
-      drift_speed(),
-      spin_speed(),
-      flake_size()
-    {}
+    FLAKE_SIZE,
+    CHANNEL_COUNT
   };
 
   // Wind is simulated in discrete "gusts"
@@ -89,8 +77,6 @@ private:
   // Current blowing velocity of gust
   float gust_current_velocity;
 
-  SurfacePtr snowimages[3];
-
 private:
   SnowParticleSystem(const SnowParticleSystem&) = delete;
   SnowParticleSystem& operator=(const SnowParticleSystem&) = delete;
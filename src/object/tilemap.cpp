@@ -27,18 +27,29 @@
 #include "supertux/tile_set.hpp"
 #include "util/reader.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/tile_encoding.hpp"
 #include "util/writer.hpp"
 #include "video/drawing_context.hpp"
 #include "video/layer.hpp"
 #include "video/surface.hpp"
 #include "worldmap/worldmap.hpp"
 
+namespace {
+
+/** Width and height of a chunk in tiles */
+const int CHUNK_SIZE = 32;
+
+} // namespace
+
 TileMap::TileMap(const TileSet *new_tileset) :
   ExposedObject<TileMap, scripting::TileMap>(this),
   PathObject(),
   m_editor_active(true),
   m_tileset(new_tileset),
   m_tiles(),
+  m_tile_flags(),
+  m_row_flag_counts(),
+  m_chunks(),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -72,6 +83,9 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_editor_active(true),
   m_tileset(tileset_),
   m_tiles(),
+  m_tile_flags(),
+  m_row_flag_counts(),
+  m_chunks(),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -156,8 +170,12 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
            static_cast<int>(Sector::get().get_height() / 32.0f));
     m_editor_active = false;
   } else {
-    if (!reader.get("tiles", m_tiles))
+    std::string encoded_tiles;
+    if (reader.get("tiles-rle", encoded_tiles)) {
+      TileEncoding::decode(encoded_tiles, m_tiles);
+    } else if (!reader.get("tiles", m_tiles)) {
       throw std::runtime_error("No tiles in tilemap.");
+    }
 
     if (int(m_tiles.size()) != m_width * m_height) {
       throw std::runtime_error("wrong number of tiles in tilemap.");
@@ -166,15 +184,17 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
 
   bool empty = true;
 
-  // make sure all tiles used on the tilemap are loaded and tilemap isn't empty
+  // make sure tilemap isn't empty
   for (const auto& tile : m_tiles) {
     if (tile != 0) {
       empty = false;
+      break;
     }
-
-    m_tileset->get(tile);
   }
 
+  // also makes sure all tiles used on the tilemap are loaded
+  update_tile_flags();
+
   if (empty)
   {
     log_info << "Tilemap '" << get_name() << "', z-pos '" << m_z_pos << "' is empty." << std::endl;
@@ -358,39 +378,70 @@ TileMap::draw(DrawingContext& context)
 
   Rectf draw_rect = context.get_cliprect();
   Rect t_draw_rect = get_tiles_overlapping(draw_rect);
-  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
-
-  Vector pos;
-  int tx, ty;
 
   std::unordered_map<SurfacePtr,
                      std::tuple<std::vector<Rectf>,
                                 std::vector<Rectf>>> batches;
 
-  for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
-    for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*m_width + tx;
-      assert (index >= 0);
-      assert (index < (m_width * m_height));
+  auto add_to_batch = [&batches](const SurfacePtr& surface, const Vector& pos) {
+    if (surface) {
+      std::get<0>(batches[surface]).emplace_back(surface->get_region());
+      std::get<1>(batches[surface]).emplace_back(pos,
+                                                 Sizef(static_cast<float>(surface->get_width()),
+                                                       static_cast<float>(surface->get_height())));
+    }
+  };
+
+  Canvas& canvas = context.get_canvas(m_draw_target);
 
-      if (m_tiles[index] == 0) continue;
-      const Tile& tile = m_tileset->get(m_tiles[index]);
+  if (!Editor::is_active() && !g_debug.show_collision_rects)
+  {
+    // the static tiles are drawn a chunk at a time, the animated ones
+    // are collected each frame
+    for (int y = t_draw_rect.top - t_draw_rect.top % CHUNK_SIZE; y < t_draw_rect.bottom; y += CHUNK_SIZE) {
+      for (int x = t_draw_rect.left - t_draw_rect.left % CHUNK_SIZE; x < t_draw_rect.right; x += CHUNK_SIZE) {
+        const Chunk& chunk = get_chunk(x, y);
+
+        for (const auto& batch : chunk.batches) {
+          canvas.draw_retained_batch(batch, m_offset, m_current_tint, m_z_pos);
+        }
 
-      if (g_debug.show_collision_rects) {
-        tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
-      }
+        for (const int index : chunk.animated_tiles) {
+          const int tx = index % m_width;
+          const int ty = index / m_width;
+          if (tx < t_draw_rect.left || tx >= t_draw_rect.right ||
+              ty < t_draw_rect.top || ty >= t_draw_rect.bottom)
+            continue;
 
-      const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
-      if (surface) {
-        std::get<0>(batches[surface]).emplace_back(surface->get_region());
-        std::get<1>(batches[surface]).emplace_back(pos,
-                                                   Sizef(static_cast<float>(surface->get_width()),
-                                                         static_cast<float>(surface->get_height())));
+          add_to_batch(m_tileset->get(m_tiles[index]).get_current_surface(), get_tile_position(tx, ty));
+        }
       }
     }
   }
+  else
+  {
+    Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
 
-  Canvas& canvas = context.get_canvas(m_draw_target);
+    Vector pos;
+    int tx, ty;
+
+    for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
+      for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
+        int index = ty*m_width + tx;
+        assert (index >= 0);
+        assert (index < (m_width * m_height));
+
+        if (m_tiles[index] == 0) continue;
+        const Tile& tile = m_tileset->get(m_tiles[index]);
+
+        if (g_debug.show_collision_rects) {
+          tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
+        }
+
+        add_to_batch(Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface(), pos);
+      }
+    }
+  }
 
   for (auto& it : batches)
   {
@@ -439,6 +490,7 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
 
   m_tiles.resize(newt.size());
   m_tiles = newt;
+  m_chunks.clear();
 
   if (new_z_pos > (LAYER_GUI - 100))
     m_z_pos = LAYER_GUI - 100;
@@ -447,9 +499,8 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   m_real_solid  = newsolid;
   update_effective_solid ();
 
-  // make sure all tiles are loaded
-  for (const auto& tile : m_tiles)
-    m_tileset->get(tile);
+  // also makes sure all tiles are loaded
+  update_tile_flags();
 }
 
 void
@@ -483,6 +534,7 @@ TileMap::resize(int new_width, int new_height, int fill_id,
 
   m_height = new_height;
   m_width = new_width;
+  m_chunks.clear();
 
   //Apply offset
   if (xoffset || yoffset) {
@@ -499,6 +551,8 @@ TileMap::resize(int new_width, int new_height, int fill_id,
       }
     }
   }
+
+  update_tile_flags();
 }
 
 void TileMap::resize(const Size& newsize, const Size& resize_offset) {
@@ -567,6 +621,8 @@ TileMap::change(int x, int y, uint32_t newtile)
 {
   assert(x >= 0 && x < m_width && y >= 0 && y < m_height);
   m_tiles[y*m_width + x] = newtile;
+  update_tile_flags(y*m_width + x);
+  invalidate_chunk(x, y);
 }
 
 void
@@ -633,7 +689,7 @@ TileMap::autotile(int x, int y, uint32_t tile)
     curr_set->is_solid(get_tile_id(x+1, y+1)),
     x, y);
 
-  m_tiles[y*m_width + x] = realtile;
+  change(x, y, realtile);
 }
 
 void
@@ -681,7 +737,7 @@ TileMap::autotile_corner(int x, int y, uint32_t tile, AutotileCornerOperation op
     (mask & 0x01) != 0,
     x, y);
 
-  m_tiles[y*m_width + x] = realtile;
+  change(x, y, realtile);
 }
 
 bool
@@ -715,7 +771,7 @@ TileMap::autotile_erase(const Vector& pos, const Vector& corner_pos)
   else
   {
     int x = static_cast<int>(pos.x), y = static_cast<int>(pos.y);
-    m_tiles[y*m_width + x] = 0;
+    change(x, y, 0);
 
     if (x - 1 >= 0 && y - 1 >= 0 && !is_corner(m_tiles[(y-1)*m_width + x-1])) {
       if (m_tiles[y*m_width + x] == 0)
@@ -836,6 +892,111 @@ void
 TileMap::set_tileset(const TileSet* new_tileset)
 {
   m_tileset = new_tileset;
+  m_chunks.clear();
+  update_tile_flags();
+}
+
+void
+TileMap::update_tile_flags()
+{
+  m_tile_flags.assign(m_tiles.size(), 0);
+  m_row_flag_counts.assign(m_height, 0);
+
+  for (size_t index = 0; index < m_tiles.size(); ++index) {
+    update_tile_flags(index);
+  }
+}
+
+void
+TileMap::update_tile_flags(size_t index)
+{
+  const Tile& tile = m_tileset->get(m_tiles[index]);
+
+  uint32_t flags = tile.get_attributes() & 0xffff;
+  if (tile.is_slope()) {
+    flags |= static_cast<uint32_t>(tile.get_data()) << 16;
+  }
+
+  int& row_count = m_row_flag_counts[index / m_width];
+  if (m_tile_flags[index] != 0) row_count -= 1;
+  if (flags != 0) row_count += 1;
+
+  m_tile_flags[index] = flags;
+}
+
+const TileMap::Chunk&
+TileMap::get_chunk(int x, int y)
+{
+  const int chunks_width = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  const int chunks_height = (m_height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  if (m_chunks.empty()) {
+    m_chunks.resize(chunks_width * chunks_height);
+  }
+
+  const int chunk_x = x / CHUNK_SIZE;
+  const int chunk_y = y / CHUNK_SIZE;
+  Chunk& chunk = m_chunks[chunk_y * chunks_width + chunk_x];
+  if (!chunk.valid) {
+    build_chunk(chunk, chunk_x, chunk_y);
+  }
+  return chunk;
+}
+
+void
+TileMap::build_chunk(Chunk& chunk, int chunk_x, int chunk_y) const
+{
+  chunk.batches.clear();
+  chunk.animated_tiles.clear();
+
+  const int right = std::min(m_width, (chunk_x + 1) * CHUNK_SIZE);
+  const int bottom = std::min(m_height, (chunk_y + 1) * CHUNK_SIZE);
+
+  for (int y = chunk_y * CHUNK_SIZE; y < bottom; ++y) {
+    for (int x = chunk_x * CHUNK_SIZE; x < right; ++x) {
+      const int index = y * m_width + x;
+      if (m_tiles[index] == 0) continue;
+
+      const Tile& tile = m_tileset->get(m_tiles[index]);
+      if (tile.is_animated()) {
+        chunk.animated_tiles.push_back(index);
+        continue;
+      }
+
+      const SurfacePtr surface = tile.get_current_surface();
+      if (!surface) continue;
+
+      // tiles of a tileset mostly share a few textures, so batch by
+      // texture instead of by surface
+      const TexturePtr texture = surface->get_texture();
+      const TexturePtr displacement_texture = surface->get_displacement_texture();
+      auto batch = std::find_if(chunk.batches.begin(), chunk.batches.end(),
+                                [&](const RetainedBatch& candidate) {
+                                  return candidate.get_texture() == texture &&
+                                         candidate.get_displacement_texture() == displacement_texture &&
+                                         candidate.get_flip() == surface->get_flip();
+                                });
+      if (batch == chunk.batches.end()) {
+        chunk.batches.emplace_back(texture, displacement_texture, surface->get_flip());
+        batch = chunk.batches.end() - 1;
+      }
+
+      batch->add(Rectf(surface->get_region()),
+                 Rectf(Vector(static_cast<float>(x), static_cast<float>(y)) * 32.0f,
+                       Sizef(static_cast<float>(surface->get_width()),
+                             static_cast<float>(surface->get_height()))));
+    }
+  }
+
+  chunk.valid = true;
+}
+
+void
+TileMap::invalidate_chunk(int x, int y)
+{
+  if (m_chunks.empty()) return;
+
+  const int chunks_width = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  m_chunks[(y / CHUNK_SIZE) * chunks_width + x / CHUNK_SIZE].valid = false;
 }
 
 /* EOF */
@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_OBJECT_TILEMAP_HPP
 
 #include <algorithm>
+#include <string.h>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -31,7 +32,9 @@
 #include "video/color.hpp"
 #include "video/flip.hpp"
 #include "video/drawing_target.hpp"
+#include "video/retained_batch.hpp"
 
+class Canvas;
 class DrawingContext;
 class Tile;
 class TileSet;
@@ -131,6 +134,22 @@ public:
 
   const Tile& get_tile(int x, int y) const;
   const Tile& get_tile_at(const Vector& pos) const;
+
+  /** Returns the collision flags of tile (x, y), which has to be
+      within the tilemap. Unlike get_tile() this doesn't go through
+      the TileSet, see m_tile_flags for the layout. */
+  uint32_t get_tile_flags(int x, int y) const { return m_tile_flags[y * m_width + x]; }
+
+  static uint32_t get_flags_attributes(uint32_t flags) { return flags & 0xffff; }
+  static int get_flags_slope_data(uint32_t flags) { return static_cast<int>(flags >> 16); }
+
+  /** Calls @c func(x, y, flags) for every tile in the half-open range
+      @c tiles with non-zero collision flags, row by row. Empty rows
+      and pairs of empty tiles are skipped without looking at the
+      single tiles. */
+  template<typename F>
+  void for_each_flagged_tile(const Rect& tiles, F func) const;
+
   uint32_t get_tile_id(int x, int y) const;
   uint32_t get_tile_id_at(const Vector& pos) const;
 
@@ -188,8 +207,42 @@ public:
 
   const std::vector<uint32_t>& get_tiles() const { return m_tiles; }
   
+private:
+  /** The tiles of a square of CHUNK_SIZE x CHUNK_SIZE tiles, kept
+      between frames so the renderer can hold on to their vertices */
+  struct Chunk
+  {
+    Chunk() :
+      valid(false),
+      batches(),
+      animated_tiles()
+    {}
+
+    bool valid;
+
+    /** The non-animated tiles, one batch per texture, positioned
+        relative to the tilemap offset */
+    std::vector<RetainedBatch> batches;
+
+    /** Indices of the animated tiles, which are drawn each frame */
+    std::vector<int> animated_tiles;
+  };
+
 private:
   void update_effective_solid();
+
+  /** Returns the chunk containing tile (x, y), building it first if
+      it is out of date */
+  const Chunk& get_chunk(int x, int y);
+  void build_chunk(Chunk& chunk, int chunk_x, int chunk_y) const;
+
+  /** Marks the chunk containing tile (x, y) as out of date */
+  void invalidate_chunk(int x, int y);
+
+  /** Recalculates the collision flags of all tiles, or of the tile
+      at @c index only */
+  void update_tile_flags();
+  void update_tile_flags(size_t index);
   void float_channel(float target, float &current, float remaining_time, float dt_sec);
 
   bool is_corner(uint32_t tile);
@@ -203,6 +256,19 @@ private:
   typedef std::vector<uint32_t> Tiles;
   Tiles m_tiles;
 
+  /** Collision flags of each tile, kept alongside m_tiles so the
+      collision code doesn't have to look up every Tile: the tile
+      attributes (Tile::SOLID, Tile::UNISOLID, ...) in the low 16 bits
+      and the slope type of slopes in the high 16 bits */
+  std::vector<uint32_t> m_tile_flags;
+
+  /** Number of tiles with non-zero flags in each row */
+  std::vector<int> m_row_flag_counts;
+
+  /** Chunks covering the tilemap row by row, empty until the first
+      draw and after the whole tilemap changed */
+  std::vector<Chunk> m_chunks;
+
   /* read solid: In *general*, is this a solid layer? effective solid:
      is the layer *currently* solid? A generally solid layer may be
      not solid when its alpha is low. See `is_solid' above. */
@@ -246,6 +312,36 @@ private:
   TileMap& operator=(const TileMap&) = delete;
 };
 
+template<typename F>
+void
+TileMap::for_each_flagged_tile(const Rect& tiles, F func) const
+{
+  for (int y = tiles.top; y < tiles.bottom; ++y)
+  {
+    if (m_row_flag_counts[y] == 0)
+      continue;
+
+    const uint32_t* row = &m_tile_flags[y * m_width];
+    int x = tiles.left;
+
+    // check two tiles at once, most tiles of a solid tilemap are air
+    for (; x + 2 <= tiles.right; x += 2)
+    {
+      uint64_t pair;
+      memcpy(&pair, row + x, sizeof(pair));
+      if (pair == 0)
+        continue;
+
+      if (row[x] != 0) func(x, y, row[x]);
+      if (row[x + 1] != 0) func(x + 1, y, row[x + 1]);
+    }
+
+    if (x < tiles.right && row[x] != 0) {
+      func(x, y, row[x]);
+    }
+  }
+}
+
 #endif
 
 /* EOF */
@@ -35,7 +35,7 @@ WaterDrop::WaterDrop(const Vector& pos, const std::string& sprite_path_, const V
 void
 WaterDrop::update(float dt_sec)
 {
-  m_col.m_movement = physic.get_movement(dt_sec);
+  m_col.set_movement(physic.get_movement(dt_sec));
 
   if ( m_sprite->animation_done() ) {
     remove_me();
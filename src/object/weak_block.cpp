@@ -106,6 +106,7 @@ WeakBlock::collision(GameObject& other, const CollisionHit& hit)
           break;
 
         if (auto badguy = dynamic_cast<BadGuy*> (&other)) {
+          badguy->wake_up();
           badguy->ignite();
         }
         break;
@@ -26,6 +26,7 @@ void
 BadGuy::kill()
 {
   SCRIPT_GUARD_VOID;
+  object.wake_up();
   object.kill_fall();
 }
 
@@ -33,6 +34,7 @@ void
 BadGuy::ignite()
 {
   SCRIPT_GUARD_VOID;
+  object.wake_up();
   if(!object.is_flammable() || object.is_ignited())
   {
     return;
@@ -45,6 +47,7 @@ void
 BadGuy::set_action(const std::string& action, int loops)
 {
   SCRIPT_GUARD_VOID;
+  object.wake_up();
   object.set_sprite_action(action, loops);
 }
 
@@ -52,6 +55,7 @@ void
 BadGuy::set_sprite(const std::string& sprite)
 {
   SCRIPT_GUARD_VOID;
+  object.wake_up();
   object.change_sprite(sprite);
 }
 
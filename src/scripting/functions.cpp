@@ -21,17 +21,21 @@
 #include "object/camera.hpp"
 #include "object/player.hpp"
 #include "physfs/ifile_stream.hpp"
+#include "physfs/ofile_stream.hpp"
+#include "supertux/class_cost_stats.hpp"
 #include "supertux/console.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/game_manager.hpp"
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/memory_usage.hpp"
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/shrinkfade.hpp"
 #include "supertux/textscroller_screen.hpp"
 #include "supertux/tile.hpp"
+#include "util/profiler.hpp"
 #include "video/renderer.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
@@ -287,6 +291,52 @@ void debug_worldmap_ghost(bool enable)
   tux.set_ghost_mode(enable);
 }
 
+void debug_show_frame_graph(bool enable)
+{
+  g_debug.show_frame_graph = enable;
+}
+
+void debug_class_costs(bool enable)
+{
+  g_class_cost_stats.set_enabled(enable);
+}
+
+void debug_print_class_costs(int count)
+{
+  std::ostringstream out;
+  g_class_cost_stats.print(out, count > 0 ? static_cast<size_t>(count) : 0);
+  log_info << out.str();
+}
+
+void debug_dump_profile(int frames)
+{
+#ifndef ENABLE_PROFILER
+  log_warning << "Profiling needs a build with ENABLE_PROFILER" << std::endl;
+#endif
+  OFileStream out("profile.json");
+  Profiler::write_trace(out, frames > 0 ? static_cast<size_t>(frames) : 0);
+  log_info << "Wrote profile of the last " << frames << " frames to profile.json" << std::endl;
+}
+
+void debug_show_memory_usage(bool enable)
+{
+  g_debug.show_memory_usage = enable;
+}
+
+void debug_print_memory_usage(int count)
+{
+  std::ostringstream out;
+  MemoryUsage::collect(count > 0).print(out, count > 0 ? static_cast<size_t>(count) : 0);
+  log_info << out.str();
+}
+
+void debug_dump_memory_usage(int count)
+{
+  OFileStream out("memory.json");
+  MemoryUsage::collect(true).write_json(out, count > 0 ? static_cast<size_t>(count) : 0);
+  log_info << "Wrote memory usage to memory.json" << std::endl;
+}
+
 void save_state()
 {
   auto worldmap = worldmap::WorldMap::current();
@@ -97,6 +97,35 @@ void debug_draw_editor_images(bool enable);
 /** enable/disable worldmap ghost mode */
 void debug_worldmap_ghost(bool enable);
 
+/** enable/disable drawing of the frame time graph */
+void debug_show_frame_graph(bool enable);
+
+/** enable/disable measuring the update and draw time of each
+    GameObject class */
+void debug_class_costs(bool enable);
+
+/** Prints the @c count GameObject classes that took the most time
+    recently */
+void debug_print_class_costs(int count);
+
+/** Writes the profiled scopes of the last @c frames frames to
+    profile.json in the user directory, in Chrome's trace_event
+    format */
+void debug_dump_profile(int frames);
+
+/** enable/disable drawing of the memory used by textures, sounds,
+    fonts and sprites */
+void debug_show_memory_usage(bool enable);
+
+/** Prints the memory used by textures, sounds, fonts and sprites,
+    and the @c count largest of them */
+void debug_print_memory_usage(int count);
+
+/** Writes the memory used by textures, sounds, fonts and sprites,
+    with the @c count largest of each, to memory.json in the user
+    directory */
+void debug_dump_memory_usage(int count);
+
 /** Changes music to musicfile */
 void play_music(const std::string& musicfile);
 
@@ -214,6 +214,21 @@ SpriteData::parse_action(const ReaderMapping& mapping)
   actions[action->name] = std::move(action);
 }
 
+size_t
+SpriteData::get_memory_size() const
+{
+  size_t bytes = sizeof(SpriteData) + name.capacity();
+  for (const auto& it : actions)
+  {
+    const Action& action = *it.second;
+    bytes += it.first.capacity() + sizeof(Action) +
+             action.name.capacity() + action.family_name.capacity() +
+             action.surfaces.capacity() * sizeof(SurfacePtr) +
+             action.surfaces.size() * sizeof(Surface);
+  }
+  return bytes;
+}
+
 const SpriteData::Action*
 SpriteData::get_action(const std::string& act) const
 {
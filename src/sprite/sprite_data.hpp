@@ -36,6 +36,10 @@ public:
     return name;
   }
 
+  /** Estimates the bytes taken by the actions and their Surfaces,
+      not counting the textures, which belong to TextureManager */
+  size_t get_memory_size() const;
+
 private:
   friend class Sprite;
 
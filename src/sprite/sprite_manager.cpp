@@ -17,6 +17,7 @@
 #include "sprite/sprite_manager.hpp"
 
 #include "sprite/sprite.hpp"
+#include "supertux/memory_usage.hpp"
 #include "util/file_system.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
@@ -25,7 +26,8 @@
 #include <sstream>
 
 SpriteManager::SpriteManager() :
-  sprites()
+  sprites(),
+  m_sprite_bytes(0)
 {
 }
 
@@ -79,10 +81,23 @@ SpriteManager::load(const std::string& filename)
     throw std::runtime_error(msg.str());
   } else {
     auto data = std::make_unique<SpriteData>(root.get_mapping());
+    m_sprite_bytes += data->get_memory_size();
     sprites[filename] = std::move(data);
 
     return sprites[filename].get();
   }
 }
 
+void
+SpriteManager::get_memory_usage(MemoryUsage& usage) const
+{
+  usage.add_category("sprites", "cpu", m_sprite_bytes, sprites.size());
+  if (usage.wants_entries())
+  {
+    for (const auto& it : sprites) {
+      usage.add_entry(it.first, it.second->get_memory_size());
+    }
+  }
+}
+
 /* EOF */
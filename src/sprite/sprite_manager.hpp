@@ -24,6 +24,7 @@
 #include "sprite/sprite_ptr.hpp"
 #include "util/currenton.hpp"
 
+class MemoryUsage;
 class SpriteData;
 
 class SpriteManager final : public Currenton<SpriteManager>
@@ -32,12 +33,18 @@ private:
   typedef std::map<std::string, std::unique_ptr<SpriteData> > Sprites;
   Sprites sprites;
 
+  /** Sum of SpriteData::get_memory_size() of the loaded sprites */
+  size_t m_sprite_bytes;
+
 public:
   SpriteManager();
 
   /** loads a sprite. */
   SpritePtr create(const std::string& filename);
 
+  /** Adds the loaded sprite data */
+  void get_memory_usage(MemoryUsage& usage) const;
+
 private:
   SpriteData* load(const std::string& filename);
 };
@@ -0,0 +1,203 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/activation_manager.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+#include <typeinfo>
+
+#include "object/camera.hpp"
+#include "object/player.hpp"
+#include "object/tilemap.hpp"
+#include "supertux/sector.hpp"
+
+namespace {
+
+/** Keeps bucket coordinates of far away positions within int range */
+const float MAX_BUCKET = 1.0e6f;
+
+int to_bucket(float coordinate, float size)
+{
+  const float bucket = floorf(coordinate / size);
+  return static_cast<int>(std::max(-MAX_BUCKET, std::min(bucket, MAX_BUCKET)));
+}
+
+uint64_t bucket_key(int x, int y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+} // namespace
+
+ActivationManager::ActivationManager(Sector& sector, const Sizef& distance) :
+  m_sector(sector),
+  m_distance(distance),
+  m_buckets(),
+  m_object_buckets(),
+  m_camera(nullptr),
+  m_players(),
+  m_centers(),
+  m_new_centers(),
+  m_static_bboxes(),
+  m_new_static_bboxes()
+{
+}
+
+ActivationManager::~ActivationManager()
+{
+  wake_all();
+}
+
+void
+ActivationManager::make_dormant(GameObject& object, const Vector& pos)
+{
+  assert(!object.is_dormant());
+
+  if (is_near(pos))
+    return;
+
+  const uint64_t key = get_bucket(pos);
+  m_buckets[key].push_back({ &object, pos });
+  m_object_buckets[&object] = key;
+  object.m_activation_manager = this;
+}
+
+void
+ActivationManager::wake(GameObject& object)
+{
+  auto it = m_object_buckets.find(&object);
+  assert(it != m_object_buckets.end());
+
+  auto& sleepers = m_buckets[it->second];
+  for (auto& sleeper : sleepers) {
+    if (sleeper.object == &object) {
+      sleeper = sleepers.back();
+      sleepers.pop_back();
+      break;
+    }
+  }
+
+  m_object_buckets.erase(it);
+  object.m_activation_manager = nullptr;
+}
+
+void
+ActivationManager::begin_update()
+{
+  const auto& cameras = m_sector.get_objects_by_type_index(typeid(Camera));
+  m_camera = cameras.empty() ? nullptr : static_cast<const Camera*>(cameras.front());
+
+  m_players.clear();
+  for (const auto* player : m_sector.get_objects_by_type_index(typeid(Player))) {
+    m_players.push_back(static_cast<const Player*>(player));
+  }
+
+  wake_up();
+}
+
+void
+ActivationManager::wake_up()
+{
+  m_new_static_bboxes.clear();
+  for (const auto* solids : m_sector.get_solid_tilemaps()) {
+    if (!solids->get_walker()) {
+      m_new_static_bboxes.push_back(solids->get_bbox());
+    }
+  }
+
+  if (m_new_static_bboxes != m_static_bboxes)
+  {
+    std::swap(m_static_bboxes, m_new_static_bboxes);
+    wake_all();
+  }
+
+  m_new_centers.clear();
+  if (m_camera) {
+    m_new_centers.push_back(m_camera->get_center());
+  }
+  for (const auto* player : m_players) {
+    m_new_centers.push_back(player->get_bbox().get_middle());
+  }
+
+  if (m_new_centers == m_centers)
+    return;
+
+  std::swap(m_centers, m_new_centers);
+
+  if (m_object_buckets.empty())
+    return;
+
+  for (const auto& center : m_centers)
+  {
+    const int left = to_bucket(center.x - m_distance.width, m_distance.width);
+    const int right = to_bucket(center.x + m_distance.width, m_distance.width);
+    const int top = to_bucket(center.y - m_distance.height, m_distance.height);
+    const int bottom = to_bucket(center.y + m_distance.height, m_distance.height);
+
+    for (int x = left; x <= right; ++x) {
+      for (int y = top; y <= bottom; ++y) {
+        auto it = m_buckets.find(bucket_key(x, y));
+        if (it == m_buckets.end())
+          continue;
+
+        auto& sleepers = it->second;
+        for (size_t i = sleepers.size(); i-- > 0;) {
+          const Vector dist = center - sleepers[i].pos;
+          if (fabsf(dist.x) <= m_distance.width && fabsf(dist.y) <= m_distance.height) {
+            GameObject& object = *sleepers[i].object;
+            sleepers[i] = sleepers.back();
+            sleepers.pop_back();
+            m_object_buckets.erase(&object);
+            object.m_activation_manager = nullptr;
+          }
+        }
+      }
+    }
+  }
+}
+
+uint64_t
+ActivationManager::get_bucket(const Vector& pos) const
+{
+  return bucket_key(to_bucket(pos.x, m_distance.width),
+                    to_bucket(pos.y, m_distance.height));
+}
+
+bool
+ActivationManager::is_near(const Vector& pos) const
+{
+  for (const auto& center : m_centers) {
+    const Vector dist = center - pos;
+    if (fabsf(dist.x) <= m_distance.width && fabsf(dist.y) <= m_distance.height) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+ActivationManager::wake_all()
+{
+  for (const auto& entry : m_object_buckets) {
+    entry.first->m_activation_manager = nullptr;
+  }
+  m_object_buckets.clear();
+  m_buckets.clear();
+}
+
+/* EOF */
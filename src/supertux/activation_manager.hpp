@@ -0,0 +1,105 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_ACTIVATION_MANAGER_HPP
+#define HEADER_SUPERTUX_SUPERTUX_ACTIVATION_MANAGER_HPP
+
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+#include "math/rectf.hpp"
+#include "math/sizef.hpp"
+#include "math/vector.hpp"
+
+class Camera;
+class GameObject;
+class Player;
+class Sector;
+
+/** Keeps the dormant objects of a Sector, which are skipped by
+    GameObjectManager::update() until the camera or a player comes
+    close to them. Dormant objects are bucketed by position, so waking
+    them up only has to look at the buckets around the camera and the
+    players instead of at every object of the sector. */
+class ActivationManager final
+{
+public:
+  /** Objects are woken up once the center of the camera or of a
+      player is within @c distance of them on both axes */
+  ActivationManager(Sector& sector, const Sizef& distance);
+  ~ActivationManager();
+
+  /** Lets @c object sleep at @c pos. Does nothing if the camera or a
+      player is close to @c pos already. */
+  void make_dormant(GameObject& object, const Vector& pos);
+
+  /** Takes @c object out of the manager, so that it is updated
+      again */
+  void wake(GameObject& object);
+
+  /** Looks up the camera and the players and wakes up the objects
+      near them, to be called before each round of object updates */
+  void begin_update();
+
+  /** Wakes up the objects the camera or a player came close to since
+      the last call. Everything is woken up when a solid tilemap that
+      doesn't follow a path was added, removed, moved or resized, as
+      dormant objects rely on Sector::inside_static() staying the
+      same. */
+  void wake_up();
+
+private:
+  struct Sleeper
+  {
+    GameObject* object;
+    Vector pos;
+  };
+
+private:
+  uint64_t get_bucket(const Vector& pos) const;
+  bool is_near(const Vector& pos) const;
+  void wake_all();
+
+private:
+  Sector& m_sector;
+  Sizef m_distance;
+
+  std::unordered_map<uint64_t, std::vector<Sleeper> > m_buckets;
+
+  /** The bucket each dormant object sleeps in */
+  std::unordered_map<GameObject*, uint64_t> m_object_buckets;
+
+  const Camera* m_camera;
+  std::vector<const Player*> m_players;
+
+  /** Centers of camera and players as of the last wake_up() */
+  std::vector<Vector> m_centers;
+  std::vector<Vector> m_new_centers;
+
+  /** Bounding boxes of the static solid tilemaps as of the last
+      wake_up() */
+  std::vector<Rectf> m_static_bboxes;
+  std::vector<Rectf> m_new_static_bboxes;
+
+private:
+  ActivationManager(const ActivationManager&) = delete;
+  ActivationManager& operator=(const ActivationManager&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,122 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/benchmark.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <numeric>
+
+namespace {
+
+/** Nearest-rank percentile of @c values, 0 for an empty list */
+float percentile_of(std::vector<float> values, float percentile)
+{
+  if (values.empty())
+    return 0.0f;
+
+  std::sort(values.begin(), values.end());
+  const float rank = ceilf(percentile / 100.0f * static_cast<float>(values.size()));
+  const size_t index = static_cast<size_t>(std::max(rank, 1.0f)) - 1;
+  return values[std::min(index, values.size() - 1)];
+}
+
+float sum_of(const std::vector<float>& values)
+{
+  return std::accumulate(values.begin(), values.end(), 0.0f);
+}
+
+void print_times(std::ostream& out, const char* name, const std::vector<float>& values)
+{
+  const float mean = values.empty() ? 0.0f : sum_of(values) / static_cast<float>(values.size());
+  out << "  " << name << " (ms):"
+      << " mean " << mean * 1000.0f
+      << ", p50 " << percentile_of(values, 50.0f) * 1000.0f
+      << ", p90 " << percentile_of(values, 90.0f) * 1000.0f
+      << ", p99 " << percentile_of(values, 99.0f) * 1000.0f
+      << ", max " << percentile_of(values, 100.0f) * 1000.0f
+      << '\n';
+}
+
+} // namespace
+
+Benchmark::Benchmark() :
+  m_step_times(),
+  m_frame_times(),
+  m_objects_total(0),
+  m_objects_max(0),
+  m_tested_pairs_total(0),
+  m_tested_pairs_max(0)
+{
+}
+
+void
+Benchmark::add_step(float seconds, size_t objects, size_t tested_pairs)
+{
+  m_step_times.push_back(seconds);
+  m_objects_total += objects;
+  m_objects_max = std::max(m_objects_max, objects);
+  m_tested_pairs_total += tested_pairs;
+  m_tested_pairs_max = std::max(m_tested_pairs_max, tested_pairs);
+}
+
+void
+Benchmark::add_frame(float seconds)
+{
+  m_frame_times.push_back(seconds);
+}
+
+float
+Benchmark::get_step_percentile(float percentile) const
+{
+  return percentile_of(m_step_times, percentile);
+}
+
+float
+Benchmark::get_frame_percentile(float percentile) const
+{
+  return percentile_of(m_frame_times, percentile);
+}
+
+void
+Benchmark::print(std::ostream& out) const
+{
+  const size_t steps = m_step_times.size();
+  const float seconds = sum_of(m_step_times) + sum_of(m_frame_times);
+
+  out << "Benchmark: " << steps << " steps in " << seconds << " seconds";
+  if (seconds > 0.0f)
+    out << " (" << static_cast<float>(steps) / seconds << " steps per second)";
+  out << '\n';
+
+  print_times(out, "update", m_step_times);
+  if (!m_frame_times.empty())
+    print_times(out, "draw", m_frame_times);
+
+  if (steps > 0)
+  {
+    out << "  objects alive: mean " << m_objects_total / steps
+        << ", max " << m_objects_max << '\n'
+        << "  collision pairs tested: mean " << m_tested_pairs_total / steps
+        << ", max " << m_tested_pairs_max
+        << ", total " << m_tested_pairs_total << '\n';
+  }
+
+  out << std::flush;
+}
+
+/* EOF */
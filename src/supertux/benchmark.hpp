@@ -0,0 +1,66 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+#define HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+
+#include <ostream>
+#include <stddef.h>
+#include <vector>
+
+/** Collects the timings of a --benchmark run, in which
+    ScreenManager::run_benchmark() plays back a demo as fast as
+    possible, and prints a summary of them */
+class Benchmark final
+{
+public:
+  Benchmark();
+
+  /** Records a game step that took @c seconds to update, with
+      @c objects alive in the sector and @c tested_pairs collision
+      pairs tested */
+  void add_step(float seconds, size_t objects, size_t tested_pairs);
+
+  /** Records a frame that took @c seconds to draw */
+  void add_frame(float seconds);
+
+  size_t get_step_count() const { return m_step_times.size(); }
+
+  /** Returns the time in seconds that @c percentile percent of the
+      steps stayed within */
+  float get_step_percentile(float percentile) const;
+  float get_frame_percentile(float percentile) const;
+
+  void print(std::ostream& out) const;
+
+private:
+  std::vector<float> m_step_times;
+  std::vector<float> m_frame_times;
+
+  size_t m_objects_total;
+  size_t m_objects_max;
+  size_t m_tested_pairs_total;
+  size_t m_tested_pairs_max;
+
+private:
+  Benchmark(const Benchmark&) = delete;
+  Benchmark& operator=(const Benchmark&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,160 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/class_cost_stats.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "supertux/game_object.hpp"
+
+ClassCostStats g_class_cost_stats;
+
+ClassCostStats::ClassCostStats() :
+  m_enabled(false),
+  m_frame(0),
+  m_entries()
+{
+}
+
+void
+ClassCostStats::set_enabled(bool enabled)
+{
+  if (enabled && !m_enabled)
+  {
+    m_entries.clear();
+    m_frame = 0;
+  }
+  m_enabled = enabled;
+}
+
+ClassCostStats::Sample&
+ClassCostStats::get_sample(const GameObject& object)
+{
+  auto it = m_entries.find(typeid(object));
+  if (it == m_entries.end())
+  {
+    Entry entry;
+    entry.class_name = object.get_class();
+    entry.samples.fill(Sample());
+    it = m_entries.emplace(typeid(object), std::move(entry)).first;
+  }
+  return it->second.samples[m_frame % WINDOW];
+}
+
+void
+ClassCostStats::add_update(const GameObject& object, uint64_t nanoseconds)
+{
+  Sample& sample = get_sample(object);
+  sample.update_time += nanoseconds;
+  sample.update_calls += 1;
+}
+
+void
+ClassCostStats::add_draw(const GameObject& object, uint64_t nanoseconds, int requests)
+{
+  Sample& sample = get_sample(object);
+  sample.draw_time += nanoseconds;
+  sample.draw_calls += 1;
+  sample.draw_requests += static_cast<uint32_t>(std::max(requests, 0));
+}
+
+void
+ClassCostStats::next_frame()
+{
+  m_frame += 1;
+  for (auto& it : m_entries) {
+    it.second.samples[m_frame % WINDOW] = Sample();
+  }
+}
+
+std::vector<ClassCostStats::Cost>
+ClassCostStats::get_top(size_t count) const
+{
+  // the current frame is still running, leave it out unless there is
+  // nothing else
+  const size_t frames = std::max<size_t>(std::min(m_frame, WINDOW - 1), 1);
+  const float scale = 1.0f / static_cast<float>(frames);
+
+  std::vector<Cost> costs;
+  for (const auto& it : m_entries)
+  {
+    Sample total = Sample();
+    for (size_t i = 0; i < WINDOW; ++i)
+    {
+      if (i == m_frame % WINDOW && m_frame > 0)
+        continue;
+
+      const Sample& sample = it.second.samples[i];
+      total.update_time += sample.update_time;
+      total.draw_time += sample.draw_time;
+      total.update_calls += sample.update_calls;
+      total.draw_calls += sample.draw_calls;
+      total.draw_requests += sample.draw_requests;
+    }
+
+    costs.push_back({ it.second.class_name,
+                      static_cast<float>(total.update_time) / 1.0e9f * scale,
+                      static_cast<float>(total.draw_time) / 1.0e9f * scale,
+                      static_cast<float>(total.update_calls) * scale,
+                      static_cast<float>(total.draw_calls) * scale,
+                      static_cast<float>(total.draw_requests) * scale });
+  }
+
+  std::sort(costs.begin(), costs.end(),
+            [](const Cost& lhs, const Cost& rhs) {
+              return lhs.update_time + lhs.draw_time > rhs.update_time + rhs.draw_time;
+            });
+  if (costs.size() > count)
+    costs.resize(count);
+  return costs;
+}
+
+void
+ClassCostStats::print(std::ostream& out, size_t count) const
+{
+  if (!m_enabled)
+  {
+    out << "Class cost measurement is disabled" << std::endl;
+    return;
+  }
+
+  const auto old_flags = out.flags();
+  const auto old_precision = out.precision();
+
+  out << "Per frame over the last " << std::min(m_frame, WINDOW - 1) << " frames:\n"
+      << std::left << std::setw(28) << "class"
+      << std::right << std::setw(12) << "update ms" << std::setw(10) << "updates"
+      << std::setw(12) << "draw ms" << std::setw(10) << "draws" << std::setw(10) << "requests" << '\n';
+
+  out << std::fixed;
+  for (const auto& cost : get_top(count))
+  {
+    out << std::left << std::setw(28) << cost.class_name << std::right
+        << std::setprecision(3) << std::setw(12) << cost.update_time * 1000.0f
+        << std::setprecision(1) << std::setw(10) << cost.update_calls
+        << std::setprecision(3) << std::setw(12) << cost.draw_time * 1000.0f
+        << std::setprecision(1) << std::setw(10) << cost.draw_calls
+        << std::setw(10) << cost.draw_requests << '\n';
+  }
+  out << std::flush;
+
+  out.flags(old_flags);
+  out.precision(old_precision);
+}
+
+/* EOF */
@@ -0,0 +1,106 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_CLASS_COST_STATS_HPP
+#define HEADER_SUPERTUX_SUPERTUX_CLASS_COST_STATS_HPP
+
+#include <array>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+class GameObject;
+
+/** Sums up the time GameObjectManager spends in update() and draw()
+    of each class of GameObject, and the draw requests they emit, over
+    the last WINDOW frames. Nothing is measured while disabled. */
+class ClassCostStats final
+{
+public:
+  static const size_t WINDOW = 64;
+
+  /** Costs of one class, per frame on average over the window */
+  struct Cost
+  {
+    std::string class_name;
+    float update_time;
+    float draw_time;
+    float update_calls;
+    float draw_calls;
+    float draw_requests;
+  };
+
+public:
+  ClassCostStats();
+
+  bool is_enabled() const { return m_enabled; }
+
+  /** Enabling starts over with an empty window */
+  void set_enabled(bool enabled);
+
+  void add_update(const GameObject& object, uint64_t nanoseconds);
+  void add_draw(const GameObject& object, uint64_t nanoseconds, int requests);
+
+  /** Moves the window on by one frame, to be called once per frame */
+  void next_frame();
+
+  /** Returns the @c count classes with the highest update and draw
+      time, most expensive first */
+  std::vector<Cost> get_top(size_t count) const;
+
+  void print(std::ostream& out, size_t count) const;
+
+private:
+  struct Sample
+  {
+    uint64_t update_time;
+    uint64_t draw_time;
+    uint32_t update_calls;
+    uint32_t draw_calls;
+    uint32_t draw_requests;
+  };
+
+  struct Entry
+  {
+    std::string class_name;
+    std::array<Sample, WINDOW> samples;
+  };
+
+private:
+  Sample& get_sample(const GameObject& object);
+
+private:
+  bool m_enabled;
+
+  /** Frames seen since enabling, the sample index is m_frame % WINDOW */
+  size_t m_frame;
+
+  std::unordered_map<std::type_index, Entry> m_entries;
+
+private:
+  ClassCostStats(const ClassCostStats&) = delete;
+  ClassCostStats& operator=(const ClassCostStats&) = delete;
+};
+
+extern ClassCostStats g_class_cost_stats;
+
+#endif
+
+/* EOF */
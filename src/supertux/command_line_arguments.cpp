@@ -44,6 +44,9 @@ CommandLineArguments::CommandLineArguments() :
   enable_script_debugger(),
   start_demo(),
   record_demo(),
+  demo_seek(),
+  benchmark(),
+  benchmark_draw(),
   tux_spawn_pos(),
   sector(),
   spawnpoint(),
@@ -51,7 +54,8 @@ CommandLineArguments::CommandLineArguments() :
   christmas_mode(),
   repository_url(),
   editor(),
-  resave()
+  resave(),
+  editor_compress_tiles()
 {
 }
 
@@ -95,6 +99,8 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("Game Options:") << "\n"
     << _("  --edit-level                 Open given level in editor") << "\n"
     << _("  --resave                     Loads given level and saves it") << "\n"
+    << _("  --compress-tiles             Save tilemaps run-length encoded, e.g. with --resave") << "\n"
+    << _("  --no-compress-tiles          Save tilemaps as plain tile numbers") << "\n"
     << _("  --show-fps                   Display framerate in levels") << "\n"
     << _("  --no-show-fps                Do not display framerate in levels") << "\n"
     << _("  --show-pos                   Display player's current position") << "\n"
@@ -108,6 +114,9 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("Demo Recording Options:") << "\n"
     << _("  --record-demo FILE LEVEL     Record a demo to FILE") << "\n"
     << _("  --play-demo FILE LEVEL       Play a recorded demo") << "\n"
+    << _("  --demo-seek STEP             Fast-forward the played demo to STEP") << "\n"
+    << _("  --benchmark                  Play the demo as fast as possible without video and audio, then print timings") << "\n"
+    << _("  --benchmark-draw             Draw the frames of a benchmark with the null renderer") << "\n"
     << "\n"
     << _("Directory Options:") << "\n"
     << _("  --datadir DIR                Set the directory for the games datafiles") << "\n"
@@ -323,6 +332,25 @@ CommandLineArguments::parse_args(int argc, char** argv)
         record_demo = argv[++i];
       }
     }
+    else if (arg == "--demo-seek")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify a demo step");
+
+      int step;
+      if (sscanf(argv[i], "%9d", &step) != 1 || step < 0)
+        throw std::runtime_error("Invalid demo step, should be a number");
+      demo_seek = step;
+    }
+    else if (arg == "--benchmark")
+    {
+      benchmark = true;
+    }
+    else if (arg == "--benchmark-draw")
+    {
+      benchmark = true;
+      benchmark_draw = true;
+    }
     else if (arg == "--spawn-pos")
     {
       Vector spawn_pos;
@@ -377,6 +405,14 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       resave = true;
     }
+    else if (arg == "--compress-tiles")
+    {
+      editor_compress_tiles = true;
+    }
+    else if (arg == "--no-compress-tiles")
+    {
+      editor_compress_tiles = false;
+    }
     else if (arg[0] != '-')
     {
       filenames.push_back(arg);
@@ -391,6 +427,10 @@ CommandLineArguments::parse_args(int argc, char** argv)
   if (filenames.size() > 1 && !(resave && *resave)) {
     throw std::runtime_error("Only one filename allowed for the given options");
   }
+
+  if (benchmark && *benchmark && (filenames.empty() || !start_demo)) {
+    throw std::runtime_error("--benchmark needs a level and a demo given with --play-demo FILE");
+  }
 }
 
 void
@@ -415,6 +455,7 @@ CommandLineArguments::merge_into(Config& config)
   merge_option(developer_mode);
   merge_option(christmas_mode);
   merge_option(repository_url);
+  merge_option(editor_compress_tiles);
 
 #undef merge_option
 }
@@ -68,6 +68,9 @@ public:
   boost::optional<bool> enable_script_debugger;
   boost::optional<std::string> start_demo;
   boost::optional<std::string> record_demo;
+  boost::optional<int> demo_seek;
+  boost::optional<bool> benchmark;
+  boost::optional<bool> benchmark_draw;
   boost::optional<Vector> tux_spawn_pos;
   boost::optional<std::string> sector;
   boost::optional<std::string> spawnpoint;
@@ -80,6 +83,7 @@ public:
 
   boost::optional<bool> editor;
   boost::optional<bool> resave;
+  boost::optional<bool> editor_compress_tiles;
 
   // boost::optional<std::string> locale;
 
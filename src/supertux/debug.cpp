@@ -25,6 +25,8 @@ Debug::Debug() :
   show_collision_rects(false),
   show_worldmap_path(false),
   draw_redundant_frames(false),
+  show_frame_graph(false),
+  show_memory_usage(false),
   m_use_bitmap_fonts(false),
   m_game_speed_multiplier(1.0f)
 {
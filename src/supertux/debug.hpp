@@ -39,6 +39,14 @@ public:
   // vaguely measure the impact of code changes which should increase the FPS
   bool draw_redundant_frames;
 
+  /** Draw a graph of the recent frame times, needs a build with
+      ENABLE_PROFILER */
+  bool show_frame_graph;
+
+  /** Draw the bytes held by textures, sounds, fonts and sprites, see
+      MemoryUsage */
+  bool show_memory_usage;
+
 private:
   /** Use old bitmap fonts instead of TTF */
   bool m_use_bitmap_fonts;
@@ -0,0 +1,293 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/demo_file.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'D', 'M' };
+
+/** The number of controls stored per step in version 1 files */
+const int V1_CONTROLS = 6;
+
+void write_u32(std::ostream& out, uint32_t value)
+{
+  for (int i = 0; i < 4; ++i) {
+    out.put(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+void write_varint(std::ostream& out, uint32_t value)
+{
+  while (value >= 0x80) {
+    out.put(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.put(static_cast<char>(value));
+}
+
+void write_float(std::ostream& out, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  write_u32(out, bits);
+}
+
+uint32_t read_u32(std::istream& in)
+{
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    const int c = in.get();
+    if (c == EOF)
+      throw std::runtime_error("unexpected end of demo file");
+    value |= static_cast<uint32_t>(c) << (8 * i);
+  }
+  return value;
+}
+
+uint32_t read_varint(std::istream& in)
+{
+  uint32_t value = 0;
+  for (int shift = 0; shift < 32; shift += 7) {
+    const int c = in.get();
+    if (c == EOF)
+      throw std::runtime_error("unexpected end of demo file");
+    value |= static_cast<uint32_t>(c & 0x7f) << shift;
+    if (!(c & 0x80))
+      return value;
+  }
+  throw std::runtime_error("invalid number in demo file");
+}
+
+float read_float(std::istream& in)
+{
+  const uint32_t bits = read_u32(in);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+} // namespace
+
+namespace demo {
+
+uint32_t hash_level(std::istream& stream)
+{
+  uint32_t hash = 2166136261u;
+  char buffer[4096];
+  while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0) {
+    for (std::streamsize i = 0; i < stream.gcount(); ++i) {
+      hash ^= static_cast<uint8_t>(buffer[i]);
+      hash *= 16777619u;
+    }
+  }
+  return hash;
+}
+
+} // namespace demo
+
+DemoWriter::DemoWriter(std::unique_ptr<std::ostream> stream, int random_seed, uint32_t level_hash) :
+  m_stream(std::move(stream)),
+  m_step(0),
+  m_controls(0),
+  m_count(0)
+{
+  m_stream->write(MAGIC, sizeof(MAGIC));
+  m_stream->put(static_cast<char>(demo::VERSION));
+  write_u32(*m_stream, static_cast<uint32_t>(random_seed));
+  write_u32(*m_stream, level_hash);
+}
+
+DemoWriter::~DemoWriter()
+{
+  flush();
+}
+
+void
+DemoWriter::write_step(uint8_t controls, const Vector& player_pos)
+{
+  if (m_step % demo::KEYFRAME_INTERVAL == 0)
+  {
+    write_run();
+    m_stream->put(static_cast<char>(demo::KEYFRAME_MARKER));
+    write_varint(*m_stream, m_step);
+    write_float(*m_stream, player_pos.x);
+    write_float(*m_stream, player_pos.y);
+  }
+
+  if (m_count > 0 && controls != m_controls)
+    write_run();
+
+  m_controls = controls;
+  m_count += 1;
+  m_step += 1;
+}
+
+void
+DemoWriter::flush()
+{
+  write_run();
+  m_stream->flush();
+}
+
+void
+DemoWriter::write_run()
+{
+  if (m_count == 0)
+    return;
+
+  m_stream->put(static_cast<char>(m_controls));
+  write_varint(*m_stream, m_count);
+  m_count = 0;
+}
+
+DemoReader::DemoReader(std::unique_ptr<std::istream> stream) :
+  m_stream(std::move(stream)),
+  m_version(1),
+  m_has_random_seed(false),
+  m_random_seed(0),
+  m_level_hash(0),
+  m_step(0),
+  m_finished(false),
+  m_controls(0),
+  m_remaining(0),
+  m_has_keyframe(false),
+  m_keyframe()
+{
+  read_header();
+}
+
+void
+DemoReader::read_header()
+{
+  char magic[sizeof(MAGIC)];
+  m_stream->read(magic, sizeof(magic));
+  if (m_stream->gcount() == sizeof(magic) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0)
+  {
+    const int version = m_stream->get();
+    if (version != demo::VERSION)
+    {
+      std::ostringstream msg;
+      msg << "demo format version " << version << " is not supported";
+      throw std::runtime_error(msg.str());
+    }
+
+    m_version = version;
+    m_has_random_seed = true;
+    m_random_seed = static_cast<int>(read_u32(*m_stream));
+    m_level_hash = read_u32(*m_stream);
+  }
+  else
+  {
+    // old format, the seed is optional
+    m_stream->clear();
+    m_stream->seekg(0);
+
+    char buf[31] = {};
+    for (int i = 0; i < 30 && (i == 0 || buf[i-1]); i++)
+      m_stream->get(buf[i]);
+
+    int seed;
+    if (sscanf(buf, "random_seed=%10d", &seed) == 1)
+    {
+      m_has_random_seed = true;
+      m_random_seed = seed;
+    }
+    else
+    {
+      m_stream->clear();
+      m_stream->seekg(0);
+    }
+  }
+}
+
+bool
+DemoReader::read_step(uint8_t& controls)
+{
+  if (m_finished)
+    return false;
+
+  const bool result = (m_version == 1) ? read_step_v1(controls) : read_step_v2(controls);
+  if (!result)
+  {
+    m_finished = true;
+    return false;
+  }
+
+  m_step += 1;
+  return true;
+}
+
+const DemoReader::Keyframe*
+DemoReader::get_keyframe() const
+{
+  if (m_has_keyframe && m_keyframe.step + 1 == m_step)
+    return &m_keyframe;
+  else
+    return nullptr;
+}
+
+bool
+DemoReader::read_step_v1(uint8_t& controls)
+{
+  char buf[V1_CONTROLS];
+  m_stream->read(buf, sizeof(buf));
+  if (m_stream->gcount() != sizeof(buf))
+    return false;
+
+  controls = 0;
+  for (int i = 0; i < V1_CONTROLS; ++i) {
+    if (buf[i] != 0)
+      controls = static_cast<uint8_t>(controls | (1 << i));
+  }
+  return true;
+}
+
+bool
+DemoReader::read_step_v2(uint8_t& controls)
+{
+  while (m_remaining == 0)
+  {
+    const int c = m_stream->get();
+    if (c == EOF)
+      return false;
+
+    if (c == demo::KEYFRAME_MARKER)
+    {
+      m_keyframe.step = read_varint(*m_stream);
+      m_keyframe.player_pos.x = read_float(*m_stream);
+      m_keyframe.player_pos.y = read_float(*m_stream);
+      m_has_keyframe = true;
+    }
+    else
+    {
+      m_controls = static_cast<uint8_t>(c);
+      m_remaining = read_varint(*m_stream);
+    }
+  }
+
+  m_remaining -= 1;
+  controls = m_controls;
+  return true;
+}
+
+/* EOF */
@@ -0,0 +1,143 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_DEMO_FILE_HPP
+#define HEADER_SUPERTUX_SUPERTUX_DEMO_FILE_HPP
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdint.h>
+
+#include "math/vector.hpp"
+
+/** Demos store the controls held in each game step, as a bitfield
+    with one bit per Control from LEFT to ACTION.
+
+    Version 1 files have six bytes per step, one for each control,
+    after an optional "random_seed=" text header.
+
+    Version 2 files start with the magic "STDM", the version byte, the
+    random seed and a hash of the level file. They are followed by
+    runs of steps with the same controls (controls byte, then the run
+    length as varint) and, every KEYFRAME_INTERVAL steps, a keyframe
+    (KEYFRAME_MARKER, step as varint, player position as two floats)
+    that playback checks against to find desyncs. All numbers are
+    little endian. */
+namespace demo {
+
+const uint8_t VERSION = 2;
+const uint8_t KEYFRAME_MARKER = 0x80;
+const uint32_t KEYFRAME_INTERVAL = 256;
+
+/** FNV-1a hash of the contents of @c stream, used to tell whether a
+    demo was recorded on the level it is played back on */
+uint32_t hash_level(std::istream& stream);
+
+} // namespace demo
+
+/** Writes demos in the current format */
+class DemoWriter final
+{
+public:
+  DemoWriter(std::unique_ptr<std::ostream> stream, int random_seed, uint32_t level_hash);
+  ~DemoWriter();
+
+  /** Records the @c controls of the next step. @c player_pos, the
+      position of the player before the step, goes into keyframes. */
+  void write_step(uint8_t controls, const Vector& player_pos);
+
+  /** Writes out the pending run */
+  void flush();
+
+  uint32_t get_step() const { return m_step; }
+
+private:
+  void write_run();
+
+private:
+  std::unique_ptr<std::ostream> m_stream;
+  uint32_t m_step;
+  uint8_t m_controls;
+  uint32_t m_count;
+
+private:
+  DemoWriter(const DemoWriter&) = delete;
+  DemoWriter& operator=(const DemoWriter&) = delete;
+};
+
+/** Reads demos of both the current and the old format */
+class DemoReader final
+{
+public:
+  struct Keyframe
+  {
+    uint32_t step;
+    Vector player_pos;
+  };
+
+public:
+  /** Reads the header, throws an exception for unknown versions */
+  DemoReader(std::unique_ptr<std::istream> stream);
+
+  /** Returns the controls of the next step in @c controls, or false
+      once the demo is over */
+  bool read_step(uint8_t& controls);
+
+  /** Returns the keyframe recorded for the step returned last by
+      read_step(), nullptr if there is none */
+  const Keyframe* get_keyframe() const;
+
+  int get_version() const { return m_version; }
+  bool has_random_seed() const { return m_has_random_seed; }
+  int get_random_seed() const { return m_random_seed; }
+
+  /** 0 if the demo doesn't know its level */
+  uint32_t get_level_hash() const { return m_level_hash; }
+
+  /** Number of steps read so far */
+  uint32_t get_step() const { return m_step; }
+  bool is_finished() const { return m_finished; }
+
+private:
+  void read_header();
+  bool read_step_v1(uint8_t& controls);
+  bool read_step_v2(uint8_t& controls);
+
+private:
+  std::unique_ptr<std::istream> m_stream;
+  int m_version;
+  bool m_has_random_seed;
+  int m_random_seed;
+  uint32_t m_level_hash;
+  uint32_t m_step;
+  bool m_finished;
+
+  uint8_t m_controls;
+  uint32_t m_remaining;
+
+  bool m_has_keyframe;
+  Keyframe m_keyframe;
+
+private:
+  DemoReader(const DemoReader&) = delete;
+  DemoReader& operator=(const DemoReader&) = delete;
+};
+
+#endif
+
+/* EOF */
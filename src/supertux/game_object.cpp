@@ -18,6 +18,7 @@
 
 #include <algorithm>
 
+#include "supertux/activation_manager.hpp"
 #include "supertux/object_remove_listener.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/writer.hpp"
@@ -27,6 +28,7 @@ GameObject::GameObject() :
   m_name(),
   m_uid(),
   m_scheduled_for_removal(false),
+  m_activation_manager(nullptr),
   m_components(),
   m_remove_listeners()
 {
@@ -36,6 +38,7 @@ GameObject::GameObject(const std::string& name) :
   m_name(name),
   m_uid(),
   m_scheduled_for_removal(false),
+  m_activation_manager(nullptr),
   m_components(),
   m_remove_listeners()
 {
@@ -49,12 +52,22 @@ GameObject::GameObject(const ReaderMapping& reader) :
 
 GameObject::~GameObject()
 {
+  wake_up();
+
   for (const auto& entry : m_remove_listeners) {
     entry->object_removed(this);
   }
   m_remove_listeners.clear();
 }
 
+void
+GameObject::wake_up()
+{
+  if (m_activation_manager) {
+    m_activation_manager->wake(*this);
+  }
+}
+
 void
 GameObject::add_remove_listener(ObjectRemoveListener* listener)
 {
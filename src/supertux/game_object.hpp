@@ -25,6 +25,7 @@
 #include "util/gettext.hpp"
 #include "util/uid.hpp"
 
+class ActivationManager;
 class DrawingContext;
 class GameObjectComponent;
 class ObjectRemoveListener;
@@ -45,6 +46,7 @@ class Writer;
 */
 class GameObject
 {
+  friend class ActivationManager;
   friend class GameObjectManager;
 
 public:
@@ -101,6 +103,13 @@ public:
   /** schedules this object to be removed at the end of the frame */
   void remove_me() { m_scheduled_for_removal = true; }
 
+  /** returns true if the object sleeps in an ActivationManager, dormant
+      objects are skipped by GameObjectManager::update() */
+  bool is_dormant() const { return m_activation_manager != nullptr; }
+
+  /** wakes the object up if it is dormant */
+  void wake_up();
+
   /** registers a remove listener which will be called if the object
       gets removed/destroyed */
   void add_remove_listener(ObjectRemoveListener* listener);
@@ -175,6 +184,9 @@ private:
   /** this flag indicates if the object should be removed at the end of the frame */
   bool m_scheduled_for_removal;
 
+  /** the ActivationManager the object sleeps in while it is dormant */
+  ActivationManager* m_activation_manager;
+
   std::vector<std::unique_ptr<GameObjectComponent> > m_components;
 
   std::vector<ObjectRemoveListener*> m_remove_listeners;
@@ -20,6 +20,21 @@
 #include <algorithm>
 
 #include "object/tilemap.hpp"
+#include "supertux/class_cost_stats.hpp"
+#include "util/profiler.hpp"
+#include "video/drawing_context.hpp"
+
+namespace {
+
+int count_requests(DrawingContext& context)
+{
+  size_t count = context.color().get_pending_request_count();
+  if (!context.is_overlay())
+    count += context.light().get_pending_request_count();
+  return static_cast<int>(count);
+}
+
+} // namespace
 
 bool GameObjectManager::s_draw_solids_only = false;
 
@@ -112,18 +127,34 @@ GameObjectManager::clear_objects()
 void
 GameObjectManager::update(float dt_sec)
 {
+  PROFILE_SCOPE("GameObjectManager::update");
+
+  const bool measure = g_class_cost_stats.is_enabled();
   for (const auto& object : m_gameobjects)
   {
-    if (!object->is_valid())
+    if (!object->is_valid() || object->is_dormant())
       continue;
 
-    object->update(dt_sec);
+    if (measure)
+    {
+      const uint64_t start = Profiler::now();
+      object->update(dt_sec);
+      g_class_cost_stats.add_update(*object, Profiler::now() - start);
+    }
+    else
+    {
+      object->update(dt_sec);
+    }
+    after_object_update();
   }
 }
 
 void
 GameObjectManager::draw(DrawingContext& context)
 {
+  PROFILE_SCOPE("GameObjectManager::draw");
+
+  const bool measure = g_class_cost_stats.is_enabled();
   for (const auto& object : m_gameobjects)
   {
     if (!object->is_valid())
@@ -136,7 +167,18 @@ GameObjectManager::draw(DrawingContext& context)
         continue;
     }
 
-    object->draw(context);
+    if (measure)
+    {
+      const int requests = count_requests(context);
+      const uint64_t start = Profiler::now();
+      object->draw(context);
+      g_class_cost_stats.add_draw(*object, Profiler::now() - start,
+                                  count_requests(context) - requests);
+    }
+    else
+    {
+      object->draw(context);
+    }
   }
 }
 
@@ -83,6 +83,10 @@ public:
   /** Hook that is called before an object is removed from the vector */
   virtual void before_object_remove(GameObject& object) = 0;
 
+  /** Hook that is called after each object's update(), so dormant
+      objects can be woken up before their turn comes */
+  virtual void after_object_update() {}
+
   template<class T>
   GameObjectRange<T> get_objects_by_type() const
   {
@@ -29,28 +29,46 @@
 #include "object/music_object.hpp"
 #include "object/player.hpp"
 #include "sdk/integration.hpp"
+#include "supertux/colorscheme.hpp"
 #include "supertux/fadetoblack.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_loader.hpp"
 #include "supertux/level_parser.hpp"
 #include "supertux/levelintro.hpp"
 #include "supertux/levelset_screen.hpp"
 #include "supertux/menu/menu_storage.hpp"
+#include "supertux/resources.hpp"
 #include "supertux/savegame.hpp"
 #include "supertux/screen_manager.hpp"
 #include "supertux/sector.hpp"
 #include "util/file_system.hpp"
+#include "util/gettext.hpp"
+#include "util/profiler.hpp"
+#include "util/reader_document.hpp"
+#include "util/timelog.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
+#include "video/texture_manager.hpp"
+#include "video/video_system.hpp"
 #include "worldmap/worldmap.hpp"
 
+namespace {
+
+/** Loading that takes less than this many milliseconds goes without
+    a progress screen, so that respawning doesn't flicker */
+const Uint32 PROGRESS_DELAY = 100;
+
+} // namespace
+
 GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics) :
   GameSessionRecorder(),
   reset_button(false),
   reset_checkpoint_button(false),
   m_level(),
   m_old_level(),
+  m_level_doc(),
   m_statistics_backdrop(Surface::from_file("images/engine/menu/score-backdrop.png")),
   m_scripts(),
   m_currentsector(nullptr),
@@ -84,6 +102,10 @@ GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Stat
     throw std::runtime_error ("Initializing the level failed.");
 }
 
+GameSession::~GameSession()
+{
+}
+
 void
 GameSession::reset_level()
 {
@@ -122,9 +144,29 @@ GameSession::restart_level(bool after_death)
     m_levelfile = FileSystem::basename(m_levelfile);
   }
 
+  PROFILE_SCOPE("GameSession::restart_level");
+  Timelog timelog;
   try {
     m_old_level = std::move(m_level);
-    m_level = LevelParser::from_file(m_levelfile, false, false);
+
+    // the images of the level are still loaded, as the old level
+    // holds on to them, so only the first start needs the loader
+    if (!m_level_doc) {
+      timelog.log("level files");
+      LevelLoader loader(m_levelfile, TextureManager::current()->get_filenames());
+      const Uint32 start_ticks = SDL_GetTicks();
+      while (!loader.wait(std::chrono::milliseconds(16))) {
+        if (SDL_GetTicks() - start_ticks >= PROGRESS_DELAY) {
+          draw_loading_progress(loader.get_progress());
+        }
+      }
+      m_level_doc = loader.finish();
+    }
+
+    timelog.log("level objects");
+    m_level = LevelParser::from_document(*m_level_doc, false, false);
+
+    timelog.log("sector activation");
 
     if (!m_reset_sector.empty()) {
       m_currentsector = m_level->get_sector(m_reset_sector);
@@ -147,10 +189,14 @@ GameSession::restart_level(bool after_death)
     }
   } catch(std::exception& e) {
     log_fatal << "Couldn't start level: " << e.what() << std::endl;
+    TextureManager::current()->clear_preloaded();
     ScreenManager::current()->pop_screen();
     return (-1);
   }
 
+  TextureManager::current()->clear_preloaded();
+  timelog.log(nullptr);
+
   auto& music_object = m_currentsector->get_singleton_by_type<MusicObject>();
   if (after_death == true) {
     music_object.resume_music();
@@ -287,6 +333,33 @@ GameSession::draw_pause(DrawingContext& context)
     LAYER_FOREGROUND1);
 }
 
+void
+GameSession::draw_loading_progress(float progress)
+{
+  // keep the window responsive, the events are handled once the
+  // level runs
+  SDL_PumpEvents();
+
+  Compositor compositor(*VideoSystem::current());
+  auto& context = compositor.make_context();
+
+  const float width = static_cast<float>(context.get_width());
+  const float height = static_cast<float>(context.get_height());
+
+  context.color().draw_filled_rect(Rectf(0, 0, width, height),
+                                   Color(0.0f, 0.0f, 0.0f, 1.0f), 0);
+
+  const Rectf bar(width / 4.0f, height / 2.0f, width * 3.0f / 4.0f, height / 2.0f + 8.0f);
+  context.color().draw_center_text(Resources::normal_font, _("Loading..."),
+                                   Vector(0, bar.get_top() - 2.0f * Resources::normal_font->get_height()),
+                                   LAYER_FOREGROUND1, ColorScheme::Text::heading_color);
+  context.color().draw_filled_rect(bar, Color(0.3f, 0.3f, 0.3f, 1.0f), LAYER_FOREGROUND1);
+  context.color().draw_filled_rect(Rectf(bar.p1(), Sizef(bar.get_width() * progress, bar.get_height())),
+                                   Color(1.0f, 1.0f, 1.0f, 1.0f), LAYER_FOREGROUND1);
+
+  compositor.render();
+}
+
 void
 GameSession::setup()
 {
@@ -35,6 +35,7 @@ class CodeController;
 class DrawingContext;
 class EndSequence;
 class Level;
+class ReaderDocument;
 class Sector;
 class Statistics;
 class Savegame;
@@ -46,6 +47,7 @@ class GameSession final : public Screen,
 {
 public:
   GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr);
+  ~GameSession() override;
 
   virtual void draw(Compositor& compositor) override;
   virtual void update(float dt_sec, const Controller& controller) override;
@@ -99,11 +101,19 @@ private:
   void drawstatus(DrawingContext& context);
   void draw_pause(DrawingContext& context);
 
+  /** Draws a frame with a progress bar while restart_level() waits
+      for the LevelLoader */
+  void draw_loading_progress(float progress);
+
   void on_escape_press();
 
 private:
   std::unique_ptr<Level> m_level;
   std::unique_ptr<Level> m_old_level;
+
+  /** The parsed level file, kept so that restart_level() can rebuild
+      the level without reading and parsing the file again */
+  std::unique_ptr<ReaderDocument> m_level_doc;
   SurfacePtr m_statistics_backdrop;
 
   // scripts
@@ -17,22 +17,46 @@
 #include "supertux/game_session_recorder.hpp"
 
 #include <fstream>
+#include <math.h>
 
 #include "control/input_manager.hpp"
 #include "math/random.hpp"
 #include "object/player.hpp"
+#include "physfs/ifile_stream.hpp"
+#include "supertux/demo_file.hpp"
 #include "supertux/game_session.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
+#include "supertux/level.hpp"
 #include "supertux/sector.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** The controls stored in demos, in the order of their bits */
+const Control DEMO_CONTROLS[] = {
+  Control::LEFT,
+  Control::RIGHT,
+  Control::UP,
+  Control::DOWN,
+  Control::JUMP,
+  Control::ACTION
+};
+
+/** How far the player may be off a keyframe before the demo counts
+    as desynced */
+const float KEYFRAME_TOLERANCE = 0.01f;
+
+} // namespace
+
 GameSessionRecorder::GameSessionRecorder() :
   m_capture_file(),
-  m_capture_demo_stream(),
-  m_playback_demo_stream(),
+  m_demo_writer(),
+  m_demo_reader(),
   m_demo_controller(),
-  m_playing(false)
+  m_playing(false),
+  m_seek_step(0),
+  m_desynced(false)
 {
 }
 
@@ -57,40 +81,42 @@ GameSessionRecorder::start_recording()
 void
 GameSessionRecorder::record_demo(const std::string& filename)
 {
-  m_capture_demo_stream.reset(new std::ofstream(filename.c_str()));
-  if (!m_capture_demo_stream->good()) {
+  // finish the previous run before its file is overwritten
+  m_demo_writer.reset();
+
+  std::unique_ptr<std::ostream> stream(new std::ofstream(filename.c_str(), std::ios::binary));
+  if (!stream->good()) {
     std::stringstream msg;
     msg << "Couldn't open demo file '" << filename << "' for writing.";
     throw std::runtime_error(msg.str());
   }
   m_capture_file = filename;
 
-  char buf[30];                            // save the seed in the demo file
-  snprintf(buf, sizeof(buf), "random_seed=%10d", g_config->random_seed);
-  for (int i = 0; i == 0 || buf[i-1]; i++)
-    m_capture_demo_stream->put(buf[i]);
+  m_demo_writer.reset(new DemoWriter(std::move(stream), g_config->random_seed, get_level_hash()));
 }
 
 int
 GameSessionRecorder::get_demo_random_seed(const std::string& filename) const
 {
-  std::unique_ptr<std::istream> test_stream(new std::ifstream(filename.c_str()));
+  std::unique_ptr<std::istream> test_stream(new std::ifstream(filename.c_str(), std::ios::binary));
   if (test_stream->good())
   {
-    char buf[30];                     // recall the seed from the demo file
-    int seed;
-
-    for (int i=0; i<30 && (i==0 || buf[i-1]); i++)
-      test_stream->get(buf[i]);
-
-    if (sscanf(buf, "random_seed=%10d", &seed) == 1)
+    try
     {
-      log_info << "Random seed " << seed << " from demo file" << std::endl;
-      return seed;
+      DemoReader reader(std::move(test_stream));
+      if (reader.has_random_seed())
+      {
+        log_info << "Random seed " << reader.get_random_seed() << " from demo file" << std::endl;
+        return reader.get_random_seed();
+      }
+      else
+      {
+        log_info << "Demo file contains no random number" << std::endl;
+      }
     }
-    else
+    catch (const std::exception& err)
     {
-      log_info << "Demo file contains no random number" << std::endl;
+      log_warning << "Couldn't read demo file '" << filename << "': " << err.what() << std::endl;
     }
   }
   return 0;
@@ -101,11 +127,13 @@ GameSessionRecorder::play_demo(const std::string& filename)
 {
   m_playing = true;
 
-  m_playback_demo_stream.reset();
+  m_demo_reader.reset();
   m_demo_controller.reset();
+  m_seek_step = 0;
+  m_desynced = false;
 
-  m_playback_demo_stream.reset(new std::ifstream(filename.c_str()));
-  if (!m_playback_demo_stream->good()) {
+  std::unique_ptr<std::istream> stream(new std::ifstream(filename.c_str(), std::ios::binary));
+  if (!stream->good()) {
     std::stringstream msg;
     msg << "Couldn't open demo file '" << filename << "' for reading.";
     throw std::runtime_error(msg.str());
@@ -113,13 +141,14 @@ GameSessionRecorder::play_demo(const std::string& filename)
 
   reset_demo_controller();
 
-  // skip over random seed, if it exists in the file
-  char buf[30];                            // ascii decimal seed
-  int seed;
-  for (int i=0; i<30 && (i==0 || buf[i-1]); i++)
-    m_playback_demo_stream->get(buf[i]);
-  if (sscanf(buf, "random_seed=%010d", &seed) != 1)
-    m_playback_demo_stream->seekg(0);     // old style w/o seed, restart at beg
+  m_demo_reader.reset(new DemoReader(std::move(stream)));
+
+  if (m_demo_reader->get_level_hash() != 0)
+  {
+    const uint32_t level_hash = get_level_hash();
+    if (level_hash != 0 && level_hash != m_demo_reader->get_level_hash())
+      log_warning << "Demo '" << filename << "' was recorded on a different version of this level" << std::endl;
+  }
 
   m_playing = false;
 }
@@ -136,42 +165,97 @@ GameSessionRecorder::reset_demo_controller()
   player.set_controller(m_demo_controller.get());
 }
 
+bool
+GameSessionRecorder::is_demo_finished() const
+{
+  return m_demo_reader && m_demo_reader->is_finished();
+}
+
+void
+GameSessionRecorder::seek_demo(uint32_t step)
+{
+  m_seek_step = step;
+}
+
+bool
+GameSessionRecorder::is_seeking_demo() const
+{
+  return m_demo_reader && !m_demo_reader->is_finished() &&
+         m_demo_reader->get_step() < m_seek_step;
+}
+
 void
 GameSessionRecorder::process_events()
 {
   // playback a demo?
-  if (m_playback_demo_stream != nullptr)
+  if (m_demo_reader != nullptr)
   {
     m_demo_controller->update();
 
-    char left, right, up, down, jump, action;
-
-    m_playback_demo_stream->get(left);
-    m_playback_demo_stream->get(right);
-    m_playback_demo_stream->get(up);
-    m_playback_demo_stream->get(down);
-    m_playback_demo_stream->get(jump);
-    m_playback_demo_stream->get(action);
-
-    m_demo_controller->press(Control::LEFT, left != 0);
-    m_demo_controller->press(Control::RIGHT, right != 0);
-    m_demo_controller->press(Control::UP, up != 0);
-    m_demo_controller->press(Control::DOWN,  down != 0);
-    m_demo_controller->press(Control::JUMP, jump != 0);
-    m_demo_controller->press(Control::ACTION,  action != 0);
+    uint8_t controls = 0;
+    if (m_demo_reader->read_step(controls))
+      check_keyframe();
+
+    for (size_t i = 0; i < sizeof(DEMO_CONTROLS) / sizeof(DEMO_CONTROLS[0]); ++i) {
+      m_demo_controller->press(DEMO_CONTROLS[i], (controls & (1 << i)) != 0);
+    }
+
+    if (m_seek_step != 0 && m_demo_reader->get_step() == m_seek_step) {
+      log_info << "Demo reached step " << m_seek_step << std::endl;
+    }
   }
 
   // save input for demo?
-  if (m_capture_demo_stream != nullptr)
+  if (m_demo_writer != nullptr)
   {
     Controller& controller = InputManager::current()->get_controller();
 
-    m_capture_demo_stream->put(controller.hold(Control::LEFT));
-    m_capture_demo_stream->put(controller.hold(Control::RIGHT));
-    m_capture_demo_stream->put(controller.hold(Control::UP));
-    m_capture_demo_stream->put(controller.hold(Control::DOWN));
-    m_capture_demo_stream->put(controller.hold(Control::JUMP));
-    m_capture_demo_stream->put(controller.hold(Control::ACTION));
+    uint8_t controls = 0;
+    for (size_t i = 0; i < sizeof(DEMO_CONTROLS) / sizeof(DEMO_CONTROLS[0]); ++i) {
+      if (controller.hold(DEMO_CONTROLS[i]))
+        controls = static_cast<uint8_t>(controls | (1 << i));
+    }
+
+    const Vector player_pos = GameSession::current()->get_current_sector().get_player().get_pos();
+    m_demo_writer->write_step(controls, player_pos);
+  }
+}
+
+uint32_t
+GameSessionRecorder::get_level_hash() const
+{
+  auto game_session = GameSession::current();
+  if (!game_session)
+    return 0;
+
+  const std::string& filename = game_session->get_current_level().m_filename;
+  try
+  {
+    IFileStream stream(filename);
+    return demo::hash_level(stream);
+  }
+  catch (const std::exception& err)
+  {
+    log_debug << "Couldn't hash level '" << filename << "': " << err.what() << std::endl;
+    return 0;
+  }
+}
+
+void
+GameSessionRecorder::check_keyframe()
+{
+  const auto* keyframe = m_demo_reader->get_keyframe();
+  if (!keyframe || m_desynced)
+    return;
+
+  const Vector player_pos = GameSession::current()->get_current_sector().get_player().get_pos();
+  if (fabsf(player_pos.x - keyframe->player_pos.x) > KEYFRAME_TOLERANCE ||
+      fabsf(player_pos.y - keyframe->player_pos.y) > KEYFRAME_TOLERANCE)
+  {
+    const uint32_t previous = keyframe->step >= demo::KEYFRAME_INTERVAL ? keyframe->step - demo::KEYFRAME_INTERVAL : 0;
+    log_warning << "Demo desynced between steps " << previous << " and " << keyframe->step
+                << ": player at " << player_pos << " instead of " << keyframe->player_pos << std::endl;
+    m_desynced = true;
   }
 }
 
@@ -18,10 +18,14 @@
 #define HEADER_SUPERTUX_SUPERTUX_GAME_SESSION_RECORDER_HPP
 
 #include <memory>
+#include <stdint.h>
 #include <string>
 
 #include "control/codecontroller.hpp"
 
+class DemoReader;
+class DemoWriter;
+
 class GameSessionRecorder
 {
 public:
@@ -40,15 +44,31 @@ public:
 
   bool is_playing_demo() const { return m_playing; }
 
+  /** Returns true once the demo being played back ran out of input */
+  bool is_demo_finished() const;
+
+  /** Makes the ScreenManager run the game steps without drawing
+      until the demo being played back reached @c step */
+  void seek_demo(uint32_t step);
+  bool is_seeking_demo() const;
+
 private:
-  void capture_demo_step();
+  /** Hash of the level file of the current GameSession, 0 if it
+      can't be read */
+  uint32_t get_level_hash() const;
+
+  /** Warns about the first keyframe of the demo that the player
+      doesn't match */
+  void check_keyframe();
 
 private:
   std::string m_capture_file;
-  std::unique_ptr<std::ostream> m_capture_demo_stream;
-  std::unique_ptr<std::istream> m_playback_demo_stream;
+  std::unique_ptr<DemoWriter> m_demo_writer;
+  std::unique_ptr<DemoReader> m_demo_reader;
   std::unique_ptr<CodeController> m_demo_controller;
   bool m_playing;
+  uint32_t m_seek_step;
+  bool m_desynced;
 
 private:
   GameSessionRecorder(const GameSessionRecorder&) = delete;
@@ -36,6 +36,8 @@ Config::Config() :
   use_fullscreen(false),
   video(VideoSystem::VIDEO_AUTO),
   try_vsync(true),
+  texture_atlas(false),
+  surface_cache_size(64),
   show_fps(false),
   show_player_pos(false),
   show_controller(false),
@@ -62,6 +64,7 @@ Config::Config() :
   discord_hide_editor(false),
 #endif
   editor_autosave_frequency(5),
+  editor_compress_tiles(false),
   repository_url()
 {
 }
@@ -95,6 +98,7 @@ Config::load()
   }
 
   config_mapping.get("editor_autosave_frequency", editor_autosave_frequency);
+  config_mapping.get("editor_compress_tiles", editor_compress_tiles);
 
   EditorOverlayWidget::autotile_help = !developer_mode;
 
@@ -117,6 +121,8 @@ Config::load()
     config_video_mapping->get("video", video_string);
     video = VideoSystem::get_video_system(video_string);
     config_video_mapping->get("vsync", try_vsync);
+    config_video_mapping->get("texture_atlas", texture_atlas);
+    config_video_mapping->get("surface_cache_size", surface_cache_size);
 
     config_video_mapping->get("fullscreen_width",  fullscreen_size.width);
     config_video_mapping->get("fullscreen_height", fullscreen_size.height);
@@ -214,6 +220,7 @@ Config::save()
   writer.end_list("integrations");
 
   writer.write("editor_autosave_frequency", editor_autosave_frequency);
+  writer.write("editor_compress_tiles", editor_compress_tiles);
 
   if (is_christmas()) {
     writer.write("christmas", christmas_mode);
@@ -231,6 +238,8 @@ Config::save()
     writer.write("video", VideoSystem::get_video_string(video));
   }
   writer.write("vsync", try_vsync);
+  writer.write("texture_atlas", texture_atlas);
+  writer.write("surface_cache_size", surface_cache_size);
 
   writer.write("fullscreen_width",  fullscreen_size.width);
   writer.write("fullscreen_height", fullscreen_size.height);
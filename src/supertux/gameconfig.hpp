@@ -59,6 +59,14 @@ public:
   bool use_fullscreen;
   VideoSystem::Enum video;
   bool try_vsync;
+
+  /** pack small images into shared textures, see TextureAtlas */
+  bool texture_atlas;
+
+  /** Megabytes of decoded images TextureManager keeps around for
+      cutting textures out of them, 0 for no limit */
+  int surface_cache_size;
+
   bool show_fps;
   bool show_player_pos;
   bool show_controller;
@@ -105,6 +113,9 @@ public:
 
   int editor_autosave_frequency;
 
+  /** Save tilemaps with TileEncoding instead of as plain numbers */
+  bool editor_compress_tiles;
+
   std::string repository_url;
 
   bool is_christmas() const {
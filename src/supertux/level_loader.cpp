@@ -0,0 +1,255 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/level_loader.hpp"
+
+#include <algorithm>
+#include <physfs.h>
+#include <sexp/value.hpp>
+#include <sstream>
+
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/string_util.hpp"
+#include "video/sdl_surface.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+/** Upper limit for the number of threads decoding images */
+const unsigned MAX_THREADS = 4;
+
+/** Share of the progress taken by reading the level file itself */
+const float READ_PROGRESS = 0.1f;
+
+bool is_image(const std::string& filename)
+{
+  return (StringUtil::has_suffix(filename, ".png") ||
+          StringUtil::has_suffix(filename, ".jpg"));
+}
+
+/** Files which may refer to more images */
+bool is_image_list(const std::string& filename)
+{
+  return (StringUtil::has_suffix(filename, ".sprite") ||
+          StringUtil::has_suffix(filename, ".surface") ||
+          StringUtil::has_suffix(filename, ".strf"));
+}
+
+/** File names are relative to the file they are given in or to the
+    data directory. Returns an empty string if neither exists. */
+std::string resolve(const std::string& filename, const std::string& directory)
+{
+  const std::string relative = FileSystem::normalize(FileSystem::join(directory, filename));
+  if (PHYSFS_exists(relative.c_str()))
+    return relative;
+
+  const std::string absolute = FileSystem::normalize(filename);
+  if (PHYSFS_exists(absolute.c_str()))
+    return absolute;
+
+  return {};
+}
+
+} // namespace
+
+LevelLoader::LevelLoader(const std::string& filename, std::set<std::string> loaded) :
+  m_filename(filename),
+  m_loaded(std::move(loaded)),
+  m_image_lists(),
+  m_mutex(),
+  m_cond(),
+  m_document(),
+  m_error(),
+  m_images_ready(false),
+  m_images(),
+  m_next_image(0),
+  m_decoded_count(0),
+  m_decoded(),
+  m_running(0),
+  m_cancel(false),
+  m_threads()
+{
+  const unsigned count = std::max(1u, std::min(MAX_THREADS, std::thread::hardware_concurrency()));
+
+  m_running = static_cast<int>(count);
+  m_threads.emplace_back([this]{
+      read_level();
+      decode_images();
+    });
+  for (unsigned i = 1; i < count; ++i) {
+    m_threads.emplace_back([this]{ decode_images(); });
+  }
+}
+
+LevelLoader::~LevelLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancel = true;
+  }
+  m_cond.notify_all();
+
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+float
+LevelLoader::get_progress() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_images_ready)
+    return 0.0f;
+
+  if (m_images.empty())
+    return 1.0f;
+
+  return READ_PROGRESS + (1.0f - READ_PROGRESS) *
+    static_cast<float>(m_decoded_count) / static_cast<float>(m_images.size());
+}
+
+bool
+LevelLoader::wait(std::chrono::milliseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return m_cond.wait_for(lock, timeout, [this]{ return m_running == 0; });
+}
+
+std::unique_ptr<ReaderDocument>
+LevelLoader::finish()
+{
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+  m_threads.clear();
+
+  if (m_error)
+    std::rethrow_exception(m_error);
+
+  for (auto& image : m_decoded) {
+    TextureManager::current()->preload(image.first, std::move(image.second));
+  }
+  m_decoded.clear();
+
+  log_debug << "preloaded " << m_images.size() << " images for " << m_filename << std::endl;
+
+  return std::move(m_document);
+}
+
+void
+LevelLoader::read_level()
+{
+  std::unique_ptr<ReaderDocument> document;
+  std::set<std::string> images;
+  std::exception_ptr error;
+
+  try
+  {
+    document = std::make_unique<ReaderDocument>(ReaderDocument::from_file(m_filename));
+    collect_images(document->get_sexp(), document->get_directory(), true, images);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_document = std::move(document);
+    m_error = error;
+    for (const auto& image : images) {
+      if (m_loaded.find(image) == m_loaded.end()) {
+        m_images.push_back(image);
+      }
+    }
+    m_images_ready = true;
+  }
+  m_cond.notify_all();
+}
+
+void
+LevelLoader::decode_images()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this]{ return m_images_ready || m_cancel; });
+
+  while (!m_cancel && m_next_image < m_images.size())
+  {
+    const std::string filename = m_images[m_next_image];
+    m_next_image += 1;
+
+    lock.unlock();
+    SDLSurfacePtr image = SDLSurface::from_file(filename);
+    lock.lock();
+
+    // failures are left for the TextureManager to report
+    if (image) {
+      m_decoded.emplace_back(filename, std::move(image));
+    }
+    m_decoded_count += 1;
+  }
+
+  m_running -= 1;
+  if (m_running == 0) {
+    m_cond.notify_all();
+  }
+}
+
+void
+LevelLoader::collect_images(const sexp::Value& sx, const std::string& directory, bool recurse,
+                            std::set<std::string>& images)
+{
+  if (sx.is_array())
+  {
+    for (const auto& item : sx.as_array()) {
+      collect_images(item, directory, recurse, images);
+    }
+  }
+  else if (sx.is_string())
+  {
+    const std::string& text = sx.as_string();
+    if (is_image(text))
+    {
+      const std::string filename = resolve(text, directory);
+      if (!filename.empty()) {
+        images.insert(filename);
+      }
+    }
+    else if (recurse && is_image_list(text))
+    {
+      const std::string filename = resolve(text, directory);
+      if (filename.empty() || !m_image_lists.insert(filename).second)
+        return;
+
+      try
+      {
+        const ReaderDocument doc = ReaderDocument::from_file(filename);
+        collect_images(doc.get_sexp(), doc.get_directory(), false, images);
+      }
+      catch (const std::exception& err)
+      {
+        // the error shows up again when the level is created
+        log_debug << "Couldn't read '" << filename << "': " << err.what() << std::endl;
+      }
+    }
+  }
+}
+
+/* EOF */
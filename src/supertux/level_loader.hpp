@@ -0,0 +1,106 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADER_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_LOADER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "video/sdl_surface_ptr.hpp"
+
+class ReaderDocument;
+
+namespace sexp {
+class Value;
+} // namespace sexp
+
+/** Reads a level file and decodes the images it refers to on worker
+    threads, so that GameSession only has to create the objects and
+    upload the textures on the main thread. Images are found by
+    looking for file names in the level and in the sprite, surface
+    and tileset files it refers to. */
+class LevelLoader final
+{
+public:
+  /** Starts reading @c filename in the background. The images listed
+      in @c loaded are not decoded again. */
+  LevelLoader(const std::string& filename, std::set<std::string> loaded);
+  ~LevelLoader();
+
+  /** Fraction of the background work that is done, from 0 to 1 */
+  float get_progress() const;
+
+  /** Waits at most @c timeout for the background work, returns true
+      once it is done */
+  bool wait(std::chrono::milliseconds timeout);
+
+  /** Waits for the background work, hands the decoded images to the
+      TextureManager and returns the level file. Rethrows the errors
+      from reading the level file. */
+  std::unique_ptr<ReaderDocument> finish();
+
+private:
+  void read_level();
+  void decode_images();
+
+  /** Collects the image files referenced in @c sx. Files that include
+      further images are read as well if @c recurse is set. */
+  void collect_images(const sexp::Value& sx, const std::string& directory, bool recurse,
+                      std::set<std::string>& images);
+
+private:
+  std::string m_filename;
+  std::set<std::string> m_loaded;
+
+  /** Sprite, surface and tileset files read so far, only used by the
+      thread running read_level() */
+  std::set<std::string> m_image_lists;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cond;
+
+  std::unique_ptr<ReaderDocument> m_document;
+  std::exception_ptr m_error;
+
+  /** Set once the image list is complete */
+  bool m_images_ready;
+  std::vector<std::string> m_images;
+  size_t m_next_image;
+  size_t m_decoded_count;
+  std::vector<std::pair<std::string, SDLSurfacePtr> > m_decoded;
+
+  int m_running;
+  bool m_cancel;
+  std::vector<std::thread> m_threads;
+
+private:
+  LevelLoader(const LevelLoader&) = delete;
+  LevelLoader& operator=(const LevelLoader&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,304 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/level_metadata_cache.hpp"
+
+#include <physfs.h>
+#include <sexp/value.hpp>
+#include <sstream>
+
+#include "physfs/util.hpp"
+#include "supertux/level.hpp"
+#include "util/gettext.hpp"
+#include "util/log.hpp"
+#include "util/reader.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_iterator.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/writer.hpp"
+
+namespace {
+
+const int CACHE_VERSION = 1;
+
+} // namespace
+
+LevelMetadata::LevelMetadata() :
+  name(),
+  target_time(0.0f),
+  author(),
+  license(),
+  total_coins(-1),
+  total_badguys(-1),
+  total_secrets(-1)
+{
+}
+
+LevelMetadataCache::LevelMetadataCache(const std::string& filename) :
+  m_filename(filename),
+  m_entries(),
+  m_dirty(false),
+  m_hits(0),
+  m_misses(0)
+{
+  load();
+}
+
+LevelMetadataCache::~LevelMetadataCache()
+{
+  save();
+}
+
+LevelMetadata
+LevelMetadataCache::get(const std::string& filename)
+{
+  const std::string key = physfsutil::realpath(filename);
+
+  int64_t mtime;
+  int64_t size;
+  Entry* entry = find(key, mtime, size);
+  if (entry)
+  {
+    m_hits += 1;
+  }
+  else
+  {
+    m_misses += 1;
+    entry = &(m_entries[key] = read_level(key, mtime, size));
+    m_dirty = true;
+  }
+
+  LevelMetadata metadata = entry->metadata;
+  if (entry->name_translatable)
+  {
+    register_translation_directory(filename);
+    metadata.name = _(metadata.name);
+  }
+  return metadata;
+}
+
+void
+LevelMetadataCache::update(const std::string& filename, const Level& level)
+{
+  int64_t mtime;
+  int64_t size;
+  Entry* entry;
+  try
+  {
+    entry = find(physfsutil::realpath(filename), mtime, size);
+  }
+  catch (const std::exception& err)
+  {
+    log_debug << err.what() << std::endl;
+    return;
+  }
+
+  // Level only has the translated name, so levels without an entry
+  // are left for get() to read
+  if (!entry)
+    return;
+
+  const int total_coins = level.get_total_coins();
+  const int total_badguys = level.get_total_badguys();
+  const int total_secrets = level.get_total_secrets();
+
+  LevelMetadata& metadata = entry->metadata;
+  if (metadata.total_coins != total_coins ||
+      metadata.total_badguys != total_badguys ||
+      metadata.total_secrets != total_secrets)
+  {
+    metadata.total_coins = total_coins;
+    metadata.total_badguys = total_badguys;
+    metadata.total_secrets = total_secrets;
+    m_dirty = true;
+  }
+}
+
+LevelMetadataCache::Entry*
+LevelMetadataCache::find(const std::string& filename, int64_t& mtime, int64_t& size)
+{
+  PHYSFS_Stat statbuf;
+  if (!PHYSFS_stat(filename.c_str(), &statbuf))
+  {
+    std::ostringstream msg;
+    msg << "Couldn't find level '" << filename << "'";
+    throw std::runtime_error(msg.str());
+  }
+
+  mtime = statbuf.modtime;
+  size = statbuf.filesize;
+
+  auto it = m_entries.find(filename);
+  if (it == m_entries.end() ||
+      it->second.mtime != mtime ||
+      it->second.size != size)
+  {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+LevelMetadataCache::Entry
+LevelMetadataCache::read_level(const std::string& filename, int64_t mtime, int64_t size) const
+{
+  auto doc = ReaderDocument::from_file(filename);
+  auto root = doc.get_root();
+  if (root.get_name() != "supertux-level")
+  {
+    std::ostringstream msg;
+    msg << "'" << filename << "' is not a supertux-level file";
+    throw std::runtime_error(msg.str());
+  }
+
+  Entry entry;
+  entry.mtime = mtime;
+  entry.size = size;
+  entry.name_translatable = false;
+
+  auto mapping = root.get_mapping();
+
+  // keep the untranslated name, so that the cache stays valid when
+  // the language changes
+  sexp::Value name;
+  if (mapping.get("name", name))
+  {
+    if (name.is_string())
+    {
+      entry.metadata.name = name.as_string();
+    }
+    else if (name.is_array() &&
+             name.as_array().size() == 2 &&
+             name.as_array()[1].is_string())
+    {
+      entry.metadata.name = name.as_array()[1].as_string();
+      entry.name_translatable = true;
+    }
+  }
+
+  mapping.get("target-time", entry.metadata.target_time);
+  mapping.get("author", entry.metadata.author);
+  mapping.get("license", entry.metadata.license);
+
+  return entry;
+}
+
+void
+LevelMetadataCache::load()
+{
+  if (!PHYSFS_exists(m_filename.c_str()))
+    return;
+
+  try
+  {
+    auto doc = ReaderDocument::from_file(m_filename);
+    auto root = doc.get_root();
+    if (root.get_name() != "supertux-level-metadata-cache")
+      throw std::runtime_error("file is not a supertux-level-metadata-cache file");
+
+    auto mapping = root.get_mapping();
+
+    int version = 0;
+    mapping.get("version", version);
+    if (version != CACHE_VERSION)
+    {
+      log_info << "Ignoring level metadata cache of version " << version << std::endl;
+      return;
+    }
+
+    auto iter = mapping.get_iter();
+    while (iter.next())
+    {
+      if (iter.get_key() != "level")
+        continue;
+
+      auto level = iter.as_mapping();
+
+      std::string path;
+      std::string mtime;
+      std::string size;
+      if (!level.get("path", path) ||
+          !level.get("mtime", mtime) ||
+          !level.get("size", size))
+        continue;
+
+      Entry entry;
+      entry.mtime = std::stoll(mtime);
+      entry.size = std::stoll(size);
+      entry.name_translatable = false;
+
+      level.get("name", entry.metadata.name);
+      level.get("name-translatable", entry.name_translatable);
+      level.get("target-time", entry.metadata.target_time);
+      level.get("author", entry.metadata.author);
+      level.get("license", entry.metadata.license);
+      level.get("total-coins", entry.metadata.total_coins);
+      level.get("total-badguys", entry.metadata.total_badguys);
+      level.get("total-secrets", entry.metadata.total_secrets);
+
+      m_entries[path] = entry;
+    }
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "Couldn't read level metadata cache '" << m_filename << "': " << err.what() << std::endl;
+    m_entries.clear();
+  }
+}
+
+void
+LevelMetadataCache::save()
+{
+  if (!m_dirty)
+    return;
+
+  try
+  {
+    Writer writer(m_filename);
+
+    writer.start_list("supertux-level-metadata-cache");
+    writer.write("version", CACHE_VERSION);
+
+    for (const auto& it : m_entries)
+    {
+      const Entry& entry = it.second;
+
+      writer.start_list("level");
+      writer.write("path", it.first);
+      writer.write("mtime", std::to_string(entry.mtime));
+      writer.write("size", std::to_string(entry.size));
+      writer.write("name", entry.metadata.name);
+      writer.write("name-translatable", entry.name_translatable);
+      writer.write("target-time", entry.metadata.target_time);
+      writer.write("author", entry.metadata.author);
+      writer.write("license", entry.metadata.license);
+      writer.write("total-coins", entry.metadata.total_coins);
+      writer.write("total-badguys", entry.metadata.total_badguys);
+      writer.write("total-secrets", entry.metadata.total_secrets);
+      writer.end_list("level");
+    }
+
+    writer.end_list("supertux-level-metadata-cache");
+    m_dirty = false;
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "Couldn't write level metadata cache '" << m_filename << "': " << err.what() << std::endl;
+  }
+}
+
+/* EOF */
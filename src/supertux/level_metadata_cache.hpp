@@ -0,0 +1,106 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_METADATA_CACHE_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_METADATA_CACHE_HPP
+
+#include <map>
+#include <stdint.h>
+#include <string>
+
+#include "util/currenton.hpp"
+
+class Level;
+
+/** The information about a level shown in worldmaps and level
+    menus */
+struct LevelMetadata
+{
+  LevelMetadata();
+
+  std::string name;
+  float target_time;
+  std::string author;
+  std::string license;
+
+  /** -1 until the level was loaded in full once */
+  int total_coins;
+  int total_badguys;
+  int total_secrets;
+};
+
+/** Keeps the LevelMetadata of the levels seen so far in a file in
+    the user directory, so that worldmaps and level menus don't have
+    to read every level file each time they are opened. Entries are
+    keyed by path and dropped when the size or modification time of
+    the file changes. */
+class LevelMetadataCache final : public Currenton<LevelMetadataCache>
+{
+public:
+  LevelMetadataCache(const std::string& filename = "level-metadata.cache");
+  ~LevelMetadataCache();
+
+  /** Returns the metadata of the level @c filename, reading the file
+      if it isn't cached or changed since. Throws an exception if the
+      file can't be read or isn't a level. */
+  LevelMetadata get(const std::string& filename);
+
+  /** Records the coin, badguy and secret totals of a level that was
+      loaded in full. Does nothing for levels get() wasn't called for,
+      as @c level only knows its translated name. */
+  void update(const std::string& filename, const Level& level);
+
+  /** Writes the cache file if anything changed */
+  void save();
+
+  int get_hits() const { return m_hits; }
+  int get_misses() const { return m_misses; }
+
+private:
+  struct Entry
+  {
+    int64_t mtime;
+    int64_t size;
+
+    /** the name as written in the level, before translation */
+    LevelMetadata metadata;
+    bool name_translatable;
+  };
+
+private:
+  void load();
+  Entry read_level(const std::string& filename, int64_t mtime, int64_t size) const;
+
+  /** Returns the cache entry for @c filename if it is still valid */
+  Entry* find(const std::string& filename, int64_t& mtime, int64_t& size);
+
+private:
+  std::string m_filename;
+  std::map<std::string, Entry> m_entries;
+  bool m_dirty;
+
+  int m_hits;
+  int m_misses;
+
+private:
+  LevelMetadataCache(const LevelMetadataCache&) = delete;
+  LevelMetadataCache& operator=(const LevelMetadataCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -20,6 +20,7 @@
 #include <sstream>
 
 #include "supertux/level.hpp"
+#include "supertux/level_metadata_cache.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/sector_parser.hpp"
 #include "util/log.hpp"
@@ -32,6 +33,9 @@ LevelParser::get_level_name(const std::string& filename)
 {
   try
   {
+    if (LevelMetadataCache::current())
+      return LevelMetadataCache::current()->get(filename).name;
+
     register_translation_directory(filename);
     auto doc = ReaderDocument::from_file(filename);
     auto root = doc.get_root();
@@ -71,6 +75,15 @@ LevelParser::from_file(const std::string& filename, bool worldmap, bool editable
   return level;
 }
 
+std::unique_ptr<Level>
+LevelParser::from_document(const ReaderDocument& doc, bool worldmap, bool editable)
+{
+  auto level = std::make_unique<Level>(worldmap);
+  LevelParser parser(*level, worldmap, editable);
+  parser.load_document(doc);
+  return level;
+}
+
 std::unique_ptr<Level>
 LevelParser::from_nothing(const std::string& basedir)
 {
@@ -136,6 +149,7 @@ LevelParser::load(const std::string& filepath)
   try {
     auto doc = ReaderDocument::from_file(filepath);
     load(doc);
+    update_metadata_cache();
   } catch(std::exception& e) {
     std::stringstream msg;
     msg << "Problem when reading level '" << filepath << "': " << e.what();
@@ -143,6 +157,21 @@ LevelParser::load(const std::string& filepath)
   }
 }
 
+void
+LevelParser::load_document(const ReaderDocument& doc)
+{
+  m_level.m_filename = doc.get_filename();
+  register_translation_directory(doc.get_filename());
+  try {
+    load(doc);
+    update_metadata_cache();
+  } catch(std::exception& e) {
+    std::stringstream msg;
+    msg << "Problem when reading level '" << doc.get_filename() << "': " << e.what();
+    throw std::runtime_error(msg.str());
+  }
+}
+
 void
 LevelParser::load(const ReaderDocument& doc)
 {
@@ -189,6 +218,15 @@ LevelParser::load(const ReaderDocument& doc)
   m_level.m_stats.init(m_level);
 }
 
+void
+LevelParser::update_metadata_cache()
+{
+  if (m_worldmap || m_editable || !LevelMetadataCache::current())
+    return;
+
+  LevelMetadataCache::current()->update(m_level.m_filename, m_level);
+}
+
 void
 LevelParser::load_old_format(const ReaderMapping& reader)
 {
@@ -29,6 +29,10 @@ class LevelParser final
 public:
   static std::unique_ptr<Level> from_stream(std::istream& stream, const std::string& context, bool worldmap, bool editable);
   static std::unique_ptr<Level> from_file(const std::string& filename, bool worldmap, bool editable);
+
+  /** Same as from_file(), for a level file that was read already,
+      e.g. by a LevelLoader */
+  static std::unique_ptr<Level> from_document(const ReaderDocument& doc, bool worldmap, bool editable);
   static std::unique_ptr<Level> from_nothing(const std::string& basedir);
   static std::unique_ptr<Level> from_nothing_worldmap(const std::string& basedir, const std::string& name);
 
@@ -40,7 +44,12 @@ private:
   void load(const ReaderDocument& doc);
   void load(std::istream& stream, const std::string& context);
   void load(const std::string& filepath);
+  void load_document(const ReaderDocument& doc);
   void load_old_format(const ReaderMapping& reader);
+
+  /** Records the totals of a fully loaded level in the
+      LevelMetadataCache */
+  void update_metadata_cache();
   void create(const std::string& filepath, const std::string& levelname);
 
 private:
@@ -51,6 +51,7 @@ extern "C" {
 #include "sdk/integration.hpp"
 #include "sprite/sprite_data.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/command_line_arguments.hpp"
 #include "supertux/console.hpp"
 #include "supertux/error_handler.hpp"
@@ -59,6 +60,7 @@ extern "C" {
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_metadata_cache.hpp"
 #include "supertux/level_parser.hpp"
 #include "supertux/player_status.hpp"
 #include "supertux/resources.hpp"
@@ -70,6 +72,7 @@ extern "C" {
 #include "supertux/tile_manager.hpp"
 #include "supertux/title_screen.hpp"
 #include "supertux/world.hpp"
+#include "util/document_cache.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
 #include "util/string_util.hpp"
@@ -398,8 +401,18 @@ Main::resave(const std::string& input_filename, const std::string& output_filena
 void
 Main::launch_game(const CommandLineArguments& args)
 {
+  const bool benchmark = args.benchmark && *args.benchmark;
+  if (benchmark)
+  {
+    // benchmarks need to run on machines without display or sound
+    // card, unless told otherwise
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+  }
+
   SDLSubsystem sdl_subsystem;
   ConsoleBuffer console_buffer;
+  DocumentCache document_cache;
 
   s_timelog.log("controller");
   InputManager input_manager(g_config->keyboard_config, g_config->joystick_config);
@@ -407,7 +420,7 @@ Main::launch_game(const CommandLineArguments& args)
   s_timelog.log("commandline");
 
   auto video = g_config->video;
-  if (args.resave && *args.resave) {
+  if ((args.resave && *args.resave) || benchmark) {
     if (args.video) {
       video = *args.video;
     } else {
@@ -426,6 +439,10 @@ Main::launch_game(const CommandLineArguments& args)
   sound_manager.enable_music(g_config->music_enabled);
   sound_manager.set_sound_volume(g_config->sound_volume);
   sound_manager.set_music_volume(g_config->music_volume);
+  if (benchmark) {
+    sound_manager.enable_sound(false);
+    sound_manager.enable_music(false);
+  }
 
   s_timelog.log("scripting");
   SquirrelVirtualMachine scripting(g_config->enable_script_debugger);
@@ -434,6 +451,7 @@ Main::launch_game(const CommandLineArguments& args)
   TileManager tile_manager;
   SpriteManager sprite_manager;
   Resources resources;
+  LevelMetadataCache level_metadata_cache;
 
   s_timelog.log("integrations");
   Integration::setup();
@@ -443,7 +461,7 @@ Main::launch_game(const CommandLineArguments& args)
 
   Console console(console_buffer);
 
-  s_timelog.log(nullptr);
+  s_timelog.log("first screen");
 
   const auto default_savegame = std::make_unique<Savegame>(std::string());
 
@@ -517,7 +535,11 @@ Main::launch_game(const CommandLineArguments& args)
         }
 
         if (!g_config->start_demo.empty())
+        {
           session->play_demo(g_config->start_demo);
+          if (args.demo_seek)
+            session->seek_demo(static_cast<uint32_t>(*args.demo_seek));
+        }
 
         if (!g_config->record_demo.empty())
           session->record_demo(g_config->record_demo);
@@ -537,7 +559,19 @@ Main::launch_game(const CommandLineArguments& args)
     }
   }
 
-  screen_manager.run();
+  s_timelog.log(nullptr);
+  document_cache.print_stats();
+
+  if (benchmark)
+  {
+    Benchmark results;
+    screen_manager.run_benchmark(results, args.benchmark_draw && *args.benchmark_draw);
+    results.print(std::cout);
+  }
+  else
+  {
+    screen_manager.run();
+  }
 }
 
 int
@@ -0,0 +1,181 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/memory_usage.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "audio/sound_manager.hpp"
+#include "sprite/sprite_manager.hpp"
+#include "video/texture_manager.hpp"
+#include "video/ttf_surface_manager.hpp"
+
+namespace {
+
+void write_json_string(std::ostream& out, const std::string& str)
+{
+  out << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(c) << std::dec << std::setfill(' ');
+    }
+    else
+    {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+std::vector<MemoryUsage::Entry> largest(std::vector<MemoryUsage::Entry> entries, size_t count)
+{
+  std::sort(entries.begin(), entries.end(),
+            [](const MemoryUsage::Entry& lhs, const MemoryUsage::Entry& rhs) {
+              return lhs.bytes > rhs.bytes;
+            });
+  if (entries.size() > count)
+    entries.resize(count);
+  return entries;
+}
+
+} // namespace
+
+MemoryUsage
+MemoryUsage::collect(bool entries)
+{
+  MemoryUsage usage(entries);
+  if (TextureManager::current()) {
+    TextureManager::current()->get_memory_usage(usage);
+  }
+  if (TTFSurfaceManager::current()) {
+    TTFSurfaceManager::current()->get_memory_usage(usage);
+  }
+  if (SpriteManager::current()) {
+    SpriteManager::current()->get_memory_usage(usage);
+  }
+  if (SoundManager::current()) {
+    SoundManager::current()->get_memory_usage(usage);
+  }
+  return usage;
+}
+
+MemoryUsage::MemoryUsage(bool entries) :
+  m_entries(entries),
+  m_categories()
+{
+}
+
+void
+MemoryUsage::add_category(const std::string& name, const std::string& location, size_t bytes, size_t count)
+{
+  m_categories.push_back({ name, location, bytes, count, {} });
+}
+
+void
+MemoryUsage::add_entry(const std::string& name, size_t bytes)
+{
+  if (!m_entries || m_categories.empty())
+    return;
+
+  m_categories.back().entries.push_back({ name, bytes });
+}
+
+size_t
+MemoryUsage::get_total() const
+{
+  size_t total = 0;
+  for (const auto& category : m_categories) {
+    total += category.bytes;
+  }
+  return total;
+}
+
+std::vector<MemoryUsage::Entry>
+MemoryUsage::get_top(size_t count) const
+{
+  std::vector<Entry> entries;
+  for (const auto& category : m_categories) {
+    for (const auto& entry : category.entries) {
+      entries.push_back({ category.name + ": " + entry.name, entry.bytes });
+    }
+  }
+  return largest(std::move(entries), count);
+}
+
+void
+MemoryUsage::print(std::ostream& out, size_t count) const
+{
+  const auto old_flags = out.flags();
+
+  out << std::left << std::setw(12) << "category" << std::setw(8) << "where"
+      << std::right << std::setw(10) << "count" << std::setw(14) << "KiB" << '\n';
+  for (const auto& category : m_categories)
+  {
+    out << std::left << std::setw(12) << category.name << std::setw(8) << category.location
+        << std::right << std::setw(10) << category.count
+        << std::setw(14) << category.bytes / 1024 << '\n';
+  }
+  out << std::left << std::setw(30) << "total"
+      << std::right << std::setw(14) << get_total() / 1024 << '\n';
+
+  if (m_entries && count > 0)
+  {
+    out << "Largest " << count << ":\n";
+    for (const auto& entry : get_top(count))
+    {
+      out << std::right << std::setw(10) << entry.bytes / 1024 << " KiB  " << entry.name << '\n';
+    }
+  }
+  out << std::flush;
+
+  out.flags(old_flags);
+}
+
+void
+MemoryUsage::write_json(std::ostream& out, size_t count) const
+{
+  out << "{\"total\":" << get_total() << ",\"categories\":[";
+  for (size_t i = 0; i < m_categories.size(); ++i)
+  {
+    const Category& category = m_categories[i];
+    out << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    write_json_string(out, category.name);
+    out << ",\"location\":";
+    write_json_string(out, category.location);
+    out << ",\"bytes\":" << category.bytes << ",\"count\":" << category.count << ",\"largest\":[";
+
+    const auto entries = largest(category.entries, count);
+    for (size_t j = 0; j < entries.size(); ++j)
+    {
+      out << (j == 0 ? "" : ",") << "{\"name\":";
+      write_json_string(out, entries[j].name);
+      out << ",\"bytes\":" << entries[j].bytes << "}";
+    }
+    out << "]}";
+  }
+  out << "\n]}" << std::endl;
+}
+
+/* EOF */
@@ -0,0 +1,90 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_MEMORY_USAGE_HPP
+#define HEADER_SUPERTUX_SUPERTUX_MEMORY_USAGE_HPP
+
+#include <ostream>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/** The bytes held by the resource managers, TextureManager,
+    SoundManager, TTFSurfaceManager and SpriteManager, which keep
+    count of them as they load and free things. Sizes are those of
+    the pixel and sample data, plus an estimate for the bookkeeping
+    where that is all there is, as with sprites. */
+class MemoryUsage final
+{
+public:
+  struct Entry
+  {
+    std::string name;
+    size_t bytes;
+  };
+
+  struct Category
+  {
+    std::string name;
+
+    /** Where the bytes live, "gpu", "cpu" or "audio" */
+    std::string location;
+
+    size_t bytes;
+    size_t count;
+
+    /** Only filled when the entries were asked for */
+    std::vector<Entry> entries;
+  };
+
+public:
+  /** Asks the managers that currently exist. Without @c entries
+      only the totals are collected, which is cheap enough to do
+      every frame. */
+  static MemoryUsage collect(bool entries);
+
+public:
+  explicit MemoryUsage(bool entries);
+
+  bool wants_entries() const { return m_entries; }
+
+  /** Starts a category, the entries added next belong to it */
+  void add_category(const std::string& name, const std::string& location, size_t bytes, size_t count);
+  void add_entry(const std::string& name, size_t bytes);
+
+  const std::vector<Category>& get_categories() const { return m_categories; }
+  size_t get_total() const;
+
+  /** Returns the @c count largest entries of all categories, largest
+      first, with the category prepended to their names */
+  std::vector<Entry> get_top(size_t count) const;
+
+  /** Prints the totals and the @c count largest entries */
+  void print(std::ostream& out, size_t count) const;
+
+  /** Writes the totals and the @c count largest entries of each
+      category as JSON */
+  void write_json(std::ostream& out, size_t count) const;
+
+private:
+  bool m_entries;
+  std::vector<Category> m_categories;
+};
+
+#endif
+
+/* EOF */
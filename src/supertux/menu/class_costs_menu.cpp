@@ -0,0 +1,82 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/menu/class_costs_menu.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+
+#include "gui/menu_item.hpp"
+#include "supertux/class_cost_stats.hpp"
+#include "util/gettext.hpp"
+
+namespace {
+
+const size_t MAX_CLASSES = 12;
+
+} // namespace
+
+ClassCostsMenu::ClassCostsMenu()
+{
+  refresh();
+}
+
+void
+ClassCostsMenu::refresh()
+{
+  clear();
+
+  add_label(_("Object Class Costs"));
+  add_hl();
+
+  add_toggle(-1, _("Measure"),
+             []{ return g_class_cost_stats.is_enabled(); },
+             [](bool value){ g_class_cost_stats.set_enabled(value); });
+
+  if (g_class_cost_stats.is_enabled())
+  {
+    add_inactive(_("update ms / draw ms / objects / requests per frame"));
+
+    for (const auto& cost : g_class_cost_stats.get_top(MAX_CLASSES))
+    {
+      char str[200];
+      snprintf(str, sizeof(str), "%s  %.2f / %.2f / %.0f / %.0f",
+               cost.class_name.c_str(),
+               static_cast<double>(cost.update_time * 1000.0f),
+               static_cast<double>(cost.draw_time * 1000.0f),
+               static_cast<double>(std::max(cost.update_calls, cost.draw_calls)),
+               static_cast<double>(cost.draw_requests));
+      add_inactive(str);
+    }
+  }
+
+  add_hl();
+  add_entry(MNID_REFRESH, _("Refresh"));
+  add_back(_("Back"));
+}
+
+void
+ClassCostsMenu::menu_action(MenuItem& item)
+{
+  if (item.get_id() == MNID_REFRESH)
+  {
+    refresh();
+    set_active_item(MNID_REFRESH);
+  }
+}
+
+/* EOF */
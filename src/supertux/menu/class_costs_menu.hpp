@@ -0,0 +1,45 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_MENU_CLASS_COSTS_MENU_HPP
+#define HEADER_SUPERTUX_SUPERTUX_MENU_CLASS_COSTS_MENU_HPP
+
+#include "gui/menu.hpp"
+
+/** Lists the GameObject classes that took the most time to update and
+    draw recently, see ClassCostStats */
+class ClassCostsMenu final : public Menu
+{
+private:
+  enum {
+    MNID_REFRESH
+  };
+
+public:
+  ClassCostsMenu();
+
+  void refresh() override;
+  void menu_action(MenuItem& item) override;
+
+private:
+  ClassCostsMenu(const ClassCostsMenu&) = delete;
+  ClassCostsMenu& operator=(const ClassCostsMenu&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -16,6 +16,7 @@
 
 #include "supertux/menu/contrib_levelset_menu.hpp"
 
+#include <SDL.h>
 #include <assert.h>
 #include <sstream>
 
@@ -23,6 +24,7 @@
 #include "gui/item_action.hpp"
 #include "sdk/integration.hpp"
 #include "supertux/game_manager.hpp"
+#include "supertux/level_metadata_cache.hpp"
 #include "supertux/level_parser.hpp"
 #include "supertux/levelset.hpp"
 #include "supertux/player_status.hpp"
@@ -30,6 +32,7 @@
 #include "supertux/world.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
+#include "util/log.hpp"
 
 ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
   m_world(std::move(world)),
@@ -45,6 +48,10 @@ ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
   add_label(m_world->get_title());
   add_hl();
 
+  const Uint32 start_ticks = SDL_GetTicks();
+  auto* cache = LevelMetadataCache::current();
+  const int hits = cache ? cache->get_hits() : 0;
+
   for (int i = 0; i < m_levelset->get_num_levels(); ++i)
   {
     std::string filename = m_levelset->get_level_filename(i);
@@ -64,6 +71,12 @@ ContribLevelsetMenu::ContribLevelsetMenu(std::unique_ptr<World> world) :
     add_entry(i, out.str());
   }
 
+  log_info << "Read information of " << m_levelset->get_num_levels() << " levels in "
+           << static_cast<float>(SDL_GetTicks() - start_ticks) / 1000.0f << " seconds, "
+           << (cache ? cache->get_hits() - hits : 0) << " from the cache" << std::endl;
+  if (cache)
+    cache->save();
+
   add_hl();
   add_back(_("Back"));
 }
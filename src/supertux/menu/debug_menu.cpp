@@ -20,9 +20,11 @@
 #include <sstream>
 
 #include "gui/item_stringselect.hpp"
+#include "gui/menu_manager.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
+#include "supertux/menu/class_costs_menu.hpp"
 #include "util/gettext.hpp"
 #include "video/texture_manager.hpp"
 
@@ -66,10 +68,12 @@ DebugMenu::DebugMenu() :
   add_toggle(-1, _("Show Framerate"), &g_config->show_fps);
   add_toggle(-1, _("Draw Redundant Frames"), &g_debug.draw_redundant_frames);
   add_toggle(-1, _("Show Player Position"), &g_config->show_player_pos);
+  add_toggle(-1, _("Show Memory Usage"), &g_debug.show_memory_usage);
   add_toggle(-1, _("Use Bitmap Fonts"),
              []{ return g_debug.get_use_bitmap_fonts(); },
              [](bool value){ g_debug.set_use_bitmap_fonts(value); });
   add_entry(_("Dump Texture Cache"), []{ TextureManager::current()->debug_print(std::cout); });
+  add_entry(_("Object Class Costs"), []{ MenuManager::instance().push_menu(std::make_unique<ClassCostsMenu>()); });
 
   add_hl();
   add_back(_("Back"));
@@ -70,6 +70,7 @@ EditorMenu::EditorMenu()
   add_toggle(-1, _("Autotile Mode"), &EditorOverlayWidget::autotile_mode);
   add_toggle(-1, _("Enable Autotile Help"), &EditorOverlayWidget::autotile_help);
   add_intfield(_("Autosave Frequency"), &(g_config->editor_autosave_frequency));
+  add_toggle(-1, _("Compress Tilemaps"), &(g_config->editor_compress_tiles));
 
   add_submenu(worldmap ? _("Worldmap Settings") : _("Level Settings"),
               MenuStorage::EDITOR_LEVEL_MENU);
@@ -54,11 +54,13 @@ public:
 
   virtual void set_pos(const Vector& pos)
   {
+    wake_up();
     m_col.set_pos(pos);
   }
 
   virtual void move_to(const Vector& pos)
   {
+    wake_up();
     m_col.move_to(pos);
   }
 
@@ -76,12 +78,12 @@ public:
 
   const Vector& get_movement() const
   {
-    return m_col.m_movement;
+    return m_col.get_movement();
   }
 
   CollisionGroup get_group() const
   {
-    return m_col.m_group;
+    return m_col.get_group();
   }
 
   CollisionObject* get_collision_object() {
@@ -100,7 +102,7 @@ public:
 protected:
   void set_group(CollisionGroup group)
   {
-    m_col.m_group = group;
+    m_col.set_group(group);
   }
 
 protected:
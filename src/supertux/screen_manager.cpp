@@ -18,12 +18,15 @@
 #include "supertux/screen_manager.hpp"
 
 #include "audio/sound_manager.hpp"
+#include "collision/collision_system.hpp"
 #include "editor/editor.hpp"
 #include "editor/particle_editor.hpp"
 #include "gui/menu_manager.hpp"
 #include "object/player.hpp"
 #include "sdk/integration.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/benchmark.hpp"
+#include "supertux/class_cost_stats.hpp"
 #include "supertux/console.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/controller_hud.hpp"
@@ -32,11 +35,13 @@
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/level.hpp"
+#include "supertux/memory_usage.hpp"
 #include "supertux/menu/menu_storage.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/sector.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 
@@ -221,6 +226,15 @@ ScreenManager::draw_fps(DrawingContext& context, FPS_Stats& fps_statistics)
   pos.x -= w2;
   context.color().draw_text(Resources::small_font, str1,
     pos, ALIGN_RIGHT, LAYER_HUD);
+
+  // requests of the last frame and the draw calls they were merged into
+  char str4[60];
+  snprintf(str4, str_length, "Draw calls %d / %d",
+    Compositor::s_last_request_count, Compositor::s_last_draw_call_count);
+  pos.x = static_cast<float>(context.get_width()) - BORDER_X;
+  pos.y += 15;
+  context.color().draw_text(Resources::small_font, str4,
+    pos, ALIGN_RIGHT, LAYER_HUD);
 }
 
 void
@@ -239,6 +253,69 @@ ScreenManager::draw_player_pos(DrawingContext& context)
   }
 }
 
+void
+ScreenManager::draw_frame_graph(DrawingContext& context)
+{
+  // one bar per frame, 1 pixel per millisecond
+  static const float GRAPH_HEIGHT = 50.0f;
+  static const float FRAME_BUDGET = 1000.0f / 60.0f;
+
+  std::vector<float> frame_times;
+  Profiler::get_frame_times(frame_times);
+
+  const size_t max_bars = static_cast<size_t>(context.get_width() / 2);
+  const size_t first = frame_times.size() > max_bars ? frame_times.size() - max_bars : 0;
+  const float bottom = static_cast<float>(context.get_height()) - BORDER_Y;
+
+  context.color().draw_filled_rect(Rectf(BORDER_X, bottom - GRAPH_HEIGHT,
+                                         static_cast<float>(context.get_width()) - BORDER_X, bottom),
+                                   Color(0.0f, 0.0f, 0.0f, 0.5f), LAYER_HUD);
+
+  for (size_t i = first; i < frame_times.size(); ++i)
+  {
+    const float ms = frame_times[i] * 1000.0f;
+    const float x = BORDER_X + static_cast<float>(i - first) * 2.0f;
+    const Color color = (ms > FRAME_BUDGET) ? Color(1.0f, 0.3f, 0.3f) : Color(0.3f, 1.0f, 0.3f);
+    context.color().draw_filled_rect(Rectf(x, bottom - std::min(ms, GRAPH_HEIGHT), x + 1.0f, bottom),
+                                     color, LAYER_HUD + 1);
+  }
+
+  context.color().draw_filled_rect(Rectf(BORDER_X, bottom - FRAME_BUDGET - 1.0f,
+                                         static_cast<float>(context.get_width()) - BORDER_X, bottom - FRAME_BUDGET),
+                                   Color(1.0f, 1.0f, 1.0f, 0.5f), LAYER_HUD + 1);
+
+  if (!frame_times.empty())
+  {
+    char str[60];
+    snprintf(str, sizeof(str), "Frame %.1f ms", static_cast<double>(frame_times.back() * 1000.0f));
+    context.color().draw_text(Resources::small_font, str,
+                              Vector(BORDER_X, bottom - GRAPH_HEIGHT - 15.0f), ALIGN_LEFT, LAYER_HUD + 1);
+  }
+}
+
+void
+ScreenManager::draw_memory_usage(DrawingContext& context)
+{
+  const MemoryUsage usage = MemoryUsage::collect(false);
+
+  Vector pos(BORDER_X, BORDER_Y + 50);
+  for (const auto& category : usage.get_categories())
+  {
+    char str[80];
+    snprintf(str, sizeof(str), "%s (%s): %.1f MiB in %d",
+             category.name.c_str(), category.location.c_str(),
+             static_cast<double>(category.bytes) / (1024.0 * 1024.0),
+             static_cast<int>(category.count));
+    context.color().draw_text(Resources::small_font, str, pos, ALIGN_LEFT, LAYER_HUD);
+    pos.y += 15;
+  }
+
+  char str[60];
+  snprintf(str, sizeof(str), "total: %.1f MiB",
+           static_cast<double>(usage.get_total()) / (1024.0 * 1024.0));
+  context.color().draw_text(Resources::small_font, str, pos, ALIGN_LEFT, LAYER_HUD);
+}
+
 void
 ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 {
@@ -268,6 +345,14 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
     draw_player_pos(context);
   }
 
+  if (g_debug.show_frame_graph) {
+    draw_frame_graph(context);
+  }
+
+  if (g_debug.show_memory_usage) {
+    draw_memory_usage(context);
+  }
+
   // render everything
   compositor.render();
 }
@@ -275,6 +360,8 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 void
 ScreenManager::update_gamelogic(float dt_sec)
 {
+  PROFILE_SCOPE("ScreenManager::update_gamelogic");
+
   const Controller& controller = m_input_manager.get_controller();
 
   SquirrelVirtualMachine::current()->update(g_game_time);
@@ -490,6 +577,8 @@ ScreenManager::run()
       continue;
     }
 
+    PROFILE_SCOPE("ScreenManager::run");
+
     g_real_time = static_cast<float>(ticks) / 1000.0f;
 
     float speed_multiplier = 1.0f / g_debug.get_game_speed_multiplier();
@@ -530,6 +619,18 @@ ScreenManager::run()
       elapsed_ticks -= ms_per_step;
     }
 
+    // fast-forward a demo to the step it should be seeked to, without
+    // drawing the frames in between
+    while (GameSession::current() && GameSession::current()->is_seeking_demo() &&
+           m_actions.empty())
+    {
+      float dtime = seconds_per_step * m_speed * speed_multiplier;
+      g_game_time += dtime;
+      process_events();
+      update_gamelogic(dtime);
+      steps = std::max(steps, 1);
+    }
+
     if ((steps > 0 && !m_screen_stack.empty())
         || g_debug.draw_redundant_frames) {
       // Draw a frame
@@ -541,9 +642,67 @@ ScreenManager::run()
     SoundManager::current()->update();
 
     handle_screen_switch();
+
+    if (g_class_cost_stats.is_enabled())
+      g_class_cost_stats.next_frame();
+
+    PROFILE_FRAME();
   }
 
   Integration::close_all();
 }
 
+void
+ScreenManager::run_benchmark(Benchmark& benchmark, bool draw_frames)
+{
+  using clock = std::chrono::steady_clock;
+
+  const Uint32 ms_per_step = static_cast<Uint32>(1000.0f / LOGICAL_FPS);
+  const float seconds_per_step = static_cast<float>(ms_per_step) / 1000.0f;
+  FPS_Stats fps_statistics;
+
+  handle_screen_switch();
+  while (!m_screen_stack.empty())
+  {
+    if (GameSession::current() && GameSession::current()->is_demo_finished())
+      break;
+
+    // same steps as in run(), just without waiting for the clock
+    const float dtime = seconds_per_step * m_speed;
+    g_game_time += dtime;
+    g_real_time = g_game_time;
+    process_events();
+
+    const Sector* sector = Sector::current();
+    const size_t tested_pairs = sector ? sector->get_collision_system().get_tested_pairs() : 0;
+
+    const auto update_start = clock::now();
+    update_gamelogic(dtime);
+    const auto update_end = clock::now();
+
+    size_t objects = 0;
+    size_t step_tested_pairs = 0;
+    if (const Sector* current = Sector::current())
+    {
+      objects = current->get_objects().size();
+      step_tested_pairs = current->get_collision_system().get_tested_pairs();
+      if (current == sector)
+        step_tested_pairs -= tested_pairs;
+    }
+    benchmark.add_step(std::chrono::duration<float>(update_end - update_start).count(),
+                       objects, step_tested_pairs);
+
+    if (draw_frames && !m_screen_stack.empty())
+    {
+      const auto draw_start = clock::now();
+      Compositor compositor(m_video_system);
+      draw(compositor, fps_statistics);
+      fps_statistics.report_frame();
+      benchmark.add_frame(std::chrono::duration<float>(clock::now() - draw_start).count());
+    }
+
+    handle_screen_switch();
+  }
+}
+
 /* EOF */
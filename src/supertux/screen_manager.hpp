@@ -24,6 +24,7 @@
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
 
+class Benchmark;
 class Compositor;
 class ControllerHUD;
 class DrawingContext;
@@ -43,6 +44,12 @@ public:
   ~ScreenManager();
 
   void run();
+
+  /** Runs the game steps back to back without waiting and without
+      sound, until all screens are gone or the demo of the current
+      GameSession ran out, and records their timings in
+      @c benchmark. Frames are only drawn if @c draw_frames is set. */
+  void run_benchmark(Benchmark& benchmark, bool draw_frames);
   void quit(std::unique_ptr<ScreenFade> fade = {});
   void set_speed(float speed);
   float get_speed() const;
@@ -57,6 +64,8 @@ private:
   struct FPS_Stats;
   void draw_fps(DrawingContext& context, FPS_Stats& fps_statistics);
   void draw_player_pos(DrawingContext& context);
+  void draw_frame_graph(DrawingContext& context);
+  void draw_memory_usage(DrawingContext& context);
   void draw(Compositor& compositor, FPS_Stats& fps_statistics);
   void update_gamelogic(float dt_sec);
   void process_events();
@@ -46,6 +46,7 @@
 #include "physfs/ifile_stream.hpp"
 #include "scripting/sector.hpp"
 #include "squirrel/squirrel_environment.hpp"
+#include "supertux/activation_manager.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/game_object_factory.hpp"
@@ -55,6 +56,7 @@
 #include "supertux/savegame.hpp"
 #include "supertux/tile.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
 #include "util/writer.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
@@ -75,6 +77,8 @@ Sector::Sector(Level& parent) :
   m_foremost_layer(),
   m_squirrel_environment(new SquirrelEnvironment(SquirrelVirtualMachine::current()->get_vm(), "sector")),
   m_collision_system(new CollisionSystem(*this)),
+  m_activation_manager(new ActivationManager(*this, Sizef(BadGuy::X_OFFSCREEN_DISTANCE,
+                                                          BadGuy::Y_OFFSCREEN_DISTANCE))),
   m_gravity(10.0)
 {
   Savegame* savegame = (Editor::current() && Editor::is_active()) ?
@@ -325,12 +329,15 @@ Sector::get_foremost_layer() const
 void
 Sector::update(float dt_sec)
 {
+  PROFILE_SCOPE("Sector::update");
+
   assert(m_fully_constructed);
 
   BIND_SECTOR(*this);
 
   m_squirrel_environment->update(dt_sec);
 
+  m_activation_manager->begin_update();
   GameObjectManager::update(dt_sec);
 
   /* Handle all possible collisions. */
@@ -382,6 +389,12 @@ Sector::before_object_remove(GameObject& object)
     m_squirrel_environment->try_unexpose(object);
 }
 
+void
+Sector::after_object_update()
+{
+  m_activation_manager->wake_up();
+}
+
 void
 Sector::draw(DrawingContext& context)
 {
@@ -461,6 +474,25 @@ Sector::inside(const Rectf& rect) const
   return false;
 }
 
+bool
+Sector::inside_static(const Rectf& rect) const
+{
+  for (const auto& solids : get_solid_tilemaps()) {
+    if (solids->get_walker())
+      continue;
+
+    Rectf bbox = solids->get_bbox();
+
+    // the top of the sector extends to infinity
+    if (bbox.get_left() <= rect.get_left() &&
+        rect.get_right() <= bbox.get_right() &&
+        rect.get_bottom() <= bbox.get_bottom()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Size
 Sector::get_editor_size() const
 {
@@ -31,6 +31,7 @@ namespace collision {
 class Constraints;
 }
 
+class ActivationManager;
 class Camera;
 class CollisionSystem;
 class DisplayEffect;
@@ -95,6 +96,11 @@ public:
       (a rectangle that is on top of the sector is considered inside) */
   bool inside(const Rectf& rectangle) const;
 
+  /** Same as inside(), but only looks at solid tilemaps that don't
+      follow a path, so that the result stays the same while no
+      tilemap is added, removed or resized */
+  bool inside_static(const Rectf& rectangle) const;
+
   /** Checks if the specified rectangle is free of (solid) tiles.
       Note that this does not include static objects, e.g. bonus blocks. */
   bool is_free_of_tiles(const Rectf& rect, const bool ignoreUnisolid = false) const;
@@ -148,11 +154,15 @@ public:
   Player& get_player() const;
   DisplayEffect& get_effect() const;
 
+  ActivationManager& get_activation_manager() const { return *m_activation_manager; }
+  const CollisionSystem& get_collision_system() const { return *m_collision_system; }
+
 private:
   uint32_t collision_tile_attributes(const Rectf& dest, const Vector& mov) const;
 
   virtual bool before_object_add(GameObject& object) override;
   virtual void before_object_remove(GameObject& object) override;
+  virtual void after_object_update() override;
 
   int calculate_foremost_layer() const;
 
@@ -174,6 +184,7 @@ private:
 
   std::unique_ptr<SquirrelEnvironment> m_squirrel_environment;
   std::unique_ptr<CollisionSystem> m_collision_system;
+  std::unique_ptr<ActivationManager> m_activation_manager;
 
   float m_gravity;
 
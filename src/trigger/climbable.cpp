@@ -87,7 +87,7 @@ Climbable::get_settings()
 
 void
 Climbable::after_editor_set() {
-  m_col.m_bbox.set_size(new_size.x, new_size.y);
+  m_col.set_size(new_size.x, new_size.y);
 }
 
 void
@@ -88,7 +88,7 @@ ScriptTrigger::get_settings()
 
 void
 ScriptTrigger::after_editor_set() {
-  m_col.m_bbox.set_size(new_size.x, new_size.y);
+  m_col.set_size(new_size.x, new_size.y);
   if (must_activate) {
     triggerevent = EVENT_ACTIVATE;
   } else {
@@ -91,7 +91,7 @@ SequenceTrigger::get_settings()
 void
 SequenceTrigger::after_editor_set()
 {
-  m_col.m_bbox.set_size(new_size.x, new_size.y);
+  m_col.set_size(new_size.x, new_size.y);
 }
 
 void
@@ -0,0 +1,514 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/document_cache.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <physfs.h>
+#include <sstream>
+#include <string.h>
+
+#include "util/log.hpp"
+
+namespace {
+
+const char MAGIC[4] = { 'S', 'T', 'S', 'X' };
+const uint8_t VERSION = 2;
+
+/** magic, version, content size, content hash, payload size */
+const size_t HEADER_SIZE = 4 + 1 + 8 + 8 + 8;
+
+enum Tag : uint8_t
+{
+  TAG_NIL,
+  TAG_FALSE,
+  TAG_TRUE,
+  TAG_INTEGER,
+  TAG_REAL,
+  TAG_STRING,
+  TAG_SYMBOL,
+  TAG_CONS,
+  TAG_ARRAY,
+  /** An array of a symbol followed by integers only, like the tiles
+      of a tilemap, stored without a tag per element */
+  TAG_INTEGER_ARRAY
+};
+
+/** Nesting limit for decode(), so broken files can't overflow the
+    stack */
+const int MAX_DEPTH = 1000;
+
+void write_varint(std::string& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+void write_int(std::string& out, int value)
+{
+  // zigzag, so small negative numbers stay short
+  const uint32_t bits = static_cast<uint32_t>(value);
+  write_varint(out, (bits << 1) ^ (value < 0 ? 0xffffffffu : 0u));
+}
+
+void write_string(std::string& out, const std::string& value)
+{
+  write_varint(out, value.size());
+  out += value;
+}
+
+void write_uint64(std::string& out, uint64_t value)
+{
+  for (int i = 0; i < 8; ++i) {
+    out += static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+bool is_integer_array(const std::vector<sexp::Value>& arr)
+{
+  if (arr.size() < 2 || !arr[0].is_symbol())
+    return false;
+
+  for (size_t i = 1; i < arr.size(); ++i) {
+    if (!arr[i].is_integer())
+      return false;
+  }
+  return true;
+}
+
+void encode_value(std::string& out, const sexp::Value& sx)
+{
+  switch (sx.get_type())
+  {
+    case sexp::Value::Type::NIL:
+      out += static_cast<char>(TAG_NIL);
+      break;
+
+    case sexp::Value::Type::BOOLEAN:
+      out += static_cast<char>(sx.as_bool() ? TAG_TRUE : TAG_FALSE);
+      break;
+
+    case sexp::Value::Type::INTEGER:
+      out += static_cast<char>(TAG_INTEGER);
+      write_int(out, sx.as_int());
+      break;
+
+    case sexp::Value::Type::REAL: {
+      out += static_cast<char>(TAG_REAL);
+      const float value = sx.as_float();
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      for (int i = 0; i < 4; ++i) {
+        out += static_cast<char>((bits >> (8 * i)) & 0xff);
+      }
+      break;
+    }
+
+    case sexp::Value::Type::STRING:
+      out += static_cast<char>(TAG_STRING);
+      write_string(out, sx.as_string());
+      break;
+
+    case sexp::Value::Type::SYMBOL:
+      out += static_cast<char>(TAG_SYMBOL);
+      write_string(out, sx.as_string());
+      break;
+
+    case sexp::Value::Type::CONS:
+      out += static_cast<char>(TAG_CONS);
+      encode_value(out, sx.get_car());
+      encode_value(out, sx.get_cdr());
+      break;
+
+    case sexp::Value::Type::ARRAY: {
+      const auto& arr = sx.as_array();
+      if (is_integer_array(arr))
+      {
+        out += static_cast<char>(TAG_INTEGER_ARRAY);
+        write_string(out, arr[0].as_string());
+        write_varint(out, arr.size() - 1);
+        for (size_t i = 1; i < arr.size(); ++i) {
+          write_int(out, arr[i].as_int());
+        }
+      }
+      else
+      {
+        out += static_cast<char>(TAG_ARRAY);
+        write_varint(out, arr.size());
+        for (const auto& item : arr) {
+          encode_value(out, item);
+        }
+      }
+      break;
+    }
+  }
+}
+
+class Decoder final
+{
+public:
+  Decoder(const std::string& data) :
+    m_data(data),
+    m_pos(0)
+  {}
+
+  bool at_end() const { return m_pos == m_data.size(); }
+
+  uint8_t read_byte()
+  {
+    if (m_pos >= m_data.size())
+      throw std::runtime_error("unexpected end of data");
+    return static_cast<uint8_t>(m_data[m_pos++]);
+  }
+
+  uint64_t read_varint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = read_byte();
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return value;
+    }
+    throw std::runtime_error("varint too long");
+  }
+
+  int read_int()
+  {
+    const uint32_t bits = static_cast<uint32_t>(read_varint());
+    return static_cast<int>((bits >> 1) ^ (0u - (bits & 1)));
+  }
+
+  /** Returns a count of items that take at least one byte each, so
+      broken counts can't make us allocate huge amounts of memory */
+  size_t read_count()
+  {
+    const uint64_t count = read_varint();
+    if (count > m_data.size() - m_pos)
+      throw std::runtime_error("count exceeds data");
+    return static_cast<size_t>(count);
+  }
+
+  void read_integer_arrays(std::vector<std::vector<int> >& integer_arrays)
+  {
+    const size_t count = read_count();
+    integer_arrays.resize(count);
+    for (auto& integers : integer_arrays) {
+      const size_t size = read_count();
+      integers.clear();
+      integers.reserve(size);
+      for (size_t i = 0; i < size; ++i) {
+        integers.push_back(read_int());
+      }
+    }
+  }
+
+  std::string read_string()
+  {
+    const size_t size = read_count();
+    std::string value = m_data.substr(m_pos, size);
+    m_pos += size;
+    return value;
+  }
+
+  sexp::Value read_value(int depth)
+  {
+    if (depth > MAX_DEPTH)
+      throw std::runtime_error("nested too deeply");
+
+    const uint8_t tag = read_byte();
+    switch (tag)
+    {
+      case TAG_NIL:
+        return sexp::Value::nil();
+
+      case TAG_FALSE:
+        return sexp::Value::boolean(false);
+
+      case TAG_TRUE:
+        return sexp::Value::boolean(true);
+
+      case TAG_INTEGER:
+        return sexp::Value::integer(read_int());
+
+      case TAG_REAL: {
+        uint32_t bits = 0;
+        for (int i = 0; i < 4; ++i) {
+          bits |= static_cast<uint32_t>(read_byte()) << (8 * i);
+        }
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return sexp::Value::real(value);
+      }
+
+      case TAG_STRING:
+        return sexp::Value::string(read_string());
+
+      case TAG_SYMBOL:
+        return sexp::Value::symbol(read_string());
+
+      case TAG_CONS: {
+        sexp::Value car = read_value(depth + 1);
+        sexp::Value cdr = read_value(depth + 1);
+        return sexp::Value::cons(std::move(car), std::move(cdr));
+      }
+
+      case TAG_ARRAY: {
+        const size_t count = read_count();
+        std::vector<sexp::Value> arr;
+        arr.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+          arr.push_back(read_value(depth + 1));
+        }
+        return sexp::Value::array(std::move(arr));
+      }
+
+      case TAG_INTEGER_ARRAY: {
+        sexp::Value name = sexp::Value::symbol(read_string());
+        const size_t count = read_count();
+        std::vector<sexp::Value> arr;
+        arr.reserve(count + 1);
+        arr.push_back(std::move(name));
+        for (size_t i = 0; i < count; ++i) {
+          arr.push_back(sexp::Value::integer(read_int()));
+        }
+        return sexp::Value::array(std::move(arr));
+      }
+
+      default:
+        throw std::runtime_error("unknown tag");
+    }
+  }
+
+private:
+  const std::string& m_data;
+  size_t m_pos;
+
+private:
+  Decoder(const Decoder&) = delete;
+  Decoder& operator=(const Decoder&) = delete;
+};
+
+uint64_t read_uint64(const std::string& data, size_t pos)
+{
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+  }
+  return value;
+}
+
+uint64_t elapsed_usec(std::chrono::steady_clock::time_point start)
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+uint64_t
+DocumentCache::hash(const std::string& data)
+{
+  uint64_t value = 14695981039346656037ull;
+  for (char c : data) {
+    value ^= static_cast<uint8_t>(c);
+    value *= 1099511628211ull;
+  }
+  return value;
+}
+
+std::string
+DocumentCache::encode(const sexp::Value& sx)
+{
+  return encode(sx, {});
+}
+
+std::string
+DocumentCache::encode(const sexp::Value& sx, const std::vector<std::vector<int> >& integer_arrays)
+{
+  std::string out;
+  encode_value(out, sx);
+
+  write_varint(out, integer_arrays.size());
+  for (const auto& integers : integer_arrays) {
+    write_varint(out, integers.size());
+    for (const int value : integers) {
+      write_int(out, value);
+    }
+  }
+  return out;
+}
+
+sexp::Value
+DocumentCache::decode(const std::string& data)
+{
+  std::vector<std::vector<int> > integer_arrays;
+  return decode(data, integer_arrays);
+}
+
+sexp::Value
+DocumentCache::decode(const std::string& data, std::vector<std::vector<int> >& integer_arrays)
+{
+  Decoder decoder(data);
+  sexp::Value sx = decoder.read_value(0);
+  decoder.read_integer_arrays(integer_arrays);
+  if (!decoder.at_end())
+    throw std::runtime_error("trailing data");
+  return sx;
+}
+
+DocumentCache::DocumentCache(const std::string& directory) :
+  m_directory(directory),
+  m_writable(false),
+  m_parsed(0),
+  m_cached(0),
+  m_parse_time(0),
+  m_cache_time(0)
+{
+  if (PHYSFS_mkdir(m_directory.c_str())) {
+    m_writable = true;
+  } else {
+    log_warning << "Couldn't create directory '" << m_directory << "', documents won't be cached: "
+                << PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()) << std::endl;
+  }
+}
+
+sexp::Value
+DocumentCache::parse(const std::string& filename, const std::string& contents,
+                     std::vector<std::vector<int> >& integer_arrays,
+                     const ParseFunc& parse_func)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  // files the user writes to change often and would only fill up the
+  // cache, binary copies of them don't pay off
+  const char* realdir = PHYSFS_getRealDir(filename.c_str());
+  const char* writedir = PHYSFS_getWriteDir();
+  const bool cacheable = m_writable && !(realdir && writedir && strcmp(realdir, writedir) == 0);
+
+  const std::string cache_filename = get_cache_filename(filename);
+
+  sexp::Value sx;
+  if (cacheable && load(cache_filename, contents, sx, integer_arrays))
+  {
+    m_cached += 1;
+    m_cache_time += elapsed_usec(start);
+    return sx;
+  }
+
+  integer_arrays.clear();
+  parse_func(contents, sx, integer_arrays);
+  m_parsed += 1;
+  m_parse_time += elapsed_usec(start);
+
+  if (cacheable) {
+    save(cache_filename, contents, sx, integer_arrays);
+    log_debug << "Cached '" << filename << "' as '" << cache_filename << "'" << std::endl;
+  }
+
+  return sx;
+}
+
+void
+DocumentCache::print_stats() const
+{
+  log_info << "Documents parsed: " << m_parsed << " in " << static_cast<float>(m_parse_time) / 1000.0f
+           << "ms, read from the cache: " << m_cached << " in " << static_cast<float>(m_cache_time) / 1000.0f
+           << "ms" << std::endl;
+}
+
+std::string
+DocumentCache::get_cache_filename(const std::string& filename) const
+{
+  std::ostringstream out;
+  out << m_directory << "/" << std::hex << std::setw(16) << std::setfill('0') << hash(filename) << ".bin";
+  return out.str();
+}
+
+bool
+DocumentCache::load(const std::string& cache_filename, const std::string& contents, sexp::Value& sx,
+                    std::vector<std::vector<int> >& integer_arrays) const
+{
+  PHYSFS_File* file = PHYSFS_openRead(cache_filename.c_str());
+  if (!file)
+    return false;
+
+  // read the whole file at once, decoding works on the buffer
+  std::string data;
+  const PHYSFS_sint64 length = PHYSFS_fileLength(file);
+  if (length >= static_cast<PHYSFS_sint64>(HEADER_SIZE))
+  {
+    data.resize(static_cast<size_t>(length));
+    if (PHYSFS_readBytes(file, &data[0], data.size()) != length) {
+      data.clear();
+    }
+  }
+  PHYSFS_close(file);
+
+  if (data.empty() ||
+      memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+      static_cast<uint8_t>(data[4]) != VERSION ||
+      read_uint64(data, 5) != contents.size() ||
+      read_uint64(data, 13) != hash(contents) ||
+      read_uint64(data, 21) != data.size() - HEADER_SIZE)
+  {
+    log_debug << "Ignoring outdated or incomplete cache file '" << cache_filename << "'" << std::endl;
+    return false;
+  }
+
+  try
+  {
+    data.erase(0, HEADER_SIZE);
+    sx = decode(data, integer_arrays);
+    return true;
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "Broken cache file '" << cache_filename << "': " << err.what() << std::endl;
+    return false;
+  }
+}
+
+void
+DocumentCache::save(const std::string& cache_filename, const std::string& contents, const sexp::Value& sx,
+                    const std::vector<std::vector<int> >& integer_arrays) const
+{
+  const std::string payload = encode(sx, integer_arrays);
+
+  std::string header(MAGIC, sizeof(MAGIC));
+  header += static_cast<char>(VERSION);
+  write_uint64(header, contents.size());
+  write_uint64(header, hash(contents));
+  write_uint64(header, payload.size());
+
+  PHYSFS_File* file = PHYSFS_openWrite(cache_filename.c_str());
+  if (!file) {
+    log_warning << "Couldn't write '" << cache_filename << "': "
+                << PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()) << std::endl;
+    return;
+  }
+
+  PHYSFS_writeBytes(file, header.data(), header.size());
+  PHYSFS_writeBytes(file, payload.data(), payload.size());
+  PHYSFS_close(file);
+}
+
+/* EOF */
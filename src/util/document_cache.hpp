@@ -0,0 +1,100 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_DOCUMENT_CACHE_HPP
+#define HEADER_SUPERTUX_UTIL_DOCUMENT_CACHE_HPP
+
+#include <atomic>
+#include <functional>
+#include <sexp/value.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "util/currenton.hpp"
+
+/** Keeps parsed documents in a binary form in the user directory, so
+    that ReaderDocument::from_file() can skip the text parser for
+    files it has seen before. There is one entry per file name, which
+    stores a hash of the file contents so that changed files are
+    parsed again and their entry is overwritten. Files in the user
+    directory itself, like savegames and levels made in the editor,
+    are not cached. Can be used from several threads at once.
+
+    Besides the document, each entry holds the lists of integers that
+    were taken out of the text before parsing it, like the tiles of
+    the tilemaps, so a cached file doesn't have to be scanned for
+    them again. */
+class DocumentCache final : public Currenton<DocumentCache>
+{
+public:
+  /** Parses the file @c contents into @c sx, moving lists of integers
+      out of the text into @c integer_arrays */
+  typedef std::function<void (const std::string& contents, sexp::Value& sx,
+                              std::vector<std::vector<int> >& integer_arrays)> ParseFunc;
+
+public:
+  /** 64 bit FNV-1a hash of @c data */
+  static uint64_t hash(const std::string& data);
+
+  /** Returns the binary form of @c sx */
+  static std::string encode(const sexp::Value& sx);
+  static std::string encode(const sexp::Value& sx, const std::vector<std::vector<int> >& integer_arrays);
+
+  /** Returns the document in @c data, which encode() created. Throws
+      an exception if @c data is broken. */
+  static sexp::Value decode(const std::string& data);
+  static sexp::Value decode(const std::string& data, std::vector<std::vector<int> >& integer_arrays);
+
+public:
+  DocumentCache(const std::string& directory = "cache/documents");
+
+  /** Returns the parsed form of the file @c contents and the integer
+      lists taken out of it, from the cache if possible and from
+      @c parse_func otherwise */
+  sexp::Value parse(const std::string& filename, const std::string& contents,
+                    std::vector<std::vector<int> >& integer_arrays,
+                    const ParseFunc& parse_func);
+
+  /** Logs how many documents were parsed and how many came from the
+      cache, and the time spent on each */
+  void print_stats() const;
+
+private:
+  std::string get_cache_filename(const std::string& filename) const;
+  bool load(const std::string& cache_filename, const std::string& contents, sexp::Value& sx,
+            std::vector<std::vector<int> >& integer_arrays) const;
+  void save(const std::string& cache_filename, const std::string& contents, const sexp::Value& sx,
+            const std::vector<std::vector<int> >& integer_arrays) const;
+
+private:
+  std::string m_directory;
+  bool m_writable;
+
+  std::atomic<int> m_parsed;
+  std::atomic<int> m_cached;
+  std::atomic<uint64_t> m_parse_time;
+  std::atomic<uint64_t> m_cache_time;
+
+private:
+  DocumentCache(const DocumentCache&) = delete;
+  DocumentCache& operator=(const DocumentCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,176 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/integer_spans.hpp"
+
+namespace {
+
+/** Longer numbers are left to the parser, so they can't overflow */
+const int MAX_DIGITS = 9;
+
+bool is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+/** Returns the position of the ')' that ends the integers starting
+    at @c pos, or std::string::npos if there is anything else before
+    it */
+size_t scan_integers(const std::string& text, size_t pos, size_t& count)
+{
+  count = 0;
+  while (pos < text.size())
+  {
+    const char c = text[pos];
+    if (is_space(c))
+    {
+      pos += 1;
+    }
+    else if (c == ')')
+    {
+      return pos;
+    }
+    else
+    {
+      if (c == '-') {
+        pos += 1;
+      }
+
+      int digits = 0;
+      while (pos < text.size() && is_digit(text[pos])) {
+        pos += 1;
+        digits += 1;
+      }
+
+      if (digits == 0 || digits > MAX_DIGITS ||
+          pos == text.size() || !(is_space(text[pos]) || text[pos] == ')'))
+        return std::string::npos;
+
+      count += 1;
+    }
+  }
+  return std::string::npos;
+}
+
+template<typename T>
+void read_integers(const std::string& text, const IntegerSpan& span, std::vector<T>& values)
+{
+  values.reserve(values.size() + span.count);
+
+  const char* p = text.data() + span.begin;
+  const char* const end = text.data() + span.end;
+  while (p != end)
+  {
+    if (is_space(*p)) {
+      ++p;
+      continue;
+    }
+
+    const bool negative = (*p == '-');
+    if (negative) {
+      ++p;
+    }
+
+    int value = 0;
+    while (p != end && is_digit(*p)) {
+      value = value * 10 + (*p - '0');
+      ++p;
+    }
+    values.push_back(static_cast<T>(negative ? -value : value));
+  }
+}
+
+} // namespace
+
+const char* const INTEGER_SPAN_SYMBOL = "raw-integers";
+
+std::string
+extract_integer_spans(const std::string& text, const std::string& key,
+                      size_t min_count, std::vector<IntegerSpan>& spans)
+{
+  std::string result;
+  size_t copied = 0;
+
+  size_t pos = 0;
+  while (pos < text.size())
+  {
+    const char c = text[pos];
+    if (c == '"')
+    {
+      for (pos += 1; pos < text.size() && text[pos] != '"'; ++pos) {
+        if (text[pos] == '\\') {
+          pos += 1;
+        }
+      }
+      pos += 1;
+    }
+    else if (c == ';')
+    {
+      pos = text.find('\n', pos);
+    }
+    else if (c == '(' &&
+             text.compare(pos + 1, key.size(), key) == 0 &&
+             pos + 1 + key.size() < text.size() &&
+             is_space(text[pos + 1 + key.size()]))
+    {
+      const size_t begin = pos + 1 + key.size();
+      size_t count;
+      const size_t end = scan_integers(text, begin, count);
+      if (end == std::string::npos || count < min_count)
+      {
+        pos = begin;
+      }
+      else
+      {
+        result.append(text, copied, pos - copied);
+        result += "(" + key + " (" + INTEGER_SPAN_SYMBOL + " " + std::to_string(spans.size()) + "))";
+        spans.push_back({ begin, end, count });
+        pos = end + 1;
+        copied = pos;
+      }
+    }
+    else
+    {
+      pos += 1;
+    }
+  }
+
+  if (copied == 0)
+    return text;
+
+  result.append(text, copied, std::string::npos);
+  return result;
+}
+
+void
+read_integer_span(const std::string& text, const IntegerSpan& span, std::vector<int>& values)
+{
+  read_integers(text, span, values);
+}
+
+void
+read_integer_span(const std::string& text, const IntegerSpan& span, std::vector<unsigned int>& values)
+{
+  read_integers(text, span, values);
+}
+
+/* EOF */
@@ -0,0 +1,51 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_INTEGER_SPANS_HPP
+#define HEADER_SUPERTUX_UTIL_INTEGER_SPANS_HPP
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/** A list of whitespace separated integers in the text of a document,
+    which is left unparsed until it is read with read_integer_span() */
+struct IntegerSpan
+{
+  size_t begin;
+  size_t end;
+  size_t count;
+};
+
+/** Symbol of the list that takes the place of an extracted span:
+    (KEY (raw-integers INDEX)) */
+extern const char* const INTEGER_SPAN_SYMBOL;
+
+/** Returns @c text with every (KEY INT...) of at least @c min_count
+    integers replaced by (KEY (raw-integers INDEX)), where INDEX is
+    the position of the span of the integers in @c spans. Text in
+    strings and comments is left alone. */
+std::string extract_integer_spans(const std::string& text, const std::string& key,
+                                  size_t min_count, std::vector<IntegerSpan>& spans);
+
+/** Appends the integers of @c span in @c text to @c values */
+void read_integer_span(const std::string& text, const IntegerSpan& span, std::vector<int>& values);
+void read_integer_span(const std::string& text, const IntegerSpan& span, std::vector<unsigned int>& values);
+
+#endif
+
+/* EOF */
@@ -0,0 +1,209 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+const uint64_t EVENT_CAPACITY = 1 << 16;
+const uint64_t FRAME_CAPACITY = 1 << 10;
+
+struct Event
+{
+  const char* name;
+  uint64_t start;
+  uint64_t end;
+};
+
+/** The ring buffer a thread records into. Only the owning thread
+    writes to it, readers look at @c count to see how far it got. */
+struct ThreadBuffer
+{
+  ThreadBuffer(uint32_t id_) :
+    id(id_),
+    events(EVENT_CAPACITY),
+    count(0),
+    in_use(true)
+  {}
+
+  uint32_t id;
+  std::vector<Event> events;
+  std::atomic<uint64_t> count;
+  bool in_use;
+};
+
+/** Hands the buffer back when its thread ends, so that short lived
+    threads don't pile up buffers */
+struct ThreadBufferHolder
+{
+  ThreadBufferHolder() : buffer(nullptr) {}
+  ~ThreadBufferHolder();
+
+  ThreadBuffer* buffer;
+};
+
+std::mutex s_buffers_mutex;
+
+/** Never shrinks, so the buffers stay valid for readers */
+std::vector<std::unique_ptr<ThreadBuffer> > s_buffers;
+
+thread_local ThreadBufferHolder s_thread_buffer;
+
+std::array<uint64_t, FRAME_CAPACITY> s_frames;
+std::atomic<uint64_t> s_frame_count(0);
+
+ThreadBufferHolder::~ThreadBufferHolder()
+{
+  if (buffer)
+  {
+    std::lock_guard<std::mutex> lock(s_buffers_mutex);
+    buffer->in_use = false;
+  }
+}
+
+ThreadBuffer& get_thread_buffer()
+{
+  if (!s_thread_buffer.buffer)
+  {
+    std::lock_guard<std::mutex> lock(s_buffers_mutex);
+    auto it = std::find_if(s_buffers.begin(), s_buffers.end(),
+                           [](const std::unique_ptr<ThreadBuffer>& buffer) {
+                             return !buffer->in_use;
+                           });
+    if (it != s_buffers.end())
+    {
+      (*it)->in_use = true;
+      s_thread_buffer.buffer = it->get();
+    }
+    else
+    {
+      s_buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(s_buffers.size())));
+      s_thread_buffer.buffer = s_buffers.back().get();
+    }
+  }
+  return *s_thread_buffer.buffer;
+}
+
+void write_json_string(std::ostream& out, const char* str)
+{
+  out << '"';
+  for (const char* p = str; *p; ++p) {
+    if (*p == '"' || *p == '\\')
+      out << '\\';
+    out << *p;
+  }
+  out << '"';
+}
+
+} // namespace
+
+uint64_t
+Profiler::now()
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void
+Profiler::record(const char* name, uint64_t start, uint64_t end)
+{
+  ThreadBuffer& buffer = get_thread_buffer();
+  const uint64_t count = buffer.count.load(std::memory_order_relaxed);
+  buffer.events[count % EVENT_CAPACITY] = { name, start, end };
+  buffer.count.store(count + 1, std::memory_order_release);
+}
+
+void
+Profiler::frame()
+{
+  const uint64_t count = s_frame_count.load(std::memory_order_relaxed);
+  s_frames[count % FRAME_CAPACITY] = now();
+  s_frame_count.store(count + 1, std::memory_order_release);
+}
+
+void
+Profiler::get_frame_times(std::vector<float>& frame_times)
+{
+  const uint64_t count = s_frame_count.load(std::memory_order_acquire);
+  const uint64_t first = (count > FRAME_CAPACITY) ? count - FRAME_CAPACITY : 0;
+  for (uint64_t i = first + 1; i < count; ++i) {
+    const uint64_t duration = s_frames[i % FRAME_CAPACITY] - s_frames[(i - 1) % FRAME_CAPACITY];
+    frame_times.push_back(static_cast<float>(duration) / 1.0e9f);
+  }
+}
+
+void
+Profiler::write_trace(std::ostream& out, size_t frames)
+{
+  // everything after the end of the frame before the first one asked for
+  const uint64_t frame_count = s_frame_count.load(std::memory_order_acquire);
+  uint64_t begin = 0;
+  if (frames < frame_count)
+  {
+    const uint64_t oldest = (frame_count > FRAME_CAPACITY) ? frame_count - FRAME_CAPACITY : 0;
+    const uint64_t index = std::max(frame_count - frames - 1, oldest);
+    begin = s_frames[index % FRAME_CAPACITY];
+  }
+
+  std::vector<ThreadBuffer*> buffers;
+  {
+    std::lock_guard<std::mutex> lock(s_buffers_mutex);
+    for (const auto& buffer : s_buffers) {
+      buffers.push_back(buffer.get());
+    }
+  }
+
+  const auto old_flags = out.flags();
+  const auto old_precision = out.precision();
+  out << std::fixed << std::setprecision(3);
+
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto* buffer : buffers)
+  {
+    const uint64_t count = buffer->count.load(std::memory_order_acquire);
+    const uint64_t oldest = (count > EVENT_CAPACITY) ? count - EVENT_CAPACITY : 0;
+    for (uint64_t i = oldest; i < count; ++i)
+    {
+      const Event& event = buffer->events[i % EVENT_CAPACITY];
+      if (event.start < begin)
+        continue;
+
+      out << (first ? "\n" : ",\n") << "{\"name\":";
+      write_json_string(out, event.name);
+      out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+          << ",\"ts\":" << static_cast<double>(event.start - begin) / 1000.0
+          << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0
+          << "}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+
+  out.flags(old_flags);
+  out.precision(old_precision);
+}
+
+/* EOF */
@@ -0,0 +1,95 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_PROFILER_HPP
+#define HEADER_SUPERTUX_UTIL_PROFILER_HPP
+
+#include "config.h"
+
+#include <ostream>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/** Collects timed scopes of the game loop. Each thread records into
+    its own ring buffer, so recording takes no locks; only the first
+    scope of a thread registers its buffer. Scopes are recorded with
+    PROFILE_SCOPE(), which compiles to nothing unless the game is
+    built with ENABLE_PROFILER. */
+class Profiler final
+{
+public:
+  /** Nanoseconds on a steady clock */
+  static uint64_t now();
+
+  /** Records a scope of the calling thread that ran from @c start to
+      @c end */
+  static void record(const char* name, uint64_t start, uint64_t end);
+
+  /** Marks the end of a frame, to be called by the main loop */
+  static void frame();
+
+  /** Appends the durations in seconds of the most recent frames to
+      @c frame_times, oldest first */
+  static void get_frame_times(std::vector<float>& frame_times);
+
+  /** Writes the scopes of all threads recorded during the last
+      @c frames frames as Chrome trace_event JSON, to be loaded in
+      chrome://tracing. Scopes recorded while writing may come out
+      garbled. */
+  static void write_trace(std::ostream& out, size_t frames);
+
+private:
+  Profiler() = delete;
+};
+
+/** Records the time from its construction to its destruction */
+class ProfileScope final
+{
+public:
+  explicit ProfileScope(const char* name) :
+    m_name(name),
+    m_start(Profiler::now())
+  {}
+
+  ~ProfileScope()
+  {
+    Profiler::record(m_name, m_start, Profiler::now());
+  }
+
+private:
+  const char* m_name;
+  uint64_t m_start;
+
+private:
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#ifdef ENABLE_PROFILER
+#  define PROFILE_CONCAT_IMPL(a, b) a##b
+#  define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#  define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#  define PROFILE_FRAME() Profiler::frame()
+#else
+#  define PROFILE_SCOPE(name)
+#  define PROFILE_FRAME()
+#endif
+
+#endif
+
+/* EOF */
@@ -16,13 +16,40 @@
 
 #include "util/reader_document.hpp"
 
+#include <iterator>
 #include <sexp/parser.hpp>
 #include <sstream>
 
 #include "physfs/ifile_stream.hpp"
+#include "util/document_cache.hpp"
 #include "util/file_system.hpp"
+#include "util/integer_spans.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** Tilemaps with fewer tiles aren't worth the trouble */
+const size_t MIN_INTEGER_SPAN = 64;
+
+/** Parses @c contents with the tiles read straight from the text, so
+    the parser doesn't have to build a value for each of them */
+void parse_contents(const std::string& contents, sexp::Value& sx,
+                    std::vector<std::vector<int> >& integer_arrays)
+{
+  std::vector<IntegerSpan> integer_spans;
+  const std::string text = extract_integer_spans(contents, "tiles", MIN_INTEGER_SPAN, integer_spans);
+
+  std::istringstream stream(text);
+  sx = sexp::Parser::from_stream(stream, sexp::Parser::USE_ARRAYS);
+
+  integer_arrays.resize(integer_spans.size());
+  for (size_t i = 0; i < integer_spans.size(); ++i) {
+    read_integer_span(contents, integer_spans[i], integer_arrays[i]);
+  }
+}
+
+} // namespace
+
 ReaderDocument
 ReaderDocument::from_stream(std::istream& stream, const std::string& filename)
 {
@@ -41,13 +68,33 @@ ReaderDocument::from_file(const std::string& filename)
     msg << "Parser problem: Couldn't open file '" << filename << "'.";
     throw std::runtime_error(msg.str());
   } else {
-    return from_stream(in, filename);
+    const std::string contents((std::istreambuf_iterator<char>(in)),
+                               std::istreambuf_iterator<char>());
+
+    sexp::Value sx;
+    std::vector<std::vector<int> > integer_arrays;
+    if (DocumentCache::current()) {
+      sx = DocumentCache::current()->parse(filename, contents, integer_arrays, parse_contents);
+    } else {
+      parse_contents(contents, sx, integer_arrays);
+    }
+
+    return ReaderDocument(filename, std::move(sx), std::move(integer_arrays));
   }
 }
 
 ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx) :
   m_filename(filename),
-  m_sx(std::move(sx))
+  m_sx(std::move(sx)),
+  m_integer_arrays()
+{
+}
+
+ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx,
+                               std::vector<std::vector<int> > integer_arrays) :
+  m_filename(filename),
+  m_sx(std::move(sx)),
+  m_integer_arrays(std::move(integer_arrays))
 {
 }
 
@@ -69,4 +116,50 @@ ReaderDocument::get_directory() const
   return FileSystem::dirname(m_filename);
 }
 
+bool
+ReaderDocument::get_integers(const sexp::Value& sx, std::vector<int>& values) const
+{
+  const std::vector<int>* integers = get_integer_array(sx);
+  if (!integers)
+    return false;
+
+  values.insert(values.end(), integers->begin(), integers->end());
+  return true;
+}
+
+bool
+ReaderDocument::get_integers(const sexp::Value& sx, std::vector<unsigned int>& values) const
+{
+  const std::vector<int>* integers = get_integer_array(sx);
+  if (!integers)
+    return false;
+
+  values.reserve(values.size() + integers->size());
+  for (const int value : *integers) {
+    values.push_back(static_cast<unsigned int>(value));
+  }
+  return true;
+}
+
+const std::vector<int>*
+ReaderDocument::get_integer_array(const sexp::Value& sx) const
+{
+  if (m_integer_arrays.empty() ||
+      !sx.is_array() || sx.as_array().size() != 2)
+    return nullptr;
+
+  const sexp::Value& marker = sx.as_array()[1];
+  if (!marker.is_array() || marker.as_array().size() != 2 ||
+      !marker.as_array()[0].is_symbol() ||
+      marker.as_array()[0].as_string() != INTEGER_SPAN_SYMBOL ||
+      !marker.as_array()[1].is_integer())
+    return nullptr;
+
+  const int index = marker.as_array()[1].as_int();
+  if (index < 0 || static_cast<size_t>(index) >= m_integer_arrays.size())
+    return nullptr;
+
+  return &m_integer_arrays[index];
+}
+
 /* EOF */
@@ -19,6 +19,7 @@
 
 #include <istream>
 #include <sexp/value.hpp>
+#include <vector>
 
 #include "util/reader_object.hpp"
 
@@ -33,6 +34,11 @@ public:
 public:
   ReaderDocument(const std::string& filename, sexp::Value sx);
 
+  /** @c sx was parsed from a text after extract_integer_spans() took
+      the lists in @c integer_arrays out of it */
+  ReaderDocument(const std::string& filename, sexp::Value sx,
+                 std::vector<std::vector<int> > integer_arrays);
+
   /** Returns the root object */
   ReaderObject get_root() const;
 
@@ -44,9 +50,21 @@ public:
 
   const sexp::Value& get_sexp() const { return m_sx; }
 
+  /** If @c sx is (KEY (raw-integers INDEX)), appends the integers
+      taken out of the text there to @c values and returns true */
+  bool get_integers(const sexp::Value& sx, std::vector<int>& values) const;
+  bool get_integers(const sexp::Value& sx, std::vector<unsigned int>& values) const;
+
+private:
+  const std::vector<int>* get_integer_array(const sexp::Value& sx) const;
+
 private:
   std::string m_filename;
   sexp::Value m_sx;
+
+  /** The integer lists taken out of the text, decoded right away so
+      the text doesn't have to be kept around */
+  std::vector<std::vector<int> > m_integer_arrays;
 };
 
 #endif
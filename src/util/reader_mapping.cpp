@@ -65,6 +65,14 @@ ReaderMapping::get_item(const char* key) const
   return nullptr;
 }
 
+template<typename T>
+bool
+ReaderMapping::get_integers(const char* key, std::vector<T>& value) const
+{
+  auto const sx = get_item(key);
+  return sx && m_doc.get_integers(*sx, value);
+}
+
 #define GET_VALUE_MACRO(type, checker, getter)                          \
   auto const sx = get_item(key);                                        \
   if (!sx) {                                                            \
@@ -165,6 +173,8 @@ bool
 ReaderMapping::get(const char* key, std::vector<int>& value) const
 {
   value.clear();
+  if (get_integers(key, value))
+    return true;
   GET_VALUES_MACRO("int", is_integer, as_int);
 }
 
@@ -187,6 +197,8 @@ bool
 ReaderMapping::get(const char* key, std::vector<unsigned int>& value) const
 {
   value.clear();
+  if (get_integers(key, value))
+    return true;
   GET_VALUES_MACRO("unsigned int", is_integer, as_int);
 }
 
@@ -86,6 +86,11 @@ private:
   /** Returns pointer to (key value) */
   const sexp::Value* get_item(const char* key) const;
 
+  /** Reads the integers of (key INT...) if the document left them
+      unparsed */
+  template<typename T>
+  bool get_integers(const char* key, std::vector<T>& value) const;
+
 private:
   const ReaderDocument& m_doc;
   const sexp::Value& m_sx;
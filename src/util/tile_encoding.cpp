@@ -0,0 +1,164 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "util/tile_encoding.hpp"
+
+#include <stdexcept>
+#include <stdint.h>
+
+namespace {
+
+const char BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/** Runs can't be longer than a tilemap has tiles, this only keeps
+    broken data from making us allocate too much memory */
+const uint64_t MAX_TILES = 1u << 28;
+
+void write_varint(std::string& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+uint64_t read_varint(const std::string& data, size_t& pos)
+{
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos >= data.size())
+      throw std::runtime_error("unexpected end of tile data");
+
+    const uint8_t byte = static_cast<uint8_t>(data[pos++]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return value;
+  }
+  throw std::runtime_error("broken tile data");
+}
+
+std::string base64_encode(const std::string& data)
+{
+  std::string out;
+  out.reserve((data.size() + 2) / 3 * 4);
+
+  size_t i = 0;
+  for (; i + 2 < data.size(); i += 3) {
+    const uint32_t bits = (static_cast<uint8_t>(data[i]) << 16) |
+                          (static_cast<uint8_t>(data[i + 1]) << 8) |
+                          static_cast<uint8_t>(data[i + 2]);
+    out += BASE64[(bits >> 18) & 0x3f];
+    out += BASE64[(bits >> 12) & 0x3f];
+    out += BASE64[(bits >> 6) & 0x3f];
+    out += BASE64[bits & 0x3f];
+  }
+
+  const size_t rest = data.size() - i;
+  if (rest > 0) {
+    uint32_t bits = static_cast<uint8_t>(data[i]) << 16;
+    if (rest == 2) {
+      bits |= static_cast<uint8_t>(data[i + 1]) << 8;
+    }
+    out += BASE64[(bits >> 18) & 0x3f];
+    out += BASE64[(bits >> 12) & 0x3f];
+    out += (rest == 2) ? BASE64[(bits >> 6) & 0x3f] : '=';
+    out += '=';
+  }
+
+  return out;
+}
+
+int base64_value(char c)
+{
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+') return 62;
+  if (c == '/') return 63;
+  return -1;
+}
+
+std::string base64_decode(const std::string& text)
+{
+  std::string out;
+  out.reserve(text.size() / 4 * 3);
+
+  uint32_t bits = 0;
+  int count = 0;
+  for (char c : text)
+  {
+    if (c == '=')
+      break;
+
+    // allow the text to be wrapped
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+      continue;
+
+    const int value = base64_value(c);
+    if (value < 0)
+      throw std::runtime_error("invalid character in tile data");
+
+    bits = (bits << 6) | static_cast<uint32_t>(value);
+    count += 6;
+    if (count >= 8) {
+      count -= 8;
+      out += static_cast<char>((bits >> count) & 0xff);
+    }
+  }
+
+  return out;
+}
+
+} // namespace
+
+std::string
+TileEncoding::encode(const std::vector<unsigned int>& tiles)
+{
+  std::string data;
+  for (size_t i = 0; i < tiles.size();)
+  {
+    size_t run = 1;
+    while (i + run < tiles.size() && tiles[i + run] == tiles[i]) {
+      run += 1;
+    }
+    write_varint(data, run);
+    write_varint(data, tiles[i]);
+    i += run;
+  }
+  return base64_encode(data);
+}
+
+void
+TileEncoding::decode(const std::string& text, std::vector<unsigned int>& tiles)
+{
+  tiles.clear();
+
+  const std::string data = base64_decode(text);
+  size_t pos = 0;
+  while (pos < data.size())
+  {
+    const uint64_t run = read_varint(data, pos);
+    const uint64_t tile = read_varint(data, pos);
+    if (run == 0 || tiles.size() + run > MAX_TILES || tile > UINT32_MAX)
+      throw std::runtime_error("broken tile data");
+
+    tiles.insert(tiles.end(), static_cast<size_t>(run), static_cast<unsigned int>(tile));
+  }
+}
+
+/* EOF */
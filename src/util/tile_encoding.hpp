@@ -0,0 +1,39 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_UTIL_TILE_ENCODING_HPP
+#define HEADER_SUPERTUX_UTIL_TILE_ENCODING_HPP
+
+#include <string>
+#include <vector>
+
+/** Compact text form of the tiles of a tilemap: runs of equal tiles
+    stored as pairs of varints (length, tile id), wrapped in base64 so
+    that it fits into a string in a level file */
+class TileEncoding final
+{
+public:
+  static std::string encode(const std::vector<unsigned int>& tiles);
+
+  /** Replaces the contents of @c tiles with the tiles in @c text.
+      Throws std::runtime_error if @c text is broken. */
+  static void decode(const std::string& text, std::vector<unsigned int>& tiles);
+};
+
+#endif
+
+/* EOF */
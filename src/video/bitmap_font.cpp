@@ -35,6 +35,10 @@
 
 namespace {
 
+/** The layout cache is emptied once it holds this many texts, which
+    is plenty for the strings a menu or the HUD draws each frame */
+const size_t MAX_LAYOUTS = 256;
+
 bool vline_empty(const SDLSurfacePtr& surface, int x, int start_y, int end_y, Uint8 threshold)
 {
   Uint8* pixels = static_cast<Uint8*>(surface->pixels);
@@ -263,6 +267,10 @@ BitmapFont::~BitmapFont()
 float
 BitmapFont::get_text_width(const std::string& text) const
 {
+  auto cached = layouts.find(text);
+  if (cached != layouts.end())
+    return cached->second.width;
+
   float curr_width = 0;
   float last_width = 0;
 
@@ -357,88 +365,121 @@ BitmapFont::wrap_to_width(const std::string& s_, float width, std::string* overf
 }
 
 
-void
-BitmapFont::draw_text(Canvas& canvas, const std::string& text,
-                      const Vector& pos_, FontAlignment alignment, int layer, const Color& color)
+const BitmapFont::Layout&
+BitmapFont::get_layout(const std::string& text) const
 {
-  float x = pos_.x;
-  float y = pos_.y;
+  auto cached = layouts.find(text);
+  if (cached != layouts.end())
+    return cached->second;
+
+  if (layouts.size() >= MAX_LAYOUTS) {
+    layouts.clear();
+  }
+
+  Layout& layout = layouts[text];
+  layout.width = 0.0f;
+
+  std::vector<int> batch_of_surface(glyph_surfaces.size(), -1);
 
   std::string::size_type last = 0;
   for (std::string::size_type i = 0;; ++i)
   {
     if (text[i] == '\n' || i == text.size())
     {
-      std::string temp = text.substr(last, i - last);
+      const std::string line = text.substr(last, i - last);
+      const size_t line_idx = layout.line_widths.size();
 
-      // calculate X positions based on the alignment type
-      Vector pos = Vector(x, y);
+      float x = 0.0f;
+      for (UTF8Iterator it(rtl ? std::string(line.rbegin(), line.rend()) : line); !it.done(); ++it)
+      {
+        if (*it == ' ')
+        {
+          x += glyphs[0x20].advance;
+          continue;
+        }
 
-      if (alignment == ALIGN_CENTER)
-        pos.x -= get_text_width(temp) / 2;
-      else if (alignment == ALIGN_RIGHT)
-        pos.x -= get_text_width(temp);
+        const Glyph& glyph = (glyphs.at(*it).surface_idx != -1) ? glyphs[*it] : glyphs[0x20];
+        if (glyph.surface_idx >= 0)
+        {
+          int& batch_idx = batch_of_surface[glyph.surface_idx];
+          if (batch_idx < 0)
+          {
+            batch_idx = static_cast<int>(layout.batches.size());
+            layout.batches.push_back(LayoutBatch());
+            layout.batches.back().surface_idx = glyph.surface_idx;
+          }
+          LayoutBatch& batch = layout.batches[batch_idx];
+
+          const Rect region = glyph_surfaces[glyph.surface_idx]->get_region();
+          const Rect shadow_region = shadow_surfaces[glyph.surface_idx]->get_region();
+          batch.srcrects.push_back(glyph.rect.moved(Vector(static_cast<float>(region.left),
+                                                           static_cast<float>(region.top))));
+          batch.shadow_srcrects.push_back(glyph.rect.moved(Vector(static_cast<float>(shadow_region.left),
+                                                                  static_cast<float>(shadow_region.top))));
+          batch.dstrects.push_back(Rectf(Vector(x, 0.0f) + glyph.offset, glyph.rect.get_size()));
+          batch.lines.push_back(line_idx);
+        }
 
-      // Cast font position to integer to get a clean drawing result and
-      // no blurring as we would get with subpixel positions
-      pos.x = std::truncf(pos.x);
+        x += glyph.advance;
+      }
 
-      draw_text(canvas, temp, pos, layer, color);
+      layout.line_widths.push_back(x);
+      layout.width = std::max(layout.width, x);
 
       if (i == text.size())
         break;
 
-      y += static_cast<float>(char_height) + 2.0f;
       last = i + 1;
     }
   }
+
+  return layout;
 }
 
 void
-BitmapFont::draw_text(Canvas& canvas, const std::string& text, const Vector& pos, int layer, Color color) const
+BitmapFont::draw_text(Canvas& canvas, const std::string& text,
+                      const Vector& pos, FontAlignment alignment, int layer, const Color& color)
 {
-  if (shadowsize > 0)
-    draw_chars(canvas, false, rtl ? std::string(text.rbegin(), text.rend()) : text,
-               pos + Vector(static_cast<float>(shadowsize), static_cast<float>(shadowsize)), layer,
-               Color(1,1,1));
+  const Layout& layout = get_layout(text);
 
-  draw_chars(canvas, true, rtl ? std::string(text.rbegin(), text.rend()) : text, pos, layer, color);
-}
+  std::vector<Vector> line_positions;
+  line_positions.reserve(layout.line_widths.size());
+  for (size_t i = 0; i < layout.line_widths.size(); ++i)
+  {
+    // calculate X positions based on the alignment type
+    Vector line_pos(pos.x, pos.y + static_cast<float>(i) * (static_cast<float>(char_height) + 2.0f));
 
-void
-BitmapFont::draw_chars(Canvas& canvas, bool notshadow, const std::string& text, const Vector& pos, int layer, Color color) const
-{
-  Vector p = pos;
+    if (alignment == ALIGN_CENTER)
+      line_pos.x -= layout.line_widths[i] / 2;
+    else if (alignment == ALIGN_RIGHT)
+      line_pos.x -= layout.line_widths[i];
 
-  for (UTF8Iterator it(text); !it.done(); ++it)
+    // Cast font position to integer to get a clean drawing result and
+    // no blurring as we would get with subpixel positions
+    line_pos.x = std::truncf(line_pos.x);
+
+    line_positions.push_back(line_pos);
+  }
+
+  const Vector shadow_offset(static_cast<float>(shadowsize), static_cast<float>(shadowsize));
+  for (int pass = (shadowsize > 0) ? 0 : 1; pass < 2; ++pass)
   {
-    if (*it == '\n')
-    {
-      p.x = pos.x;
-      p.y += static_cast<float>(char_height) + 2.0f;
-    }
-    else if (*it == ' ')
+    const bool shadow = (pass == 0);
+    for (const auto& batch : layout.batches)
     {
-      p.x += glyphs[0x20].advance;
-    }
-    else
-    {
-      Glyph glyph;
-      if ( glyphs.at(*it).surface_idx != -1 )
-        glyph = glyphs[*it];
-      else
-        glyph = glyphs[0x20];
-
-      // FIXME: not supported! request.color = color;
-      canvas.draw_surface_part(notshadow ?
-                               glyph_surfaces[glyph.surface_idx] :
-                               shadow_surfaces[glyph.surface_idx],
-                               glyph.rect,
-                               Rectf(p + glyph.offset, glyph.rect.get_size()),
-                               layer,
-                               PaintStyle().set_color(color));
-
-      p.x += glyph.advance;
+      std::vector<Rectf> dstrects;
+      dstrects.reserve(batch.dstrects.size());
+      for (size_t i = 0; i < batch.dstrects.size(); ++i)
+      {
+        const Vector offset = line_positions[batch.lines[i]];
+        dstrects.push_back(batch.dstrects[i].moved(shadow ? offset + shadow_offset : offset));
+      }
+
+      canvas.draw_surface_batch(shadow ? shadow_surfaces[batch.surface_idx] : glyph_surfaces[batch.surface_idx],
+                                shadow ? batch.shadow_srcrects : batch.srcrects,
+                                std::move(dstrects),
+                                shadow ? Color(1, 1, 1) : color,
+                                layer);
     }
   }
 }
@@ -19,6 +19,8 @@
 #define HEADER_SUPERTUX_VIDEO_BITMAP_FONT_HPP
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "math/rectf.hpp"
 #include "math/vector.hpp"
@@ -78,11 +80,10 @@ public:
 private:
   friend class DrawingContext;
 
-  void draw_text(Canvas& painter, const std::string& text, const Vector& pos, int layer,
-                 Color color = Color(1.0,1.0,1.0)) const;
+  struct Layout;
 
-  void draw_chars(Canvas& painter, bool nonshadow, const std::string& text,
-                  const Vector& position, int layer, Color color) const;
+  /** Returns the cached layout of @c text, creating it if needed */
+  const Layout& get_layout(const std::string& text) const;
 
   void loadFontFile(const std::string &filename);
   void loadFontSurface(const std::string &glyphimage,
@@ -113,6 +114,31 @@ private:
     {}
   };
 
+  /** The glyphs of one glyph surface within a Layout */
+  struct LayoutBatch
+  {
+    int surface_idx;
+
+    /** In texture coordinates of the glyph and the shadow surface */
+    std::vector<Rectf> srcrects;
+    std::vector<Rectf> shadow_srcrects;
+
+    /** Relative to the start of the line the glyph is on */
+    std::vector<Rectf> dstrects;
+    std::vector<size_t> lines;
+  };
+
+  /** The placed glyphs of a text, so that drawing it again needs
+      neither measuring nor walking the UTF-8. Alignment is applied
+      per line when drawing, as the line start is rounded to whole
+      pixels at its final position. */
+  struct Layout
+  {
+    std::vector<float> line_widths;
+    float width;
+    std::vector<LayoutBatch> batches;
+  };
+
 private:
   GlyphWidth glyph_width;
 
@@ -125,6 +151,9 @@ private:
 
   /** 65536 of glyphs */
   std::vector<Glyph> glyphs;
+
+  /** Layouts of the texts drawn or measured recently */
+  mutable std::unordered_map<std::string, Layout> layouts;
 };
 
 #endif
@@ -21,16 +21,69 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "util/obstackpp.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
+#include "video/retained_batch.hpp"
 #include "video/surface.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** How many draw calls back a texture request may be moved to merge
+    it with an earlier one */
+const size_t MAX_MERGE_DISTANCE = 16;
+
+bool can_merge(const TextureRequest& lhs, const TextureRequest& rhs)
+{
+  return lhs.layer == rhs.layer &&
+         lhs.texture == rhs.texture &&
+         lhs.displacement_texture == rhs.displacement_texture &&
+         lhs.flip == rhs.flip &&
+         lhs.alpha == rhs.alpha &&
+         lhs.blend == rhs.blend &&
+         lhs.color == rhs.color;
+}
+
+/** Returns the area a texture request draws to */
+Rectf get_bounds(const TextureRequest& request)
+{
+  Rectf bounds = request.dstrects.front();
+  for (size_t i = 0; i < request.dstrects.size(); ++i)
+  {
+    Rectf rect = request.dstrects[i];
+    if (request.angles[i] != 0.0f)
+    {
+      // any rotation stays within the circle around the corners
+      const float radius = rect.get_size().as_vector().norm() / 2.0f;
+      rect = Rectf(rect.get_middle() - Vector(radius, radius),
+                   rect.get_middle() + Vector(radius, radius));
+    }
+
+    bounds = Rectf(std::min(bounds.get_left(), rect.get_left()),
+                   std::min(bounds.get_top(), rect.get_top()),
+                   std::max(bounds.get_right(), rect.get_right()),
+                   std::max(bounds.get_bottom(), rect.get_bottom()));
+  }
+  return bounds;
+}
+
+bool overlaps(const Rectf& lhs, const Rectf& rhs)
+{
+  return !(lhs.get_right() < rhs.get_left() || lhs.get_left() > rhs.get_right() ||
+           lhs.get_bottom() < rhs.get_top() || lhs.get_top() > rhs.get_bottom());
+}
+
+} // namespace
+
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_merged(false),
+  m_request_count(0),
+  m_draw_call_count(0)
 {
 }
 
@@ -47,10 +100,14 @@ Canvas::clear()
     request->~DrawingRequest();
   }
   m_requests.clear();
+
+  m_merged = false;
+  m_request_count = 0;
+  m_draw_call_count = 0;
 }
 
 void
-Canvas::render(Renderer& renderer, Filter filter)
+Canvas::merge_requests()
 {
   // On a regular level, each frame has around 50-250 requests (before
   // batching it was 1000-3000), the sort comparator function is
@@ -60,6 +117,85 @@ Canvas::render(Renderer& renderer, Filter filter)
                      return r1->layer < r2->layer;
                    });
 
+  m_request_count = static_cast<int>(m_requests.size());
+
+  // A texture request is appended to an earlier compatible one on the
+  // same layer if none of the requests drawn in between overlaps it,
+  // so that moving it back doesn't change the picture. Requests other
+  // than plain textures are never moved past.
+  std::vector<DrawingRequest*> merged;
+  std::vector<Rectf> bounds;
+  merged.reserve(m_requests.size());
+  bounds.reserve(m_requests.size());
+
+  for (auto* request : m_requests)
+  {
+    if (request->type != TEXTURE)
+    {
+      merged.push_back(request);
+      bounds.emplace_back();
+      continue;
+    }
+
+    auto& texture_request = static_cast<TextureRequest&>(*request);
+    if (texture_request.dstrects.empty())
+    {
+      // nothing to draw
+      request->~DrawingRequest();
+      continue;
+    }
+
+    const Rectf request_bounds = get_bounds(texture_request);
+
+    bool done = false;
+    for (size_t i = merged.size(); i-- > 0 && merged.size() - i <= MAX_MERGE_DISTANCE;)
+    {
+      if (merged[i]->type != TEXTURE || merged[i]->layer != request->layer)
+        break;
+
+      auto& target = static_cast<TextureRequest&>(*merged[i]);
+      if (can_merge(target, texture_request))
+      {
+        target.srcrects.insert(target.srcrects.end(), texture_request.srcrects.begin(), texture_request.srcrects.end());
+        target.dstrects.insert(target.dstrects.end(), texture_request.dstrects.begin(), texture_request.dstrects.end());
+        target.angles.insert(target.angles.end(), texture_request.angles.begin(), texture_request.angles.end());
+
+        const Rectf& target_bounds = bounds[i];
+        bounds[i] = Rectf(std::min(target_bounds.get_left(), request_bounds.get_left()),
+                          std::min(target_bounds.get_top(), request_bounds.get_top()),
+                          std::max(target_bounds.get_right(), request_bounds.get_right()),
+                          std::max(target_bounds.get_bottom(), request_bounds.get_bottom()));
+
+        request->~DrawingRequest();
+        done = true;
+        break;
+      }
+
+      if (overlaps(bounds[i], request_bounds))
+        break;
+    }
+
+    if (!done)
+    {
+      merged.push_back(request);
+      bounds.push_back(request_bounds);
+    }
+  }
+
+  m_requests = std::move(merged);
+  m_draw_call_count = static_cast<int>(m_requests.size());
+  m_merged = true;
+}
+
+void
+Canvas::render(Renderer& renderer, Filter filter)
+{
+  PROFILE_SCOPE("Canvas::render");
+
+  if (!m_merged) {
+    merge_requests();
+  }
+
   Painter& painter = renderer.get_painter();
 
   for (const auto& i : m_requests) {
@@ -75,6 +211,10 @@ Canvas::render(Renderer& renderer, Filter filter)
         painter.draw_texture(static_cast<const TextureRequest&>(request));
         break;
 
+      case RETAINED_TEXTURE:
+        painter.draw_retained_texture(static_cast<const RetainedTextureRequest&>(request));
+        break;
+
       case GRADIENT:
         painter.draw_gradient(static_cast<const GradientRequest&>(request));
         break;
@@ -100,6 +240,8 @@ Canvas::render(Renderer& renderer, Filter filter)
         break;
     }
   }
+
+  painter.flush_pixel_requests();
 }
 
 void
@@ -166,7 +308,9 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
   request->alpha = m_context.transform().alpha * style.get_alpha();
   request->blend = style.get_blend();
 
-  request->srcrects.emplace_back(srcrect);
+  const Rect region = surface->get_region();
+  request->srcrects.emplace_back(srcrect.moved(Vector(static_cast<float>(region.left),
+                                                      static_cast<float>(region.top))));
   request->dstrects.emplace_back(apply_translate(dstrect.p1())*scale(), dstrect.get_size()*scale());
   request->angles.emplace_back(0.0f);
   request->texture = surface->get_texture().get();
@@ -224,6 +368,27 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   m_requests.push_back(request);
 }
 
+void
+Canvas::draw_retained_batch(const RetainedBatch& batch, const Vector& pos,
+                            const Color& color, int layer)
+{
+  if (batch.size() == 0) return;
+
+  auto request = new(m_obst) RetainedTextureRequest();
+
+  request->type = RETAINED_TEXTURE;
+  request->layer = layer;
+  request->flip = m_context.transform().flip ^ batch.get_flip();
+  request->alpha = m_context.transform().alpha;
+  request->color = color;
+
+  request->batch = &batch;
+  request->offset = apply_translate(pos) * scale();
+  request->scale = scale();
+
+  m_requests.push_back(request);
+}
+
 void
 Canvas::draw_text(const FontPtr& font, const std::string& text,
                   const Vector& pos, FontAlignment alignment, int layer, const Color& color)
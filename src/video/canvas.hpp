@@ -37,6 +37,7 @@
 
 class DrawingContext;
 class Renderer;
+class RetainedBatch;
 class VideoSystem;
 struct DrawingRequest;
 
@@ -52,10 +53,13 @@ public:
   void draw_surface(const SurfacePtr& surface, const Vector& position, int layer);
   void draw_surface(const SurfacePtr& surface, const Vector& position, float angle, const Color& color, const Blend& blend,
                     int layer);
+  /** @c srcrect is relative to the top left corner of @c surface */
   void draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const Rectf& dstrect,
                          int layer, const PaintStyle& style = PaintStyle());
   void draw_surface_scaled(const SurfacePtr& surface, const Rectf& dstrect,
                            int layer, const PaintStyle& style = PaintStyle());
+  /** Unlike in draw_surface_part(), the @c srcrects are in texture
+      coordinates, see Surface::get_region() */
   void draw_surface_batch(const SurfacePtr& surface,
                           std::vector<Rectf> srcrects,
                           std::vector<Rectf> dstrects,
@@ -67,6 +71,10 @@ public:
                           std::vector<float> angles,
                           const Color& color,
                           int layer);
+  /** Draws @c batch moved by @c pos, @c batch has to stay alive until
+      the canvas is rendered */
+  void draw_retained_batch(const RetainedBatch& batch, const Vector& pos,
+                           const Color& color, int layer);
   void draw_text(const FontPtr& font, const std::string& text,
                  const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
   /** Draw text to the center of the screen */
@@ -90,15 +98,34 @@ public:
 
   DrawingContext& get_context() { return m_context; }
 
+  /** Number of requests drawn to the canvas since the last clear(),
+      and the number of draw calls left after merging them */
+  int get_request_count() const { return m_request_count; }
+  int get_draw_call_count() const { return m_draw_call_count; }
+
+  /** Number of requests drawn to the canvas so far this frame */
+  size_t get_pending_request_count() const { return m_requests.size(); }
+
 private:
   Vector apply_translate(const Vector& pos) const;
   float scale() const;
 
+  /** Sorts the requests by layer and merges texture requests that
+      can be drawn with a single draw call, see canvas.cpp */
+  void merge_requests();
+
 private:
   DrawingContext& m_context;
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
 
+  /** True once merge_requests() ran, render() can be called several
+      times per frame */
+  bool m_merged;
+
+  int m_request_count;
+  int m_draw_call_count;
+
 private:
   Canvas(const Canvas&) = delete;
   Canvas& operator=(const Canvas&) = delete;
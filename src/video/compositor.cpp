@@ -18,12 +18,16 @@
 #include "video/compositor.hpp"
 
 #include "math/rect.hpp"
+#include "util/profiler.hpp"
+#include "video/drawing_context.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
 #include "video/video_system.hpp"
 
 bool Compositor::s_render_lighting = true;
+int Compositor::s_last_request_count = 0;
+int Compositor::s_last_draw_call_count = 0;
 
 Compositor::Compositor(VideoSystem& video_system) :
   m_video_system(video_system),
@@ -49,6 +53,8 @@ Compositor::make_context(bool overlay)
 void
 Compositor::render()
 {
+  PROFILE_SCOPE("Compositor::render");
+
   auto& lightmap = m_video_system.get_lightmap();
 
   bool use_lightmap = std::any_of(m_drawing_contexts.begin(), m_drawing_contexts.end(),
@@ -146,6 +152,17 @@ Compositor::render()
     renderer.end_draw();
   }
 
+  s_last_request_count = 0;
+  s_last_draw_call_count = 0;
+  for (auto& ctx : m_drawing_contexts)
+  {
+    for (Canvas* canvas : { &ctx->color(), &ctx->light() })
+    {
+      s_last_request_count += canvas->get_request_count();
+      s_last_draw_call_count += canvas->get_draw_call_count();
+    }
+  }
+
   // cleanup
   for (auto& ctx : m_drawing_contexts)
   {
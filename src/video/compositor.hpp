@@ -32,6 +32,11 @@ public:
   /** Debug flag to disable lighting, used in the editor */
   static bool s_render_lighting;
 
+  /** Number of drawing requests of the last frame and the number of
+      draw calls left after Canvas merged them, shown with the FPS */
+  static int s_last_request_count;
+  static int s_last_draw_call_count;
+
 public:
   Compositor(VideoSystem& video_system);
   ~Compositor();
@@ -27,11 +27,12 @@
 #include "video/drawing_context.hpp"
 #include "video/font.hpp"
 
+class RetainedBatch;
 class Surface;
 
 enum RequestType
 {
-  TEXTURE, GRADIENT, FILLRECT, INVERSEELLIPSE, GETPIXEL, LINE, TRIANGLE
+  TEXTURE, RETAINED_TEXTURE, GRADIENT, FILLRECT, INVERSEELLIPSE, GETPIXEL, LINE, TRIANGLE
 };
 
 struct DrawingRequest
@@ -78,6 +79,30 @@ private:
   TextureRequest& operator=(const TextureRequest&) = delete;
 };
 
+struct RetainedTextureRequest : public DrawingRequest
+{
+  RetainedTextureRequest() :
+    DrawingRequest(RETAINED_TEXTURE),
+    batch(),
+    offset(),
+    scale(1.0f),
+    color(1.0f, 1.0f, 1.0f)
+  {}
+
+  /** The batch has to stay alive until the request is rendered */
+  const RetainedBatch* batch;
+
+  /** The rectangles of the batch are scaled by scale and then moved
+      by offset */
+  Vector offset;
+  float scale;
+  Color color;
+
+private:
+  RetainedTextureRequest(const RetainedTextureRequest&) = delete;
+  RetainedTextureRequest& operator=(const RetainedTextureRequest&) = delete;
+};
+
 struct GradientRequest : public DrawingRequest
 {
   GradientRequest()  :
@@ -19,11 +19,13 @@
 #include "supertux/globals.hpp"
 #include "video/glutil.hpp"
 #include "video/color.hpp"
+#include "video/gl/gl_retained_buffers.hpp"
 #include "video/gl/gl_texture.hpp"
 
 #ifndef USE_OPENGLES2
 
-GL20Context::GL20Context()
+GL20Context::GL20Context() :
+  m_vertices()
 {
   assert_gl();
 }
@@ -92,6 +94,21 @@ GL20Context::set_positions(const float* data, size_t size)
   assert_gl();
 }
 
+void
+GL20Context::set_vertices(const float* data, size_t size)
+{
+  assert_gl();
+
+  const GLsizei stride = 4 * sizeof(float);
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(2, GL_FLOAT, stride, data);
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glTexCoordPointer(2, GL_FLOAT, stride, data + 2);
+
+  assert_gl();
+}
+
 void
 GL20Context::set_texcoords(const float* data, size_t size)
 {
@@ -188,6 +205,24 @@ GL20Context::draw_arrays(GLenum type, GLint first, GLsizei count)
   assert_gl();
 }
 
+void
+GL20Context::draw_retained_batch(const RetainedBatch& batch, const Vector& offset, float scale)
+{
+  assert_gl();
+
+  m_vertices.clear();
+  GLRetainedBuffers::build_vertices(batch, m_vertices);
+  set_vertices(m_vertices.data(), sizeof(float) * m_vertices.size());
+
+  glPushMatrix();
+  glTranslatef(offset.x, offset.y, 0.0f);
+  glScalef(scale, scale, 1.0f);
+  glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size() / 4));
+  glPopMatrix();
+
+  assert_gl();
+}
+
 #endif
 
 /* EOF */
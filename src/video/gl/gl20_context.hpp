@@ -19,6 +19,8 @@
 
 #include "video/gl/gl_context.hpp"
 
+#include <vector>
+
 #ifndef USE_OPENGLES2
 
 class GL20Context final : public GLContext
@@ -35,7 +37,10 @@ public:
 
   virtual void blend_func(GLenum src, GLenum dst) override;
 
+  virtual void reserve_arrays(size_t ) override {}
+
   virtual void set_positions(const float* data, size_t size) override;
+  virtual void set_vertices(const float* data, size_t size) override;
 
   virtual void set_texcoords(const float* data, size_t size) override;
   virtual void set_texcoord(float u, float v) override;
@@ -47,9 +52,17 @@ public:
   virtual void bind_no_texture() override;
 
   virtual void draw_arrays(GLenum type, GLint first, GLsizei count) override;
+  virtual void draw_retained_batch(const RetainedBatch& batch, const Vector& offset, float scale) override;
+
+  virtual void end_frame() override {}
 
   virtual bool supports_framebuffer() const override { return false; }
 
+private:
+  /** Vertices of the last retained batch, there are no buffer
+      objects to keep them in */
+  std::vector<float> m_vertices;
+
 private:
   GL20Context(const GL20Context&) = delete;
   GL20Context& operator=(const GL20Context&) = delete;
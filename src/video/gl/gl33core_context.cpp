@@ -16,9 +16,13 @@
 
 #include "video/gl/gl33core_context.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 #include "supertux/globals.hpp"
 #include "video/color.hpp"
 #include "video/gl/gl_program.hpp"
+#include "video/gl/gl_retained_buffers.hpp"
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_texture_renderer.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
@@ -29,15 +33,18 @@ GL33CoreContext::GL33CoreContext(GLVideoSystem& video_system) :
   m_video_system(video_system),
   m_program(),
   m_vertex_arrays(),
+  m_retained_buffers(),
   m_white_texture(),
   m_black_texture(),
   m_grey_texture(),
-  m_transparent_texture()
+  m_transparent_texture(),
+  m_mvp_matrix()
 {
   assert_gl();
 
   m_program.reset(new GLProgram);
   m_vertex_arrays.reset(new GLVertexArrays(*this));
+  m_retained_buffers.reset(new GLRetainedBuffers(*this));
   m_white_texture.reset(new GLTexture(1, 1, Color::WHITE));
   m_black_texture.reset(new GLTexture(1, 1, Color::BLACK));
   m_grey_texture.reset(new GLTexture(1, 1, Color::from_rgba8888(128, 128, 0, 0)));
@@ -127,9 +134,10 @@ GL33CoreContext::ortho(float width, float height, bool vflip)
     0, sy, ty,
     0, 0, 1
   };
+  std::copy(std::begin(mvp_matrix), std::end(mvp_matrix), m_mvp_matrix);
 
   const GLint mvp_loc = m_program->get_uniform_location("modelviewprojection");
-  glUniformMatrix3fv(mvp_loc, 1, false, mvp_matrix);
+  glUniformMatrix3fv(mvp_loc, 1, false, m_mvp_matrix);
 
   assert_gl();
 }
@@ -144,12 +152,24 @@ GL33CoreContext::blend_func(GLenum src, GLenum dst)
   assert_gl();
 }
 
+void
+GL33CoreContext::reserve_arrays(size_t size)
+{
+  m_vertex_arrays->reserve(size);
+}
+
 void
 GL33CoreContext::set_positions(const float* data, size_t size)
 {
   m_vertex_arrays->set_positions(data, size);
 }
 
+void
+GL33CoreContext::set_vertices(const float* data, size_t size)
+{
+  m_vertex_arrays->set_vertices(data, size);
+}
+
 void
 GL33CoreContext::set_texcoords(const float* data, size_t size)
 {
@@ -244,4 +264,35 @@ GL33CoreContext::draw_arrays(GLenum type, GLint first, GLsizei count)
   assert_gl();
 }
 
+void
+GL33CoreContext::draw_retained_batch(const RetainedBatch& batch, const Vector& offset, float scale)
+{
+  assert_gl();
+
+  const GLsizei count = m_retained_buffers->bind(batch);
+
+  // move the batch into place through the projection instead of
+  // touching its vertices
+  const float* m = m_mvp_matrix;
+  const float mvp_matrix[] = {
+    m[0] * scale, 0, m[0] * offset.x + m[2],
+    0, m[4] * scale, m[4] * offset.y + m[5],
+    0, 0, 1
+  };
+
+  const GLint mvp_loc = m_program->get_uniform_location("modelviewprojection");
+  glUniformMatrix3fv(mvp_loc, 1, false, mvp_matrix);
+  glDrawArrays(GL_TRIANGLES, 0, count);
+  glUniformMatrix3fv(mvp_loc, 1, false, m_mvp_matrix);
+
+  assert_gl();
+}
+
+void
+GL33CoreContext::end_frame()
+{
+  m_vertex_arrays->next_frame();
+  m_retained_buffers->collect_garbage();
+}
+
 /* EOF */
@@ -22,6 +22,7 @@
 #include <memory>
 
 class GLProgram;
+class GLRetainedBuffers;
 class GLTexture;
 class GLVertexArrays;
 class GLVideoSystem;
@@ -40,7 +41,10 @@ public:
 
   virtual void blend_func(GLenum src, GLenum dst) override;
 
+  virtual void reserve_arrays(size_t size) override;
+
   virtual void set_positions(const float* data, size_t size) override;
+  virtual void set_vertices(const float* data, size_t size) override;
 
   virtual void set_texcoords(const float* data, size_t size) override;
   virtual void set_texcoord(float u, float v) override;
@@ -51,6 +55,9 @@ public:
   virtual void bind_texture(const Texture& texture, const Texture* displacement_texture) override;
   virtual void bind_no_texture() override;
   virtual void draw_arrays(GLenum type, GLint first, GLsizei count) override;
+  virtual void draw_retained_batch(const RetainedBatch& batch, const Vector& offset, float scale) override;
+
+  virtual void end_frame() override;
 
   virtual bool supports_framebuffer() const override { return true; }
 
@@ -62,11 +69,15 @@ private:
   GLVideoSystem& m_video_system;
   std::unique_ptr<GLProgram> m_program;
   std::unique_ptr<GLVertexArrays> m_vertex_arrays;
+  std::unique_ptr<GLRetainedBuffers> m_retained_buffers;
   std::unique_ptr<GLTexture> m_white_texture;
   std::unique_ptr<GLTexture> m_black_texture;
   std::unique_ptr<GLTexture> m_grey_texture;
   std::unique_ptr<GLTexture> m_transparent_texture;
 
+  /** The projection set by ortho() */
+  float m_mvp_matrix[3*3];
+
 private:
   GL33CoreContext(const GL33CoreContext&) = delete;
   GL33CoreContext& operator=(const GL33CoreContext&) = delete;
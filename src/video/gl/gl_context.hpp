@@ -24,7 +24,9 @@
 
 class Color;
 class GLTexture;
+class RetainedBatch;
 class Texture;
+class Vector;
 
 class GLContext
 {
@@ -40,8 +42,16 @@ public:
 
   virtual void blend_func(GLenum src, GLenum dst) = 0;
 
+  /** Makes room for @c size bytes of vertex data, to be called before
+      setting the arrays of a draw call that uses more than one
+      array */
+  virtual void reserve_arrays(size_t size) = 0;
+
   virtual void set_positions(const float* data, size_t size) = 0;
 
+  /** Sets interleaved position and texcoord, size is in bytes */
+  virtual void set_vertices(const float* data, size_t size) = 0;
+
   virtual void set_texcoords(const float* data, size_t size) = 0;
   virtual void set_texcoord(float u, float v) = 0;
 
@@ -53,6 +63,13 @@ public:
 
   virtual void draw_arrays(GLenum type, GLint first, GLsizei count) = 0;
 
+  /** Draws the rectangles of @c batch scaled by @c scale and moved by
+      @c offset, with the texture and color that are currently set */
+  virtual void draw_retained_batch(const RetainedBatch& batch, const Vector& offset, float scale) = 0;
+
+  /** Called once per frame before the window is flipped */
+  virtual void end_frame() = 0;
+
   virtual bool supports_framebuffer() const = 0;
 
 private:
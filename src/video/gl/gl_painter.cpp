@@ -17,7 +17,9 @@
 #include "video/gl/gl_painter.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <math.h>
+#include <string.h>
 
 #include "math/util.hpp"
 #include "supertux/globals.hpp"
@@ -30,11 +32,16 @@
 #include "video/gl/gl_vertex_arrays.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
+#include "video/retained_batch.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
 namespace {
 
+/** Number of batches of pixels that can be in flight at once, a
+    batch is delivered at the latest when its slot comes up again */
+const size_t PIXEL_REQUEST_RING = 3;
+
 inline std::tuple<GLenum, GLenum> blend_factor(Blend blend)
 {
   using B = std::tuple<GLenum, GLenum>;
@@ -61,7 +68,14 @@ inline GLenum dfactor(Blend blend)
 
 GLPainter::GLPainter(GLVideoSystem& video_system, GLRenderer& renderer) :
   m_video_system(video_system),
-  m_renderer(renderer)
+  m_renderer(renderer),
+  m_vertices(),
+#ifndef USE_OPENGLES2
+  m_pixel_requests(),
+  m_next_pixel_request(0),
+  m_use_fences(false),
+#endif
+  m_pixels()
 {
 }
 
@@ -75,8 +89,10 @@ GLPainter::draw_texture(const TextureRequest& request)
   assert(request.srcrects.size() == request.dstrects.size());
   assert(request.srcrects.size() == request.angles.size());
 
-  std::vector<float> vertices;
-  std::vector<float> uvs;
+  // reused between requests to save the allocations
+  std::vector<float>& vertices = m_vertices;
+  vertices.clear();
+
   for (size_t i = 0; i < request.srcrects.size(); ++i)
   {
     const float left = request.dstrects[i].get_left();
@@ -97,27 +113,16 @@ GLPainter::draw_texture(const TextureRequest& request)
 
     if (request.angles[i] == 0.0f)
     {
-      auto vertices_lst = {
-        left, top,
-        right, top,
-        right, bottom,
-
-        left, bottom,
-        left, top,
-        right, bottom,
-      };
-      vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
-
-      auto uvs_lst = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
+      const float vertices_lst[] = {
+        left, top, uv_left, uv_top,
+        right, top, uv_right, uv_top,
+        right, bottom, uv_right, uv_bottom,
 
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
+        left, bottom, uv_left, uv_bottom,
+        left, top, uv_left, uv_top,
+        right, bottom, uv_right, uv_bottom,
       };
-      uvs.insert(uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
+      vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
     }
     else
     {
@@ -135,26 +140,15 @@ GLPainter::draw_texture(const TextureRequest& request)
       const float new_bottom = bottom - center_y;
 
       const float vertices_lst[] = {
-        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
-        new_right*ca - new_top*sa + center_x, new_right*sa + new_top*ca + center_y,
-        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
+        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y, uv_left, uv_top,
+        new_right*ca - new_top*sa + center_x, new_right*sa + new_top*ca + center_y, uv_right, uv_top,
+        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y, uv_right, uv_bottom,
 
-        new_left*ca - new_bottom*sa + center_x, new_left*sa + new_bottom*ca + center_y,
-        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
-        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
+        new_left*ca - new_bottom*sa + center_x, new_left*sa + new_bottom*ca + center_y, uv_left, uv_bottom,
+        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y, uv_left, uv_top,
+        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y, uv_right, uv_bottom,
       };
       vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
-
-      const float uvs_lst[] = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
-
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
-      };
-      uvs.insert(uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
     }
   }
 
@@ -162,8 +156,7 @@ GLPainter::draw_texture(const TextureRequest& request)
 
   context.blend_func(sfactor(request.blend), dfactor(request.blend));
   context.bind_texture(texture, request.displacement_texture);
-  context.set_texcoords(uvs.data(), sizeof(float) * uvs.size());
-  context.set_positions(vertices.data(), sizeof(float) * vertices.size());
+  context.set_vertices(vertices.data(), sizeof(float) * vertices.size());
   context.set_color(Color(request.color.red,
                           request.color.green,
                           request.color.blue,
@@ -174,6 +167,33 @@ GLPainter::draw_texture(const TextureRequest& request)
   assert_gl();
 }
 
+void
+GLPainter::draw_retained_texture(const RetainedTextureRequest& request)
+{
+  // the retained vertices don't know about flipping
+  if (request.flip != NO_FLIP) {
+    Painter::draw_retained_texture(request);
+    return;
+  }
+
+  assert_gl();
+
+  const RetainedBatch& batch = *request.batch;
+
+  GLContext& context = m_video_system.get_context();
+
+  context.blend_func(sfactor(request.blend), dfactor(request.blend));
+  context.bind_texture(*batch.get_texture(), batch.get_displacement_texture().get());
+  context.set_color(Color(request.color.red,
+                          request.color.green,
+                          request.color.blue,
+                          request.color.alpha * request.alpha));
+
+  context.draw_retained_batch(batch, request.offset, request.scale);
+
+  assert_gl();
+}
+
 void
 GLPainter::draw_gradient(const GradientRequest& request)
 {
@@ -195,6 +215,7 @@ GLPainter::draw_gradient(const GradientRequest& request)
 
   context.blend_func(sfactor(request.blend), dfactor(request.blend));
   context.bind_no_texture();
+  context.reserve_arrays(sizeof(vertices) + 4 * 4 * sizeof(float));
   context.set_positions(vertices, sizeof(vertices));
   context.set_texcoord(0.0f, 0.0f);
 
@@ -253,7 +274,8 @@ GLPainter::draw_filled_rect(const FillRectRequest& request)
 
     const int n = 8;
     size_t p = 0;
-    std::vector<float> vertices((n+1) * 4 * 2);
+    std::vector<float>& vertices = m_vertices;
+    vertices.resize((n+1) * 4 * 2);
 
     for (int i = 0; i <= n; ++i)
     {
@@ -468,10 +490,8 @@ GLPainter::clear(const Color& color)
 }
 
 void
-GLPainter::get_pixel(const GetPixelRequest& request) const
+GLPainter::get_pixel(const GetPixelRequest& request)
 {
-  assert_gl();
-
   const Rect& rect = m_renderer.get_rect();
   const Size& logical_size = m_renderer.get_logical_size();
 
@@ -481,26 +501,71 @@ GLPainter::get_pixel(const GetPixelRequest& request) const
   x += static_cast<float>(rect.left);
   y += static_cast<float>(rect.top);
 
-#if 0
-  // #ifndef USE_OPENGLES2
-  //
-  // FIXME: glFenceSync() causes crashes on Intel I965, so disable
-  // GLPixelRequest for now, it's not yet properly used anyway.
-  GLPixelRequest pixel_request(1, 1);
-  pixel_request.request(static_cast<int>(x), static_cast<int>(y));
+  m_pixels.push_back({ static_cast<GLint>(x), static_cast<GLint>(y), request.color_ptr });
+}
+
+void
+GLPainter::flush_pixel_requests()
+{
+  assert_gl();
+
+#ifndef USE_OPENGLES2
+  // OpenGLES2 and the OpenGL 2.0 fallback do not have PBOs
+  if (m_video_system.use_opengl33core())
+  {
+    if (m_pixel_requests.empty())
+    {
+      // glFenceSync() causes crashes on Intel I965, so batches are
+      // only delivered when their slot in the ring comes up again
+      const auto* vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+      m_use_fences = !vendor || strcmp(vendor, "Intel Open Source Technology Center") != 0;
+
+      for (size_t i = 0; i < PIXEL_REQUEST_RING; ++i) {
+        m_pixel_requests.push_back(std::make_unique<GLPixelRequest>());
+      }
+    }
+
+    bool pending = false;
+    for (auto& pixel_request : m_pixel_requests) {
+      if (pixel_request->is_pending() && pixel_request->is_ready()) {
+        pixel_request->deliver();
+      }
+      pending = pending || pixel_request->is_pending();
+    }
 
-  *(request.color_ptr) = pixel_request.get_color();
+    // without new requests the ring only has to move on when batches
+    // wait for their slot to come up again, otherwise moving on would
+    // just force out the batches the GPU is still working on
+    if (m_pixels.empty() && (m_use_fences || !pending))
+    {
+      assert_gl();
+      return;
+    }
 
-#else
-  float pixels[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    GLPixelRequest& pixel_request = *m_pixel_requests[m_next_pixel_request];
+    m_next_pixel_request = (m_next_pixel_request + 1) % m_pixel_requests.size();
 
-  // OpenGLES2 does not have PBOs, only GLES3 has
-  glReadPixels(static_cast<GLint>(x), static_cast<GLint>(y),
-               1, 1, GL_RGB, GL_FLOAT, pixels);
+    if (pixel_request.is_pending()) {
+      pixel_request.deliver();
+    }
 
-  *(request.color_ptr) = Color(pixels[0], pixels[1], pixels[2]);
+    if (!m_pixels.empty()) {
+      pixel_request.request(m_pixels, m_use_fences);
+    }
+
+    assert_gl();
+    return;
+  }
 #endif
 
+  for (const auto& pixel : m_pixels)
+  {
+    uint8_t data[4] = { 0, 0, 0, 0 };
+    glReadPixels(pixel.x, pixel.y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    *(pixel.color_ptr) = Color::from_rgb888(data[0], data[1], data[2]);
+  }
+  m_pixels.clear();
+
   assert_gl();
 }
 
@@ -19,7 +19,11 @@
 
 #include "video/painter.hpp"
 
+#include <memory>
+#include <vector>
+
 #include "video/flip.hpp"
+#include "video/gl/gl_pixel_request.hpp"
 
 enum class Blend;
 class GLRenderer;
@@ -31,6 +35,7 @@ public:
   GLPainter(GLVideoSystem& video_system, GLRenderer& renderer);
 
   virtual void draw_texture(const TextureRequest& request) override;
+  virtual void draw_retained_texture(const RetainedTextureRequest& request) override;
   virtual void draw_gradient(const GradientRequest& request) override;
   virtual void draw_filled_rect(const FillRectRequest& request) override;
   virtual void draw_inverse_ellipse(const InverseEllipseRequest& request) override;
@@ -38,7 +43,8 @@ public:
   virtual void draw_triangle(const TriangleRequest& request) override;
 
   virtual void clear(const Color& color) override;
-  virtual void get_pixel(const GetPixelRequest& request) const override;
+  virtual void get_pixel(const GetPixelRequest& request) override;
+  virtual void flush_pixel_requests() override;
 
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
@@ -47,6 +53,19 @@ private:
   GLVideoSystem& m_video_system;
   GLRenderer& m_renderer;
 
+  /** Scratch space for the vertices of a request */
+  std::vector<float> m_vertices;
+
+#ifndef USE_OPENGLES2
+  /** Batches still being read back by the GPU, used round-robin */
+  std::vector<std::unique_ptr<GLPixelRequest> > m_pixel_requests;
+  size_t m_next_pixel_request;
+  bool m_use_fences;
+#endif
+
+  /** Pixels requested since the last flush_pixel_requests() */
+  std::vector<GLPixel> m_pixels;
+
 private:
   GLPainter(const GLPainter&) = delete;
   GLPainter& operator=(const GLPainter&) = delete;
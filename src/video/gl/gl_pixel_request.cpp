@@ -16,44 +16,74 @@
 
 #include "video/gl/gl_pixel_request.hpp"
 
-#include <iostream>
+#include <algorithm>
+#include <assert.h>
 
 #include "util/log.hpp"
 #include "video/glutil.hpp"
 
 #ifndef USE_OPENGLES2
 
-GLPixelRequest::GLPixelRequest(int width, int height) :
+namespace {
+
+/** RGBA with one byte per channel, as that is what the framebuffer
+    has and thus needs no conversion */
+const size_t BYTES_PER_PIXEL = 4;
+
+} // namespace
+
+GLPixelRequest::GLPixelRequest() :
   m_buffer(),
-  m_width(width),
-  m_height(height),
-  m_offset(0),
-  m_sync()
+  m_capacity(0),
+  m_sync(),
+  m_pixels(),
+  m_data()
 {
   assert_gl();
 
   glGenBuffers(1, &m_buffer);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
-  glBufferData(GL_PIXEL_PACK_BUFFER, m_width * m_height * 4, nullptr, GL_DYNAMIC_READ);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
   assert_gl();
 }
 
 GLPixelRequest::~GLPixelRequest()
 {
+  if (m_sync)
+  {
+    glDeleteSync(m_sync);
+  }
   glDeleteBuffers(1, &m_buffer);
 }
 
 void
-GLPixelRequest::request(int x, int y)
+GLPixelRequest::request(std::vector<GLPixel>& pixels, bool use_fence)
 {
   assert_gl();
+  assert(!is_pending());
+
+  std::swap(m_pixels, pixels);
+  pixels.clear();
 
   glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
-  glReadPixels(x, y, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE,
-               reinterpret_cast<GLvoid*>(m_offset));
-  m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, GL_NONE_BIT);
+
+  if (m_pixels.size() > m_capacity)
+  {
+    m_capacity = std::max(m_pixels.size(), 2 * m_capacity);
+    glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(m_capacity * BYTES_PER_PIXEL),
+                 nullptr, GL_STREAM_READ);
+  }
+
+  for (size_t i = 0; i < m_pixels.size(); ++i)
+  {
+    glReadPixels(m_pixels[i].x, m_pixels[i].y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                 reinterpret_cast<GLvoid*>(i * BYTES_PER_PIXEL));
+  }
+
+  if (use_fence)
+  {
+    m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, GL_NONE_BIT);
+  }
+
   glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
   assert_gl();
@@ -62,6 +92,9 @@ GLPixelRequest::request(int x, int y)
 bool
 GLPixelRequest::is_ready() const
 {
+  if (!m_sync)
+    return false;
+
   assert_gl();
 
   GLenum ret = glClientWaitSync(m_sync, GL_NONE_BIT, 0);
@@ -69,13 +102,10 @@ GLPixelRequest::is_ready() const
   if (ret == GL_CONDITION_SATISFIED ||
       ret == GL_ALREADY_SIGNALED)
   {
-    //std::cout << "fence ready: " << static_cast<int>(ret) << " " << GL_ALREADY_SIGNALED << std::endl;
     return true;
   }
   else if (ret == GL_TIMEOUT_EXPIRED)
-
   {
-    //std::cout << "timeout: " << static_cast<int>(ret) << std::endl;
     return false;
   }
   else if (ret == GL_WAIT_FAILED)
@@ -87,28 +117,33 @@ GLPixelRequest::is_ready() const
     log_warning << "unknown glClientWaitSync() return value: " << static_cast<int>(ret) << std::endl;
     return true;
   }
-
-  assert_gl();
 }
 
 void
-GLPixelRequest::get(void* buffer, size_t length) const
+GLPixelRequest::deliver()
 {
   assert_gl();
 
+  if (m_sync)
+  {
+    glDeleteSync(m_sync);
+    m_sync = nullptr;
+  }
+
+  // glGetBufferSubData() waits for the reads if the GPU isn't done yet
+  m_data.resize(m_pixels.size() * BYTES_PER_PIXEL);
   glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
-  glGetBufferSubData(GL_PIXEL_PACK_BUFFER, m_offset, length, buffer);
+  glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(m_data.size()), m_data.data());
   glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-  assert_gl();
-}
+  for (size_t i = 0; i < m_pixels.size(); ++i)
+  {
+    const uint8_t* data = &m_data[i * BYTES_PER_PIXEL];
+    *(m_pixels[i].color_ptr) = Color::from_rgb888(data[0], data[1], data[2]);
+  }
+  m_pixels.clear();
 
-Color
-GLPixelRequest::get_color() const
-{
-  uint8_t data[3];
-  get(data, sizeof(data));
-  return Color::from_rgb888(data[0], data[1], data[2]);
+  assert_gl();
 }
 
 #endif
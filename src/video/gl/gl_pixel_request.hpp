@@ -17,32 +17,53 @@
 #ifndef HEADER_SUPERTUX_VIDEO_GL_GL_PIXEL_REQUEST_HPP
 #define HEADER_SUPERTUX_VIDEO_GL_GL_PIXEL_REQUEST_HPP
 
+#include <memory>
 #include <stddef.h>
+#include <stdint.h>
+#include <vector>
 
 #include "video/color.hpp"
 #include "video/gl.hpp"
 
+/** A pixel to read back, in window coordinates */
+struct GLPixel
+{
+  GLint x;
+  GLint y;
+  std::shared_ptr<Color> color_ptr;
+};
+
 #ifndef USE_OPENGLES2
 
+/** Reads a batch of pixels into a pixel buffer object. request()
+    returns right away, the colors are handed out by deliver() once
+    the GPU is done with the reads. */
 class GLPixelRequest final
 {
 public:
-  GLPixelRequest(int width, int height);
+  GLPixelRequest();
   ~GLPixelRequest();
 
-  void request(int x, int y);
+  /** Starts reading @c pixels and takes them over, @c pixels is left
+      empty. Without @c use_fence is_ready() always returns false and
+      deliver() waits for the GPU if it isn't done yet. */
+  void request(std::vector<GLPixel>& pixels, bool use_fence);
+
+  /** True between request() and deliver() */
+  bool is_pending() const { return !m_pixels.empty(); }
+
+  /** True once the GPU signaled that the reads are done */
   bool is_ready() const;
-  Color get_color() const;
 
-private:
-  void get(void* buffer, size_t length) const;
+  /** Writes the read colors to the pixels' color_ptr */
+  void deliver();
 
 private:
   GLuint m_buffer;
-  int m_width;
-  int m_height;
-  GLintptr m_offset;
+  size_t m_capacity;
   GLsync m_sync;
+  std::vector<GLPixel> m_pixels;
+  std::vector<uint8_t> m_data;
 
 private:
   GLPixelRequest(const GLPixelRequest&) = delete;
@@ -0,0 +1,145 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/gl/gl_retained_buffers.hpp"
+
+#include <iterator>
+
+#include "video/gl/gl33core_context.hpp"
+#include "video/gl/gl_program.hpp"
+#include "video/glutil.hpp"
+#include "video/retained_batch.hpp"
+#include "video/texture.hpp"
+
+namespace {
+
+/** Number of frames a buffer is kept after it was last drawn, so
+    that chunks scrolling in and out of view aren't uploaded again
+    each time */
+const int BUFFER_LIFETIME = 300;
+
+} // namespace
+
+GLRetainedBuffers::GLRetainedBuffers(GL33CoreContext& context) :
+  m_context(context),
+  m_buffers(),
+  m_frame(0),
+  m_vertices()
+{
+}
+
+GLRetainedBuffers::~GLRetainedBuffers()
+{
+  for (const auto& entry : m_buffers) {
+    glDeleteBuffers(1, &entry.second.handle);
+  }
+}
+
+GLsizei
+GLRetainedBuffers::bind(const RetainedBatch& batch)
+{
+  assert_gl();
+
+  auto it = m_buffers.find(batch.get_id());
+  if (it == m_buffers.end())
+  {
+    m_vertices.clear();
+    build_vertices(batch, m_vertices);
+
+    Buffer buffer;
+    glGenBuffers(1, &buffer.handle);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.handle);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * m_vertices.size(), m_vertices.data(), GL_STATIC_DRAW);
+    buffer.count = static_cast<GLsizei>(m_vertices.size() / 4);
+
+    it = m_buffers.emplace(batch.get_id(), buffer).first;
+  }
+  else
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, it->second.handle);
+  }
+
+  it->second.last_used = m_frame;
+
+  const GLsizei stride = 4 * sizeof(float);
+
+  const int position_loc = m_context.get_program().get_attrib_location("position");
+  glVertexAttribPointer(position_loc, 2, GL_FLOAT, GL_FALSE, stride, nullptr);
+  glEnableVertexAttribArray(position_loc);
+
+  const int texcoord_loc = m_context.get_program().get_attrib_location("texcoord");
+  glVertexAttribPointer(texcoord_loc, 2, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<const void*>(2 * sizeof(float)));
+  glEnableVertexAttribArray(texcoord_loc);
+
+  assert_gl();
+
+  return it->second.count;
+}
+
+void
+GLRetainedBuffers::collect_garbage()
+{
+  m_frame += 1;
+
+  for (auto it = m_buffers.begin(); it != m_buffers.end();)
+  {
+    if (m_frame - it->second.last_used > BUFFER_LIFETIME) {
+      glDeleteBuffers(1, &it->second.handle);
+      it = m_buffers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void
+GLRetainedBuffers::build_vertices(const RetainedBatch& batch, std::vector<float>& vertices)
+{
+  const float texture_width = static_cast<float>(batch.get_texture()->get_texture_width());
+  const float texture_height = static_cast<float>(batch.get_texture()->get_texture_height());
+
+  vertices.reserve(vertices.size() + batch.size() * 6 * 4);
+
+  for (size_t i = 0; i < batch.size(); ++i)
+  {
+    const Rectf& dstrect = batch.get_dstrects()[i];
+    const Rectf& srcrect = batch.get_srcrects()[i];
+
+    const float left = dstrect.get_left();
+    const float top = dstrect.get_top();
+    const float right = dstrect.get_right();
+    const float bottom = dstrect.get_bottom();
+
+    const float uv_left = srcrect.get_left() / texture_width;
+    const float uv_top = srcrect.get_top() / texture_height;
+    const float uv_right = srcrect.get_right() / texture_width;
+    const float uv_bottom = srcrect.get_bottom() / texture_height;
+
+    const float vertices_lst[] = {
+      left, top, uv_left, uv_top,
+      right, top, uv_right, uv_top,
+      right, bottom, uv_right, uv_bottom,
+
+      left, bottom, uv_left, uv_bottom,
+      left, top, uv_left, uv_top,
+      right, bottom, uv_right, uv_bottom,
+    };
+    vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
+  }
+}
+
+/* EOF */
@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_GL_GL_RETAINED_BUFFERS_HPP
+#define HEADER_SUPERTUX_VIDEO_GL_GL_RETAINED_BUFFERS_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "video/gl.hpp"
+
+class GL33CoreContext;
+class RetainedBatch;
+
+/** Keeps the vertices of each RetainedBatch drawn recently in a
+    buffer object, so they are uploaded once instead of every frame */
+class GLRetainedBuffers final
+{
+public:
+  GLRetainedBuffers(GL33CoreContext& context);
+  ~GLRetainedBuffers();
+
+  /** Points the position and texcoord attributes at the buffer of
+      @c batch, uploading it first if needed. Returns the number of
+      vertices. */
+  GLsizei bind(const RetainedBatch& batch);
+
+  /** Deletes the buffers of batches that weren't drawn for a while,
+      to be called once per frame */
+  void collect_garbage();
+
+  /** Appends two triangles for each rectangle of @c batch to
+      @c vertices, as interleaved position and texcoord */
+  static void build_vertices(const RetainedBatch& batch, std::vector<float>& vertices);
+
+private:
+  struct Buffer
+  {
+    GLuint handle;
+    GLsizei count;
+    int last_used;
+  };
+
+private:
+  GL33CoreContext& m_context;
+  std::unordered_map<uint64_t, Buffer> m_buffers;
+  int m_frame;
+  std::vector<float> m_vertices;
+
+private:
+  GLRetainedBuffers(const GLRetainedBuffers&) = delete;
+  GLRetainedBuffers& operator=(const GLRetainedBuffers&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -193,6 +193,35 @@ GLTexture::~GLTexture()
   glDeleteTextures(1, &m_handle);
 }
 
+void
+GLTexture::update(const SDL_Surface& image, int x, int y)
+{
+  assert(image.format->BytesPerPixel == 4);
+
+  assert_gl();
+
+  glBindTexture(GL_TEXTURE_2D, m_handle);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#if defined(GL_UNPACK_ROW_LENGTH) || defined(USE_GLBINDING)
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, image.pitch / image.format->BytesPerPixel);
+#else
+  assert(image.pitch == image.w * image.format->BytesPerPixel);
+#endif
+
+  if (SDL_MUSTLOCK(&image)) {
+    SDL_LockSurface(const_cast<SDL_Surface*>(&image));
+  }
+
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, image.w, image.h,
+                  GL_RGBA, GL_UNSIGNED_BYTE, image.pixels);
+
+  if (SDL_MUSTLOCK(&image)) {
+    SDL_UnlockSurface(const_cast<SDL_Surface*>(&image));
+  }
+
+  assert_gl();
+}
+
 void
 GLTexture::set_texture_params()
 {
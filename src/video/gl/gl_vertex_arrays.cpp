@@ -22,28 +22,42 @@
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
+namespace {
+
+/** Initial size of the stream, enough for a few thousand sprites */
+const size_t INITIAL_CAPACITY = 1024 * 1024;
+
+/** Alignment of the data of each draw call in the stream */
+const size_t ALIGNMENT = 16;
+
+/** Room for the alignment between the arrays of a draw call, which
+    uses at most four of them */
+const size_t MAX_PADDING = 3 * ALIGNMENT;
+
+} // namespace
+
 GLVertexArrays::GLVertexArrays(GL33CoreContext& context) :
   m_context(context),
   m_vao(),
-  m_positions_buffer(),
-  m_texcoords_buffer(),
-  m_color_buffer()
+  m_buffer(),
+  m_capacity(INITIAL_CAPACITY),
+  m_offset(0),
+  m_reserved_end(0)
 {
   assert_gl();
 
   glGenVertexArrays(1, &m_vao);
-  glGenBuffers(1, &m_positions_buffer);
-  glGenBuffers(1, &m_texcoords_buffer);
-  glGenBuffers(1, &m_color_buffer);
+  glGenBuffers(1, &m_buffer);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+  glBufferData(GL_ARRAY_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
 
   assert_gl();
 }
 
 GLVertexArrays::~GLVertexArrays()
 {
-  glDeleteBuffers(1, &m_positions_buffer);
-  glDeleteBuffers(1, &m_texcoords_buffer);
-  glDeleteBuffers(1, &m_color_buffer);
+  glDeleteBuffers(1, &m_buffer);
   glDeleteVertexArrays(1, &m_vao);
 }
 
@@ -58,31 +72,100 @@ GLVertexArrays::bind()
 }
 
 void
-GLVertexArrays::set_positions(const float* data, size_t size)
+GLVertexArrays::next_frame()
 {
   assert_gl();
 
-  glBindBuffer(GL_ARRAY_BUFFER, m_positions_buffer);
-  glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+  // orphan the storage, the driver keeps the old one around until
+  // the draw calls using it are done
+  glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+  glBufferData(GL_ARRAY_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+  m_offset = 0;
+  m_reserved_end = 0;
+
+  assert_gl();
+}
+
+void
+GLVertexArrays::reserve(size_t size)
+{
+  assert_gl();
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+  size += MAX_PADDING;
+  if (m_offset + size > m_capacity)
+  {
+    while (m_capacity < size) {
+      m_capacity *= 2;
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+    m_offset = 0;
+  }
+  m_reserved_end = m_offset + size;
+
+  assert_gl();
+}
+
+size_t
+GLVertexArrays::append(const float* data, size_t size)
+{
+  if (m_offset + size > m_reserved_end)
+  {
+    // not covered by a reserve(), so this is the only array of its
+    // draw call and orphaning the storage is safe
+    reserve(size);
+  }
+  else
+  {
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+  }
+
+  const size_t offset = m_offset;
+  glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+  m_offset = (offset + size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+  return offset;
+}
 
-  int loc = m_context.get_program().get_attrib_location("position");
-  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+void
+GLVertexArrays::set_attrib(const char* name, GLint components, GLsizei stride, size_t offset)
+{
+  int loc = m_context.get_program().get_attrib_location(name);
+  glVertexAttribPointer(loc, components, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<const void*>(offset));
   glEnableVertexAttribArray(loc);
+}
+
+void
+GLVertexArrays::set_positions(const float* data, size_t size)
+{
+  assert_gl();
+
+  set_attrib("position", 2, 0, append(data, size));
 
   assert_gl();
 }
 
 void
-GLVertexArrays::set_texcoords(const float* data, size_t size)
+GLVertexArrays::set_vertices(const float* data, size_t size)
 {
   assert_gl();
 
-  glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_buffer);
-  glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+  const size_t offset = append(data, size);
+  set_attrib("position", 2, 4 * sizeof(float), offset);
+  set_attrib("texcoord", 2, 4 * sizeof(float), offset + 2 * sizeof(float));
 
-  int loc = m_context.get_program().get_attrib_location("texcoord");
-  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-  glEnableVertexAttribArray(loc);
+  assert_gl();
+}
+
+void
+GLVertexArrays::set_texcoords(const float* data, size_t size)
+{
+  assert_gl();
+
+  set_attrib("texcoord", 2, 0, append(data, size));
 
   assert_gl();
 }
@@ -104,12 +187,7 @@ GLVertexArrays::set_colors(const float* data, size_t size)
 {
   assert_gl();
 
-  glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_buffer);
-  glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
-
-  int loc = m_context.get_program().get_attrib_location("diffuse");
-  glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-  glEnableVertexAttribArray(loc);
+  set_attrib("diffuse", 4, 0, append(data, size));
 
   assert_gl();
 }
@@ -24,6 +24,14 @@
 class Color;
 class GL33CoreContext;
 
+/** Streams the vertex data of all draw calls through a single buffer
+    object. Data is appended behind the data of the previous draw
+    calls, the buffer storage is only orphaned once per frame or when
+    it runs full, instead of being specified anew for every draw.
+
+    Orphaning drops the arrays set earlier for the same draw call, so
+    draw calls using more than one array have to reserve() the room
+    for all of them before setting the first one. */
 class GLVertexArrays final
 {
 public:
@@ -32,8 +40,16 @@ public:
 
   void bind();
 
+  /** Makes sure the next @c size bytes can be appended without
+      orphaning the buffer storage, size is in bytes */
+  void reserve(size_t size);
+
+  /** size is in bytes */
   void set_positions(const float* data, size_t size);
 
+  /** Interleaved position and texcoord, size is in bytes */
+  void set_vertices(const float* data, size_t size);
+
   /** size is in bytes */
   void set_texcoords(const float* data, size_t size);
   void set_texcoord(float u, float v);
@@ -41,12 +57,29 @@ public:
   void set_colors(const float* data, size_t size);
   void set_color(const Color& color);
 
+  /** Drops the data streamed in the last frame */
+  void next_frame();
+
+private:
+  /** Copies @c data into the stream and returns its byte offset in
+      the buffer, which is left bound to GL_ARRAY_BUFFER */
+  size_t append(const float* data, size_t size);
+
+  void set_attrib(const char* name, GLint components, GLsizei stride, size_t offset);
+
 private:
   GL33CoreContext& m_context;
   GLuint m_vao;
-  GLuint m_positions_buffer;
-  GLuint m_texcoords_buffer;
-  GLuint m_color_buffer;
+  GLuint m_buffer;
+
+  /** Size of the buffer storage in bytes */
+  size_t m_capacity;
+
+  /** Byte offset at which the next data gets appended */
+  size_t m_offset;
+
+  /** End of the room made by the last reserve() */
+  size_t m_reserved_end;
 
 private:
   GLVertexArrays(const GLVertexArrays&) = delete;
@@ -290,6 +290,7 @@ void
 GLVideoSystem::flip()
 {
   assert_gl();
+  m_context->end_frame();
   SDL_GL_SwapWindow(m_sdl_window.get());
 }
 
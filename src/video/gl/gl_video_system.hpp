@@ -59,6 +59,7 @@ public:
   virtual SDLSurfacePtr make_screenshot() override;
 
   GLContext& get_context() const { return *m_context; }
+  bool use_opengl33core() const { return m_use_opengl33core; }
 
 private:
   void create_gl_window();
@@ -17,9 +17,11 @@
 #include "video/null/null_painter.hpp"
 
 #include "util/log.hpp"
+#include "video/drawing_request.hpp"
 
 NullPainter::NullPainter() :
-  m_clip_rect()
+  m_clip_rect(),
+  m_pixels()
 {
 }
 
@@ -71,9 +73,25 @@ NullPainter::clear(const Color& color)
 }
 
 void
-NullPainter::get_pixel(const GetPixelRequest& request) const
+NullPainter::get_pixel(const GetPixelRequest& request)
 {
   log_info << "NullPainter::get_pixel()" << std::endl;
+  m_pixels.push_back(request.color_ptr);
+}
+
+void
+NullPainter::flush_pixel_requests()
+{
+  if (m_pixels.empty())
+    return;
+
+  log_info << "NullPainter::flush_pixel_requests()" << std::endl;
+
+  // There is nothing drawn, so all pixels are black
+  for (const auto& color_ptr : m_pixels) {
+    *color_ptr = Color(0.0f, 0.0f, 0.0f);
+  }
+  m_pixels.clear();
 }
 
 void
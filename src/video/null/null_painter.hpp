@@ -20,6 +20,8 @@
 #include "video/painter.hpp"
 
 #include <boost/optional.hpp>
+#include <memory>
+#include <vector>
 
 class NullPainter : public Painter
 {
@@ -35,7 +37,8 @@ public:
   virtual void draw_triangle(const TriangleRequest& request) override;
 
   virtual void clear(const Color& color) override;
-  virtual void get_pixel(const GetPixelRequest& request) const override;
+  virtual void get_pixel(const GetPixelRequest& request) override;
+  virtual void flush_pixel_requests() override;
 
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
@@ -43,6 +46,9 @@ public:
 private:
   boost::optional<Rect> m_clip_rect;
 
+  /** Pixels requested since the last flush_pixel_requests() */
+  std::vector<std::shared_ptr<Color> > m_pixels;
+
 private:
   NullPainter(const NullPainter&) = delete;
   NullPainter& operator=(const NullPainter&) = delete;
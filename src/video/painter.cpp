@@ -0,0 +1,48 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/painter.hpp"
+
+#include "video/drawing_request.hpp"
+#include "video/retained_batch.hpp"
+
+void
+Painter::draw_retained_texture(const RetainedTextureRequest& request)
+{
+  const RetainedBatch& batch = *request.batch;
+
+  TextureRequest texture_request;
+  texture_request.layer = request.layer;
+  texture_request.flip = request.flip;
+  texture_request.alpha = request.alpha;
+  texture_request.blend = request.blend;
+  texture_request.texture = batch.get_texture().get();
+  texture_request.displacement_texture = batch.get_displacement_texture().get();
+  texture_request.color = request.color;
+
+  texture_request.srcrects = batch.get_srcrects();
+  texture_request.dstrects.reserve(batch.size());
+  for (const auto& dstrect : batch.get_dstrects())
+  {
+    texture_request.dstrects.emplace_back(dstrect.p1() * request.scale + request.offset,
+                                          dstrect.get_size() * request.scale);
+  }
+  texture_request.angles.resize(batch.size(), 0.0f);
+
+  draw_texture(texture_request);
+}
+
+/* EOF */
@@ -29,6 +29,7 @@ struct GetPixelRequest;
 struct GradientRequest;
 struct InverseEllipseRequest;
 struct LineRequest;
+struct RetainedTextureRequest;
 struct TextureBatchRequest;
 struct TextureRequest;
 struct TriangleRequest;
@@ -40,6 +41,13 @@ public:
   virtual ~Painter() {}
 
   virtual void draw_texture(const TextureRequest& request) = 0;
+
+  /** Draws the rectangles of a RetainedBatch. The default
+      implementation passes them on to draw_texture() each time,
+      painters that can keep the vertices between frames override
+      it. */
+  virtual void draw_retained_texture(const RetainedTextureRequest& request);
+
   virtual void draw_gradient(const GradientRequest& request) = 0;
   virtual void draw_filled_rect(const FillRectRequest& request) = 0;
   virtual void draw_inverse_ellipse(const InverseEllipseRequest& request) = 0;
@@ -47,7 +55,15 @@ public:
   virtual void draw_triangle(const TriangleRequest& request) = 0;
 
   virtual void clear(const Color& color) = 0;
-  virtual void get_pixel(const GetPixelRequest& request) const = 0;
+
+  /** Queues reading the color of a pixel. The color is written to
+      the request's color_ptr by flush_pixel_requests(), painters that
+      read back asynchronously may do so a frame or two later. */
+  virtual void get_pixel(const GetPixelRequest& request) = 0;
+
+  /** Reads back the pixels queued since the last call in one go,
+      called at the end of each Canvas::render() */
+  virtual void flush_pixel_requests() = 0;
 
   virtual void set_clip_rect(const Rect& rect) = 0;
   virtual void clear_clip_rect() = 0;
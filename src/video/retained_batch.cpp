@@ -0,0 +1,38 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/retained_batch.hpp"
+
+uint64_t RetainedBatch::s_next_id = 1;
+
+RetainedBatch::RetainedBatch(const TexturePtr& texture, const TexturePtr& displacement_texture, Flip flip) :
+  m_id(s_next_id++),
+  m_texture(texture),
+  m_displacement_texture(displacement_texture),
+  m_flip(flip),
+  m_srcrects(),
+  m_dstrects()
+{
+}
+
+void
+RetainedBatch::add(const Rectf& srcrect, const Rectf& dstrect)
+{
+  m_srcrects.push_back(srcrect);
+  m_dstrects.push_back(dstrect);
+}
+
+/* EOF */
@@ -0,0 +1,69 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_RETAINED_BATCH_HPP
+#define HEADER_SUPERTUX_VIDEO_RETAINED_BATCH_HPP
+
+#include <stdint.h>
+#include <vector>
+
+#include "math/rectf.hpp"
+#include "video/flip.hpp"
+#include "video/texture_ptr.hpp"
+
+/** Rectangles of a texture that are drawn unchanged over many
+    frames, e.g. the tiles of a TileMap chunk. Renderers may keep the
+    vertices of a batch on the GPU, identified by get_id(), which is
+    unique for each batch. A batch is filled once before it is drawn,
+    to change the rectangles it has to be replaced by a new batch. */
+class RetainedBatch final
+{
+public:
+  RetainedBatch(const TexturePtr& texture, const TexturePtr& displacement_texture, Flip flip);
+  RetainedBatch(RetainedBatch&&) = default;
+  RetainedBatch& operator=(RetainedBatch&&) = default;
+
+  void add(const Rectf& srcrect, const Rectf& dstrect);
+
+  uint64_t get_id() const { return m_id; }
+
+  const TexturePtr& get_texture() const { return m_texture; }
+  const TexturePtr& get_displacement_texture() const { return m_displacement_texture; }
+  Flip get_flip() const { return m_flip; }
+
+  size_t size() const { return m_srcrects.size(); }
+  const std::vector<Rectf>& get_srcrects() const { return m_srcrects; }
+  const std::vector<Rectf>& get_dstrects() const { return m_dstrects; }
+
+private:
+  static uint64_t s_next_id;
+
+private:
+  uint64_t m_id;
+  TexturePtr m_texture;
+  TexturePtr m_displacement_texture;
+  Flip m_flip;
+  std::vector<Rectf> m_srcrects;
+  std::vector<Rectf> m_dstrects;
+
+private:
+  RetainedBatch(const RetainedBatch&) = delete;
+  RetainedBatch& operator=(const RetainedBatch&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -33,6 +33,10 @@
 
 namespace {
 
+/** Pixels are read back with one SDL_RenderReadPixels() call for the
+    bounding box of all of them, as long as it isn't larger than this */
+const int MAX_PIXEL_BOX_AREA = 256 * 256;
+
 SDL_Rect to_sdl_rect(const Rectf& rect)
 {
   SDL_Rect sdl_rect;
@@ -218,7 +222,9 @@ SDLPainter::SDLPainter(SDLVideoSystem& video_system, Renderer& renderer, SDL_Ren
   m_video_system(video_system),
   m_renderer(renderer),
   m_sdl_renderer(sdl_renderer),
-  m_cliprect()
+  m_cliprect(),
+  m_pixels(),
+  m_pixel_data()
 {}
 
 void
@@ -600,28 +606,80 @@ SDLPainter::clear_clip_rect()
 }
 
 void
-SDLPainter::get_pixel(const GetPixelRequest& request) const
+SDLPainter::get_pixel(const GetPixelRequest& request)
 {
   const Rect& rect = m_renderer.get_rect();
   const Size& logical_size = m_renderer.get_logical_size();
 
+  const int x = rect.left + static_cast<int>(request.pos.x * static_cast<float>(rect.get_width()) / static_cast<float>(logical_size.width));
+  const int y = rect.top + static_cast<int>(request.pos.y * static_cast<float>(rect.get_height()) / static_cast<float>(logical_size.height));
+
+  m_pixels.push_back({ x, y, request.color_ptr });
+}
+
+void
+SDLPainter::flush_pixel_requests()
+{
+  if (m_pixels.empty())
+    return;
+
+  int left = m_pixels.front().x;
+  int top = m_pixels.front().y;
+  int right = left;
+  int bottom = top;
+  for (const auto& pixel : m_pixels)
+  {
+    left = std::min(left, pixel.x);
+    top = std::min(top, pixel.y);
+    right = std::max(right, pixel.x);
+    bottom = std::max(bottom, pixel.y);
+  }
+
   SDL_Rect srcrect;
-  srcrect.x = rect.left + static_cast<int>(request.pos.x * static_cast<float>(rect.get_width()) / static_cast<float>(logical_size.width));
-  srcrect.y = rect.top + static_cast<int>(request.pos.y * static_cast<float>(rect.get_height()) / static_cast<float>(logical_size.height));
-  srcrect.w = 1;
-  srcrect.h = 1;
-
-  Uint8 pixel[4];
-  int ret = SDL_RenderReadPixels(m_sdl_renderer, &srcrect,
-                                 SDL_PIXELFORMAT_RGB888,
-                                 pixel,
-                                 1);
-  if (ret != 0)
+  srcrect.x = left;
+  srcrect.y = top;
+  srcrect.w = right - left + 1;
+  srcrect.h = bottom - top + 1;
+
+  const bool read_box = srcrect.w * srcrect.h <= MAX_PIXEL_BOX_AREA;
+  if (read_box)
   {
-    log_warning << "failed to read pixels: " << SDL_GetError() << std::endl;
+    m_pixel_data.resize(static_cast<size_t>(srcrect.w * srcrect.h));
+    int ret = SDL_RenderReadPixels(m_sdl_renderer, &srcrect,
+                                   SDL_PIXELFORMAT_RGB888,
+                                   m_pixel_data.data(),
+                                   srcrect.w * static_cast<int>(sizeof(uint32_t)));
+    if (ret != 0)
+    {
+      log_warning << "failed to read pixels: " << SDL_GetError() << std::endl;
+    }
   }
 
-  *(request.color_ptr) = Color::from_rgb888(pixel[2], pixel[1], pixel[0]);
+  for (const auto& pixel : m_pixels)
+  {
+    uint32_t value = 0;
+    if (read_box)
+    {
+      value = m_pixel_data[(pixel.y - top) * srcrect.w + (pixel.x - left)];
+    }
+    else
+    {
+      SDL_Rect pixel_rect = { pixel.x, pixel.y, 1, 1 };
+      int ret = SDL_RenderReadPixels(m_sdl_renderer, &pixel_rect,
+                                     SDL_PIXELFORMAT_RGB888,
+                                     &value,
+                                     static_cast<int>(sizeof(uint32_t)));
+      if (ret != 0)
+      {
+        log_warning << "failed to read pixels: " << SDL_GetError() << std::endl;
+      }
+    }
+
+    *(pixel.color_ptr) = Color::from_rgb888(static_cast<uint8_t>((value >> 16) & 0xff),
+                                            static_cast<uint8_t>((value >> 8) & 0xff),
+                                            static_cast<uint8_t>(value & 0xff));
+  }
+  m_pixels.clear();
 }
 
 /* EOF */
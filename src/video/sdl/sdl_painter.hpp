@@ -20,6 +20,9 @@
 #include "video/painter.hpp"
 
 #include <boost/optional.hpp>
+#include <memory>
+#include <stdint.h>
+#include <vector>
 
 class Renderer;
 class SDLScreenRenderer;
@@ -40,17 +43,32 @@ public:
   virtual void draw_triangle(const TriangleRequest& request) override;
 
   virtual void clear(const Color& color) override;
-  virtual void get_pixel(const GetPixelRequest& request) const override;
+  virtual void get_pixel(const GetPixelRequest& request) override;
+  virtual void flush_pixel_requests() override;
 
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
 
+private:
+  struct Pixel
+  {
+    int x;
+    int y;
+    std::shared_ptr<Color> color_ptr;
+  };
+
 private:
   SDLVideoSystem& m_video_system;
   Renderer& m_renderer;
   SDL_Renderer* m_sdl_renderer;
   boost::optional<SDL_Rect> m_cliprect;
 
+  /** Pixels requested since the last flush_pixel_requests() */
+  std::vector<Pixel> m_pixels;
+
+  /** Scratch space for reading back the pixels */
+  std::vector<uint32_t> m_pixel_data;
+
 private:
   SDLPainter(const SDLPainter&) = delete;
   SDLPainter& operator=(const SDLPainter&) = delete;
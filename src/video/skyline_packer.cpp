@@ -0,0 +1,141 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/skyline_packer.hpp"
+
+#include <algorithm>
+#include <limits>
+
+SkylinePacker::SkylinePacker(const Size& size) :
+  m_size(size),
+  m_skyline({ { 0, 0, size.width } }),
+  m_used_area(0),
+  m_count(0)
+{
+}
+
+boost::optional<Rect>
+SkylinePacker::insert(const Size& size)
+{
+  if (size.width <= 0 || size.height <= 0)
+    return boost::none;
+
+  size_t best_index = 0;
+  int best_y = -1;
+  int best_bottom = std::numeric_limits<int>::max();
+  int best_width = std::numeric_limits<int>::max();
+
+  for (size_t i = 0; i < m_skyline.size(); ++i)
+  {
+    const int y = fit(i, size);
+    if (y < 0)
+      continue;
+
+    const int bottom = y + size.height;
+    if (bottom < best_bottom ||
+        (bottom == best_bottom && m_skyline[i].width < best_width))
+    {
+      best_index = i;
+      best_y = y;
+      best_bottom = bottom;
+      best_width = m_skyline[i].width;
+    }
+  }
+
+  if (best_y < 0)
+    return boost::none;
+
+  const Rect rect(m_skyline[best_index].x, best_y, size);
+
+  // the new segment covers the segments below it, which are cut or
+  // dropped accordingly
+  m_skyline.insert(m_skyline.begin() + best_index, Segment{ rect.left, rect.bottom, size.width });
+  for (size_t i = best_index + 1; i < m_skyline.size();)
+  {
+    Segment& segment = m_skyline[i];
+    if (segment.x >= rect.right)
+      break;
+
+    const int overlap = rect.right - segment.x;
+    if (overlap < segment.width)
+    {
+      segment.x += overlap;
+      segment.width -= overlap;
+      break;
+    }
+
+    m_skyline.erase(m_skyline.begin() + i);
+  }
+
+  // merge neighbours of the same height
+  for (size_t i = 0; i + 1 < m_skyline.size();)
+  {
+    if (m_skyline[i].y == m_skyline[i + 1].y)
+    {
+      m_skyline[i].width += m_skyline[i + 1].width;
+      m_skyline.erase(m_skyline.begin() + i + 1);
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  m_used_area += rect.get_area();
+  m_count += 1;
+
+  return rect;
+}
+
+int
+SkylinePacker::fit(size_t index, const Size& size) const
+{
+  const int x = m_skyline[index].x;
+  if (x + size.width > m_size.width)
+    return -1;
+
+  int y = 0;
+  int remaining = size.width;
+  for (size_t i = index; remaining > 0; ++i)
+  {
+    y = std::max(y, m_skyline[i].y);
+    remaining -= m_skyline[i].width;
+  }
+
+  if (y + size.height > m_size.height)
+    return -1;
+
+  return y;
+}
+
+float
+SkylinePacker::get_occupancy() const
+{
+  return static_cast<float>(m_used_area) / static_cast<float>(m_size.width * m_size.height);
+}
+
+int
+SkylinePacker::get_height() const
+{
+  int height = 0;
+  for (const auto& segment : m_skyline) {
+    height = std::max(height, segment.y);
+  }
+  return height;
+}
+
+/* EOF */
@@ -0,0 +1,76 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_SKYLINE_PACKER_HPP
+#define HEADER_SUPERTUX_VIDEO_SKYLINE_PACKER_HPP
+
+#include <vector>
+#include <boost/optional.hpp>
+
+#include "math/rect.hpp"
+#include "math/size.hpp"
+
+/** Packs rectangles into an area of fixed size, keeping track of the
+    free space as a skyline: the height of the used space across the
+    width of the area. Rectangles are placed bottom-left first, i.e.
+    where their bottom edge ends up lowest. Space can't be given back,
+    once a rectangle is placed it stays. */
+class SkylinePacker final
+{
+public:
+  SkylinePacker(const Size& size);
+
+  /** Returns the area reserved for a rectangle of @c size or none if
+      there is no room left for it */
+  boost::optional<Rect> insert(const Size& size);
+
+  /** Fraction of the area covered by inserted rectangles */
+  float get_occupancy() const;
+
+  /** Height of the highest part of the skyline */
+  int get_height() const;
+
+  int get_count() const { return m_count; }
+
+private:
+  struct Segment
+  {
+    int x;
+    int y;
+    int width;
+  };
+
+private:
+  /** Returns the y position a rectangle of @c size would get when
+      placed at the start of segment @c index, or -1 if it doesn't fit
+      there */
+  int fit(size_t index, const Size& size) const;
+
+private:
+  Size m_size;
+  std::vector<Segment> m_skyline;
+  long m_used_area;
+  int m_count;
+
+private:
+  SkylinePacker(const SkylinePacker&) = delete;
+  SkylinePacker& operator=(const SkylinePacker&) = delete;
+};
+
+#endif
+
+/* EOF */
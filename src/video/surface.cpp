@@ -28,13 +28,6 @@
 SurfacePtr
 Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>& rect, const std::string& filename)
 {
-  TexturePtr diffuse_texture;
-  boost::optional<ReaderMapping> diffuse_texture_mapping;
-  if (mapping.get("diffuse-texture", diffuse_texture_mapping))
-  {
-    diffuse_texture = TextureManager::current()->get(*diffuse_texture_mapping, rect);
-  }
-
   TexturePtr displacement_texture;
   boost::optional<ReaderMapping> displacement_texture_mapping;
   if (mapping.get("displacement-texture", displacement_texture_mapping))
@@ -42,6 +35,24 @@ Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>&
     displacement_texture = TextureManager::current()->get(*displacement_texture_mapping, rect);
   }
 
+  TexturePtr diffuse_texture;
+  Rect region;
+  boost::optional<ReaderMapping> diffuse_texture_mapping;
+  if (mapping.get("diffuse-texture", diffuse_texture_mapping))
+  {
+    if (displacement_texture)
+    {
+      // both textures are sampled at the same coordinates, so the
+      // diffuse one can't be moved into the texture atlas
+      diffuse_texture = TextureManager::current()->get(*diffuse_texture_mapping, rect);
+      region = Rect(0, 0, diffuse_texture->get_image_width(), diffuse_texture->get_image_height());
+    }
+    else
+    {
+      diffuse_texture = TextureManager::current()->get(*diffuse_texture_mapping, rect, region);
+    }
+  }
+
   Flip flip = NO_FLIP;
   std::vector<bool> flip_v;
   if (mapping.get("flip", flip_v))
@@ -50,7 +61,7 @@ Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>&
     flip ^= flip_v[1] ? VERTICAL_FLIP : NO_FLIP;
   }
 
-  auto surface = new Surface(diffuse_texture, displacement_texture, flip, filename);
+  auto surface = new Surface(diffuse_texture, displacement_texture, region, flip, filename);
   return SurfacePtr(surface);
 }
 
@@ -74,16 +85,9 @@ Surface::from_file(const std::string& filename, const boost::optional<Rect>& rec
   }
   else
   {
-    if (rect)
-    {
-      TexturePtr texture = TextureManager::current()->get(filename, *rect);
-      return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP, filename));
-    }
-    else
-    {
-      TexturePtr texture = TextureManager::current()->get(filename);
-      return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP, filename));
-    }
+    Rect region;
+    TexturePtr texture = TextureManager::current()->get(filename, rect, region);
+    return SurfacePtr(new Surface(texture, TexturePtr(), region, NO_FLIP, filename));
   }
 }
 
@@ -135,7 +139,7 @@ Surface::region(const Rect& rect) const
 {
   SurfacePtr surface(new Surface(m_diffuse_texture,
                                  m_displacement_texture,
-                                 rect,
+                                 rect.moved(m_region.left, m_region.top),
                                  m_flip));
   return surface;
 }
@@ -46,11 +46,17 @@ private:
 public:
   ~Surface();
 
+  /** Returns a surface showing @c rect of this one, @c rect is
+      relative to the top left corner of this surface */
   SurfacePtr region(const Rect& rect) const;
   SurfacePtr clone(Flip flip = NO_FLIP) const;
 
   TexturePtr get_texture() const;
   TexturePtr get_displacement_texture() const;
+
+  /** The area of the texture showing this surface, which doesn't
+      start at 0,0 for parts of an image or for images packed into
+      the texture atlas */
   Rect get_region() const { return m_region; }
   int get_width() const;
   int get_height() const;
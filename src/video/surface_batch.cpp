@@ -31,9 +31,7 @@ SurfaceBatch::SurfaceBatch(const SurfacePtr& surface, const Color& color) :
 void
 SurfaceBatch::draw(const Vector& pos, float angle)
 {
-  m_srcrects.emplace_back(Rectf(0, 0,
-                                static_cast<float>(m_surface->get_width()),
-                                static_cast<float>(m_surface->get_height())));
+  m_srcrects.emplace_back(m_surface->get_region());
   m_dstrects.emplace_back(Rectf(pos,
                                 Sizef(static_cast<float>(m_surface->get_width()),
                                       static_cast<float>(m_surface->get_height()))));
@@ -43,9 +41,7 @@ SurfaceBatch::draw(const Vector& pos, float angle)
 void
 SurfaceBatch::draw(const Rectf& dstrect, float angle)
 {
-  m_srcrects.emplace_back(Rectf(0, 0,
-                                static_cast<float>(m_surface->get_width()),
-                                static_cast<float>(m_surface->get_height())));
+  m_srcrects.emplace_back(m_surface->get_region());
   m_dstrects.emplace_back(dstrect);
   m_angles.emplace_back(angle);
 }
@@ -0,0 +1,248 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/texture_atlas.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <assert.h>
+
+#include "util/log.hpp"
+#include "video/sampler.hpp"
+#include "video/sdl_surface.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+const int PAGE_SIZE = 2048;
+
+/** Larger images get a texture of their own */
+const int MAX_IMAGE_SIZE = 256;
+
+/** Width of the border around each image */
+const int PADDING = 1;
+
+/** Fills the PADDING wide border of @c surface with copies of the
+    outermost pixels of the image inside it */
+void extrude_border(SDL_Surface& surface)
+{
+  if (SDL_MUSTLOCK(&surface)) {
+    SDL_LockSurface(&surface);
+  }
+
+  const int width = surface.w - 2 * PADDING;
+  const int height = surface.h - 2 * PADDING;
+
+  auto row = [&surface](int y) {
+    return reinterpret_cast<Uint32*>(static_cast<uint8_t*>(surface.pixels) + y * surface.pitch);
+  };
+
+  for (int y = PADDING; y < PADDING + height; ++y)
+  {
+    Uint32* pixels = row(y);
+    for (int x = 0; x < PADDING; ++x) {
+      pixels[x] = pixels[PADDING];
+      pixels[PADDING + width + x] = pixels[PADDING + width - 1];
+    }
+  }
+
+  for (int y = 0; y < PADDING; ++y) {
+    std::copy(row(PADDING), row(PADDING) + surface.w, row(y));
+    std::copy(row(PADDING + height - 1), row(PADDING + height - 1) + surface.w, row(PADDING + height + y));
+  }
+
+  if (SDL_MUSTLOCK(&surface)) {
+    SDL_UnlockSurface(&surface);
+  }
+}
+
+} // namespace
+
+TextureAtlas::TextureAtlas() :
+  m_pages(),
+  m_entries()
+{
+}
+
+TextureAtlas::~TextureAtlas()
+{
+}
+
+TexturePtr
+TextureAtlas::get(const Texture::Key& key, Rect& region)
+{
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+    return {};
+
+  Entry& entry = it->second;
+  TexturePtr texture = entry.texture.lock();
+  if (!texture)
+  {
+    // the image stays on its page as long as any other image there is used
+    TexturePtr page = entry.page.lock();
+    if (!page)
+    {
+      m_entries.erase(it);
+      return {};
+    }
+    texture = create_reference(entry, page);
+  }
+
+  region = entry.region;
+  return texture;
+}
+
+TexturePtr
+TextureAtlas::add(const Texture::Key& key, const SDL_Surface& image, const Rect& srcrect, Rect& region)
+{
+  if (srcrect.get_width() > MAX_IMAGE_SIZE || srcrect.get_height() > MAX_IMAGE_SIZE)
+    return {};
+
+  const Size size(srcrect.get_width() + 2 * PADDING,
+                  srcrect.get_height() + 2 * PADDING);
+
+  SDLSurfacePtr padded = SDLSurface::create_rgba(size.width, size.height);
+  SDL_Rect src = srcrect.to_sdl();
+  SDL_Rect dst{PADDING, PADDING, srcrect.get_width(), srcrect.get_height()};
+  SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
+  SDL_BlitSurface(const_cast<SDL_Surface*>(&image), &src, padded.get(), &dst);
+  extrude_border(*padded);
+
+  purge_expired_pages();
+
+  boost::optional<Rect> rect;
+  TexturePtr texture;
+  for (const auto& page : m_pages) {
+    rect = page->packer.insert(size);
+    if (rect)
+    {
+      texture = page->texture.lock();
+      break;
+    }
+  }
+
+  if (!rect)
+  {
+    // pages start out transparent, SDL_CreateRGBSurface() clears the pixels
+    SDLSurfacePtr blank = SDLSurface::create_rgba(PAGE_SIZE, PAGE_SIZE);
+    texture = VideoSystem::current()->new_texture(*blank, Sampler());
+    m_pages.push_back(std::make_unique<Page>(texture, Size(PAGE_SIZE, PAGE_SIZE)));
+    log_debug << "texture atlas: added page " << m_pages.size() - 1 << std::endl;
+
+    rect = m_pages.back()->packer.insert(size);
+    assert(rect);
+  }
+
+  assert(texture);
+  texture->update(*padded, rect->left, rect->top);
+
+  region = Rect(rect->left + PADDING, rect->top + PADDING, srcrect.get_size());
+  Entry& entry = m_entries[key];
+  entry.page = texture;
+  entry.region = region;
+  return create_reference(entry, texture);
+}
+
+TexturePtr
+TextureAtlas::create_reference(Entry& entry, const TexturePtr& page)
+{
+  // points to the page texture, but has a use count of its own
+  TexturePtr texture(std::make_shared<TexturePtr>(page), page.get());
+  entry.texture = texture;
+  return texture;
+}
+
+void
+TextureAtlas::purge_expired_pages()
+{
+  const size_t page_count = m_pages.size();
+  m_pages.erase(std::remove_if(m_pages.begin(), m_pages.end(),
+                               [](const std::unique_ptr<Page>& page) {
+                                 return page->texture.expired();
+                               }),
+                m_pages.end());
+  if (m_pages.size() == page_count)
+    return;
+
+  log_debug << "texture atlas: freed " << page_count - m_pages.size() << " pages" << std::endl;
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.page.expired())
+    {
+      it = m_entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void
+TextureAtlas::get_filenames(std::set<std::string>& filenames) const
+{
+  for (const auto& it : m_entries)
+  {
+    if (!it.second.texture.expired()) {
+      filenames.insert(std::get<0>(it.first));
+    }
+  }
+}
+
+size_t
+TextureAtlas::get_bytes() const
+{
+  size_t bytes = 0;
+  for (const auto& page : m_pages)
+  {
+    if (TexturePtr texture = page->texture.lock())
+    {
+      bytes += static_cast<size_t>(texture->get_texture_width()) *
+               static_cast<size_t>(texture->get_texture_height()) * 4;
+    }
+  }
+  return bytes;
+}
+
+void
+TextureAtlas::debug_print(std::ostream& out) const
+{
+  out << "atlas:begin" << std::endl;
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    const SkylinePacker& packer = m_pages[i]->packer;
+    out << "  page " << i
+        << (m_pages[i]->texture.expired() ? " (freed)" : "")
+        << " images:" << packer.get_count()
+        << " occupancy:" << static_cast<int>(packer.get_occupancy() * 100.0f) << "%"
+        << " height:" << packer.get_height() << "/" << PAGE_SIZE << std::endl;
+  }
+  out << "atlas:end" << std::endl;
+
+  out << "total atlas pages:" << m_pages.size() << std::endl;
+  out << "total atlas images:" << m_entries.size() << std::endl;
+  out << "total atlas images in use:"
+      << std::count_if(m_entries.begin(), m_entries.end(),
+                       [](const std::pair<const Texture::Key, Entry>& it) {
+                         return !it.second.texture.expired();
+                       })
+      << std::endl;
+}
+
+/* EOF */
@@ -0,0 +1,109 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+#define HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "math/rect.hpp"
+#include "video/skyline_packer.hpp"
+#include "video/texture.hpp"
+#include "video/texture_ptr.hpp"
+
+struct SDL_Surface;
+
+/** Packs small images into shared textures, so that drawing
+    different sprites, tiles or particles doesn't require switching
+    the bound texture. Each image is surrounded by a border repeating
+    its edge pixels, so that linear filtering doesn't pick up the
+    neighbouring images.
+
+    Each image is handed out as its own reference to the texture of
+    its page, and the atlas only keeps weak references, so a page is
+    freed once none of its images are used anymore. */
+class TextureAtlas final
+{
+public:
+  TextureAtlas();
+  ~TextureAtlas();
+
+  /** Looks up an image added before, returns nullptr if there is
+      none for @c key or its page was freed */
+  TexturePtr get(const Texture::Key& key, Rect& region);
+
+  /** Packs the @c srcrect part of @c image into a page and returns
+      the texture of that page, with @c region set to the area of the
+      image within it. Returns nullptr if the image is too large to be
+      worth packing. */
+  TexturePtr add(const Texture::Key& key, const SDL_Surface& image, const Rect& srcrect, Rect& region);
+
+  /** Adds the names of the files packed into the atlas that are
+      still in use to @c filenames */
+  void get_filenames(std::set<std::string>& filenames) const;
+
+  /** Returns the size of the pixels of all pages still in use */
+  size_t get_bytes() const;
+
+  void debug_print(std::ostream& out) const;
+
+private:
+  struct Page
+  {
+    Page(const TexturePtr& texture_, const Size& size) :
+      texture(texture_),
+      packer(size)
+    {}
+
+    std::weak_ptr<Texture> texture;
+    SkylinePacker packer;
+  };
+
+  struct Entry
+  {
+    std::weak_ptr<Texture> page;
+    Rect region;
+
+    /** The reference handed out for this image */
+    std::weak_ptr<Texture> texture;
+  };
+
+private:
+  /** Returns a new reference to @c page for @c entry, which keeps
+      the page alive, but can expire on its own */
+  static TexturePtr create_reference(Entry& entry, const TexturePtr& page);
+
+  /** Drops the pages that were freed and the entries on them */
+  void purge_expired_pages();
+
+private:
+  std::vector<std::unique_ptr<Page> > m_pages;
+  std::map<Texture::Key, Entry> m_entries;
+
+private:
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -17,20 +17,25 @@
 #include "video/texture_manager.hpp"
 
 #include <SDL_image.h>
+#include <algorithm>
 #include <assert.h>
 #include <sstream>
 
 #include "math/rect.hpp"
 #include "physfs/physfs_sdl.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "supertux/memory_usage.hpp"
 #include "video/color.hpp"
 #include "video/gl.hpp"
 #include "video/sampler.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
 #include "video/video_system.hpp"
 
 namespace {
@@ -73,31 +78,20 @@ GLenum string2filter(const std::string& text)
   }
 }
 
-} // namespace
-
-TextureManager::TextureManager() :
-  m_image_textures(),
-  m_surfaces()
+/** Only images drawn with the sampler of the atlas pages can share
+    them, wrapping and animation need a texture of their own */
+bool is_packable(const Sampler& sampler)
 {
+  const Sampler page_sampler;
+  return (sampler.get_filter() == page_sampler.get_filter() &&
+          sampler.get_wrap_s() == page_sampler.get_wrap_s() &&
+          sampler.get_wrap_t() == page_sampler.get_wrap_t() &&
+          sampler.get_animate() == page_sampler.get_animate());
 }
 
-TextureManager::~TextureManager()
-{
-  for (const auto& texture : m_image_textures)
-  {
-    if (!texture.second.expired())
-    {
-      log_warning << "Texture '" << std::get<0>(texture.first) << "' not freed" << std::endl;
-    }
-  }
-  m_image_textures.clear();
-  m_surfaces.clear();
-}
-
-TexturePtr
-TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& region)
+void read_texture_mapping(const ReaderMapping& mapping, const boost::optional<Rect>& region,
+                          std::string& filename, boost::optional<Rect>& rect, Sampler& sampler)
 {
-  std::string filename;
   if (!mapping.get("file", filename))
   {
     log_warning << "'file' tag missing" << std::endl;
@@ -107,7 +101,6 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     filename = FileSystem::join(mapping.get_doc().get_directory(), filename);
   }
 
-  boost::optional<Rect> rect;
   std::vector<int> rect_v;
   if (mapping.get("rect", rect_v))
   {
@@ -177,7 +170,64 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     }
   }
 
-  return get(filename, rect, Sampler(filter, wrap_s, wrap_t, animate));
+  sampler = Sampler(filter, wrap_s, wrap_t, animate);
+}
+
+} // namespace
+
+TextureManager::TextureManager() :
+  m_image_textures(),
+  m_texture_sizes(),
+  m_texture_bytes(0),
+  m_surfaces(),
+  m_surface_lru(),
+  m_surface_bytes(0),
+  m_surface_budget(static_cast<size_t>(std::max(0, g_config->surface_cache_size)) * 1024 * 1024),
+  m_surface_hits(0),
+  m_surface_misses(0),
+  m_surface_evictions(0),
+  m_preloaded(),
+  m_atlas(g_config->texture_atlas ? std::make_unique<TextureAtlas>() : nullptr)
+{
+}
+
+TextureManager::~TextureManager()
+{
+  for (const auto& texture : m_image_textures)
+  {
+    if (!texture.second.expired())
+    {
+      log_warning << "Texture '" << std::get<0>(texture.first) << "' not freed" << std::endl;
+    }
+  }
+  m_image_textures.clear();
+  m_texture_sizes.clear();
+  m_surfaces.clear();
+  m_surface_lru.clear();
+  m_preloaded.clear();
+  m_atlas.reset();
+}
+
+TexturePtr
+TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& region)
+{
+  std::string filename;
+  boost::optional<Rect> rect;
+  Sampler sampler;
+  read_texture_mapping(mapping, region, filename, rect, sampler);
+
+  return get(filename, rect, sampler);
+}
+
+TexturePtr
+TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& rect, Rect& region)
+{
+  std::string filename;
+  boost::optional<Rect> texture_rect;
+  Sampler sampler;
+  read_texture_mapping(mapping, rect, filename, texture_rect, sampler);
+
+  return get_packed(filename, texture_rect, sampler, region);
 }
 
 TexturePtr
@@ -193,8 +243,7 @@ TextureManager::get(const std::string& _filename)
 
   if (!texture) {
     texture = create_image_texture(filename, Sampler());
-    texture->m_cache_key = key;
-    m_image_textures[key] = texture;
+    add_texture(key, texture);
   }
 
   return texture;
@@ -231,10 +280,74 @@ TextureManager::get(const std::string& _filename,
     {
       texture = create_image_texture(filename, sampler);
     }
-    texture->m_cache_key = key;
-    m_image_textures[key] = texture;
+    add_texture(key, texture);
+  }
+
+  return texture;
+}
+
+TexturePtr
+TextureManager::get(const std::string& filename, const boost::optional<Rect>& rect, Rect& region)
+{
+  return get_packed(filename, rect, Sampler(), region);
+}
+
+TexturePtr
+TextureManager::get_packed(const std::string& _filename, const boost::optional<Rect>& rect,
+                           const Sampler& sampler, Rect& region)
+{
+  TexturePtr texture;
+  if (!m_atlas || !is_packable(sampler))
+  {
+    texture = get(_filename, rect, sampler);
+    region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+    return texture;
+  }
+
+  std::string filename = FileSystem::normalize(_filename);
+  Texture::Key key(filename, rect ? *rect : Rect());
+
+  texture = m_atlas->get(key, region);
+  if (texture)
+    return texture;
+
+  // images too large for the atlas are cached like in get()
+  auto i = m_image_textures.find(key);
+  if (i != m_image_textures.end())
+    texture = i->second.lock();
+
+  if (!texture)
+  {
+    try
+    {
+      if (rect)
+      {
+        texture = m_atlas->add(key, get_surface(filename), *rect, region);
+        if (texture)
+          return texture;
+
+        texture = create_image_texture_raw(filename, *rect, sampler);
+      }
+      else
+      {
+        SDLSurfacePtr image = load_image(filename);
+        texture = m_atlas->add(key, *image, Rect(0, 0, image->w, image->h), region);
+        if (texture)
+          return texture;
+
+        texture = VideoSystem::current()->new_texture(*image, sampler);
+      }
+    }
+    catch (const std::exception& err)
+    {
+      log_warning << "Couldn't load texture '" << filename << "' (now using dummy texture): " << err.what() << std::endl;
+      texture = create_dummy_texture();
+    }
+
+    add_texture(key, texture);
   }
 
+  region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
   return texture;
 }
 
@@ -249,8 +362,33 @@ TextureManager::reap_cache_entry(const Texture::Key& key)
   else
   {
     assert(i->second.expired());
-    m_image_textures.erase(i);
+    erase_texture(i);
+  }
+}
+
+void
+TextureManager::add_texture(const Texture::Key& key, const TexturePtr& texture)
+{
+  texture->m_cache_key = key;
+  m_image_textures[key] = texture;
+
+  const size_t bytes = static_cast<size_t>(texture->get_texture_width()) *
+                       static_cast<size_t>(texture->get_texture_height()) * 4;
+  m_texture_bytes += bytes;
+  m_texture_bytes -= m_texture_sizes[key];
+  m_texture_sizes[key] = bytes;
+}
+
+std::map<Texture::Key, std::weak_ptr<Texture> >::iterator
+TextureManager::erase_texture(std::map<Texture::Key, std::weak_ptr<Texture> >::iterator it)
+{
+  auto size = m_texture_sizes.find(it->first);
+  if (size != m_texture_sizes.end())
+  {
+    m_texture_bytes -= size->second;
+    m_texture_sizes.erase(size);
   }
+  return m_image_textures.erase(it);
 }
 
 TexturePtr
@@ -273,20 +411,89 @@ TextureManager::get_surface(const std::string& filename)
   auto i = m_surfaces.find(filename);
   if (i != m_surfaces.end())
   {
-    return *i->second;
+    m_surface_hits += 1;
+    m_surface_lru.splice(m_surface_lru.begin(), m_surface_lru, i->second.lru);
+    return *i->second.surface;
   }
-  else
+
+  m_surface_misses += 1;
+
+  SDLSurfacePtr surface = load_image(filename);
+  const size_t bytes = static_cast<size_t>(surface->h) * static_cast<size_t>(surface->pitch);
+
+  m_surface_lru.push_front(filename);
+  CachedSurface& entry = m_surfaces[filename];
+  entry.surface = std::move(surface);
+  entry.bytes = bytes;
+  entry.lru = m_surface_lru.begin();
+  m_surface_bytes += bytes;
+
+  trim_surfaces();
+
+  return *entry.surface;
+}
+
+void
+TextureManager::trim_surfaces()
+{
+  if (m_surface_budget == 0)
+    return;
+
+  bool evicted = false;
+  while (m_surface_bytes > m_surface_budget && m_surface_lru.size() > 1)
   {
-    SDLSurfacePtr image = SDLSurface::from_file(filename);
-    if (!image)
+    auto i = m_surfaces.find(m_surface_lru.back());
+    assert(i != m_surfaces.end());
+
+    log_debug << "evicting decoded image '" << i->first << "' (" << i->second.bytes << " bytes)" << std::endl;
+
+    m_surface_bytes -= i->second.bytes;
+    m_surfaces.erase(i);
+    m_surface_lru.pop_back();
+    m_surface_evictions += 1;
+    evicted = true;
+  }
+
+  if (evicted) {
+    purge_expired_textures();
+  }
+}
+
+void
+TextureManager::purge_expired_textures()
+{
+  for (auto i = m_image_textures.begin(); i != m_image_textures.end();)
+  {
+    if (i->second.expired())
     {
-      std::ostringstream msg;
-      msg << "Couldn't load image '" << filename << "' :" << SDL_GetError();
-      throw std::runtime_error(msg.str());
+      i = erase_texture(i);
     }
+    else
+    {
+      ++i;
+    }
+  }
+}
 
-    return *(m_surfaces[filename] = std::move(image));
+SDLSurfacePtr
+TextureManager::load_image(const std::string& filename)
+{
+  auto i = m_preloaded.find(filename);
+  if (i != m_preloaded.end())
+  {
+    SDLSurfacePtr image = std::move(i->second);
+    m_preloaded.erase(i);
+    return image;
   }
+
+  SDLSurfacePtr image = SDLSurface::from_file(filename);
+  if (!image)
+  {
+    std::ostringstream msg;
+    msg << "Couldn't load image '" << filename << "' :" << SDL_GetError();
+    throw std::runtime_error(msg.str());
+  }
+  return image;
 }
 
 TexturePtr
@@ -341,19 +548,10 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Sampler& sampler)
 {
-  SDLSurfacePtr image = SDLSurface::from_file(filename);
-  if (!image)
-  {
-    std::ostringstream msg;
-    msg << "Couldn't load image '" << filename << "' :" << SDL_GetError();
-    throw std::runtime_error(msg.str());
-  }
-  else
-  {
-    TexturePtr texture = VideoSystem::current()->new_texture(*image, sampler);
-    image.reset(nullptr);
-    return texture;
-  }
+  SDLSurfacePtr image = load_image(filename);
+  TexturePtr texture = VideoSystem::current()->new_texture(*image, sampler);
+  image.reset(nullptr);
+  return texture;
 }
 
 TexturePtr
@@ -385,6 +583,76 @@ TextureManager::create_dummy_texture()
   }
 }
 
+void
+TextureManager::preload(const std::string& filename, SDLSurfacePtr image)
+{
+  m_preloaded[filename] = std::move(image);
+}
+
+void
+TextureManager::clear_preloaded()
+{
+  if (!m_preloaded.empty()) {
+    log_debug << m_preloaded.size() << " preloaded images were not used" << std::endl;
+  }
+  m_preloaded.clear();
+}
+
+std::set<std::string>
+TextureManager::get_filenames() const
+{
+  std::set<std::string> filenames;
+  for (const auto& it : m_image_textures)
+  {
+    if (!it.second.expired()) {
+      filenames.insert(std::get<0>(it.first));
+    }
+  }
+  for (const auto& it : m_surfaces)
+  {
+    filenames.insert(it.first);
+  }
+  if (m_atlas) {
+    m_atlas->get_filenames(filenames);
+  }
+  return filenames;
+}
+
+void
+TextureManager::get_memory_usage(MemoryUsage& usage) const
+{
+  const size_t atlas_bytes = m_atlas ? m_atlas->get_bytes() : 0;
+  usage.add_category("textures", "gpu", m_texture_bytes + atlas_bytes, m_texture_sizes.size());
+  if (usage.wants_entries())
+  {
+    for (const auto& it : m_texture_sizes)
+    {
+      const Rect& rect = std::get<1>(it.first);
+      if (rect.empty())
+      {
+        usage.add_entry(std::get<0>(it.first), it.second);
+      }
+      else
+      {
+        std::ostringstream name;
+        name << std::get<0>(it.first) << " " << rect;
+        usage.add_entry(name.str(), it.second);
+      }
+    }
+    if (m_atlas) {
+      usage.add_entry("(texture atlas)", atlas_bytes);
+    }
+  }
+
+  usage.add_category("images", "cpu", m_surface_bytes, m_surfaces.size());
+  if (usage.wants_entries())
+  {
+    for (const auto& it : m_surfaces) {
+      usage.add_entry(it.first, it.second.bytes);
+    }
+  }
+}
+
 void
 TextureManager::debug_print(std::ostream& out) const
 {
@@ -406,13 +674,14 @@ TextureManager::debug_print(std::ostream& out) const
 
   size_t total_surface_pixels = 0;
   out << "surfaces:begin" << std::endl;
-  for(const auto& it : m_surfaces)
+  for(const auto& filename : m_surface_lru)
   {
-    const auto& filename = it.first;
-    const auto& surface = it.second;
+    const auto& entry = m_surfaces.find(filename)->second;
+    const auto& surface = entry.surface;
 
     total_surface_pixels += surface->w * surface->h;
-    out << "  surface filename:" << filename << " " << surface->w << "x" << surface->h << std::endl;
+    out << "  surface filename:" << filename << " " << surface->w << "x" << surface->h
+        << " bytes:" << entry.bytes << std::endl;
   }
   out << "surfaces:end" << std::endl;
 
@@ -421,6 +690,15 @@ TextureManager::debug_print(std::ostream& out) const
 
   out << "total surface count:" << m_surfaces.size() << std::endl;
   out << "total surface pixels:" << total_surface_pixels << std::endl;
+  out << "total surface bytes:" << m_surface_bytes << std::endl;
+  out << "surface budget bytes:" << m_surface_budget << std::endl;
+  out << "surface hits:" << m_surface_hits
+      << " misses:" << m_surface_misses
+      << " evictions:" << m_surface_evictions << std::endl;
+
+  if (m_atlas) {
+    m_atlas->debug_print(out);
+  }
 }
 
 /* EOF */
@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_VIDEO_TEXTURE_MANAGER_HPP
 
 #include <config.h>
+#include <list>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -34,7 +35,9 @@
 #include "video/texture_ptr.hpp"
 
 class GLTexture;
+class MemoryUsage;
 class ReaderMapping;
+class TextureAtlas;
 struct SDL_Surface;
 
 class TextureManager final : public Currenton<TextureManager>
@@ -52,12 +55,66 @@ public:
                  const boost::optional<Rect>& rect,
                  const Sampler& sampler = Sampler());
 
+  /** Same as get(), but when the texture atlas is enabled in the
+      config, small images are packed into a texture shared with
+      others. @c region is set to the area of the image within the
+      returned texture. */
+  TexturePtr get(const ReaderMapping& mapping, const boost::optional<Rect>& rect, Rect& region);
+  TexturePtr get(const std::string& filename, const boost::optional<Rect>& rect, Rect& region);
+
+  /** Hands over an image that was decoded ahead of time, e.g. by a
+      LevelLoader. It is used instead of reading the file when a
+      texture is created from @c filename. */
+  void preload(const std::string& filename, SDLSurfacePtr image);
+
+  /** Drops the preloaded images no texture was created from */
+  void clear_preloaded();
+
+  /** Returns the names of the image files textures exist for */
+  std::set<std::string> get_filenames() const;
+
+  /** Adds the textures and the decoded images kept for cutting
+      textures out of them */
+  void get_memory_usage(MemoryUsage& usage) const;
+
   void debug_print(std::ostream& out) const;
 
 private:
+  /** A decoded image kept for cutting textures out of it */
+  struct CachedSurface
+  {
+    SDLSurfacePtr surface;
+    size_t bytes;
+
+    /** Position in m_surface_lru */
+    std::list<std::string>::iterator lru;
+  };
+
+private:
+  /** Returns the decoded image of @c filename, reading it again if it
+      was evicted. The reference stays valid until the next call. */
   const SDL_Surface& get_surface(const std::string& filename);
+
+  /** Evicts the least recently used images until the cache fits
+      into its budget again, keeping the most recently used one */
+  void trim_surfaces();
+
+  /** Drops the entries of textures that no longer exist */
+  void purge_expired_textures();
+
+  /** Returns the preloaded image for @c filename or reads the file,
+      throws an exception on error */
+  SDLSurfacePtr load_image(const std::string& filename);
   void reap_cache_entry(const Texture::Key& key);
 
+  /** Puts @c texture into m_image_textures and counts its bytes */
+  void add_texture(const Texture::Key& key, const TexturePtr& texture);
+  std::map<Texture::Key, std::weak_ptr<Texture> >::iterator
+  erase_texture(std::map<Texture::Key, std::weak_ptr<Texture> >::iterator it);
+
+  TexturePtr get_packed(const std::string& filename, const boost::optional<Rect>& rect,
+                        const Sampler& sampler, Rect& region);
+
   TexturePtr create_image_texture(const std::string& filename, const Rect& rect, const Sampler& sampler);
 
   /** on failure a dummy texture is returned and no exception is thrown */
@@ -71,7 +128,29 @@ private:
 
 private:
   std::map<Texture::Key, std::weak_ptr<Texture> > m_image_textures;
-  std::map<std::string, SDLSurfacePtr> m_surfaces;
+
+  /** Bytes of the textures in m_image_textures, counted when they
+      are created, as they can't be asked anymore once expired */
+  std::map<Texture::Key, size_t> m_texture_sizes;
+  size_t m_texture_bytes;
+  std::map<std::string, CachedSurface> m_surfaces;
+
+  /** Filenames of m_surfaces, most recently used first */
+  std::list<std::string> m_surface_lru;
+
+  /** Total size of the pixels in m_surfaces */
+  size_t m_surface_bytes;
+
+  /** Upper limit for m_surface_bytes, 0 for no limit */
+  size_t m_surface_budget;
+
+  int m_surface_hits;
+  int m_surface_misses;
+  int m_surface_evictions;
+  std::map<std::string, SDLSurfacePtr> m_preloaded;
+
+  /** nullptr unless the texture atlas is enabled */
+  std::unique_ptr<TextureAtlas> m_atlas;
 
 private:
   TextureManager(const TextureManager&) = delete;
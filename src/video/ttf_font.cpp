@@ -46,6 +46,9 @@ TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing,
 
 TTFFont::~TTFFont()
 {
+  if (TTFSurfaceManager::current()) {
+    TTFSurfaceManager::current()->forget_font(*this);
+  }
   TTF_CloseFont(m_font);
 }
 
@@ -62,11 +65,11 @@ TTFFont::get_text_width(const std::string& text) const
   {
     const std::string& line = iter.get();
 
-    // Since get_cached_surface_width() takes a surface from the cache
+    // Since get_cached_layout_width() takes a layout from the cache
     // instead of generating it from scratch,
     // it should be faster than doing a whole layout.
-    int line_width = TTFSurfaceManager::current()->get_cached_surface_width(*this, line);
-    if (line_width < 0) {
+    float line_width = TTFSurfaceManager::current()->get_cached_layout_width(*this, line);
+    if (line_width < 0.0f) {
       // Not in cache
       int w = 0;
       int h = 0;
@@ -74,9 +77,9 @@ TTFFont::get_text_width(const std::string& text) const
       if (ret < 0) {
         std::cerr << "TTFFont::get_text_width(): " << TTF_GetError() << std::endl;
       }
-      line_width = w;
+      line_width = static_cast<float>(w);
     }
-    max_width = std::max(max_width, static_cast<float>(line_width));
+    max_width = std::max(max_width, line_width);
   }
 
   return max_width;
@@ -110,21 +113,21 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
 
     if (!line.empty())
     {
-      TTFSurfacePtr ttf_surface = TTFSurfaceManager::current()->create_surface(*this, line);
+      TTFLayoutPtr layout = TTFSurfaceManager::current()->get_layout(*this, line);
 
       Vector new_pos(pos.x, last_y);
 
       if (alignment == ALIGN_CENTER)
       {
-        new_pos.x -= static_cast<float>(ttf_surface->get_width()) / 2.0f;
+        new_pos.x -= layout->width / 2.0f;
       }
       else if (alignment == ALIGN_RIGHT)
       {
-        new_pos.x -= static_cast<float>(ttf_surface->get_width());
+        new_pos.x -= layout->width;
       }
 
       // draw text
-      canvas.draw_surface(ttf_surface->get_surface(), new_pos.floor(), 0.0f, color, Blend(), layer);
+      TTFSurfaceManager::current()->draw(canvas, *layout, new_pos.floor(), color, layer);
     }
 
     last_y += get_height();
@@ -0,0 +1,465 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/ttf_glyph_atlas.hpp"
+
+#include <SDL.h>
+#include <algorithm>
+#include <assert.h>
+
+#include "math/vector.hpp"
+#include "util/log.hpp"
+#include "video/canvas.hpp"
+#include "video/color.hpp"
+#include "video/sampler.hpp"
+#include "video/sdl_surface.hpp"
+#include "video/surface.hpp"
+#include "video/texture.hpp"
+#include "video/ttf_font.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+const int PAGE_SIZE = 1024;
+
+/** Transparent border around each glyph, so that linear filtering
+    doesn't pick up the neighbouring ones */
+const int PADDING = 1;
+
+/** Room needed around the glyphs for their shadow and outline */
+int get_grow(const TTFFont& font)
+{
+  return std::max(font.get_border() * 2, font.get_shadow_size() * 2);
+}
+
+/** How far the outline reaches to the left of and above a glyph */
+int get_outline_offset(const TTFFont& font)
+{
+  return std::min(2, font.get_border());
+}
+
+/** Stands in for malformed UTF-8 characters */
+const uint32_t REPLACEMENT_CHARACTER = 0xfffd;
+
+/** Number of bytes of the UTF-8 character starting at @c text[i],
+    at most four */
+size_t get_char_bytes(const std::string& text, size_t i)
+{
+  size_t char_bytes = 1;
+  while (char_bytes < 4 && i + char_bytes < text.size() &&
+         (text[i + char_bytes] & 128) && !(text[i + char_bytes] & 64)) {
+    // this is a "continuation" byte in the form 10xxxxxx
+    ++char_bytes;
+  }
+  return char_bytes;
+}
+
+/** Decodes the UTF-8 character of @c char_bytes bytes starting at
+    @c text[i], or returns REPLACEMENT_CHARACTER if its first byte
+    doesn't announce that many bytes */
+uint32_t get_code_point(const std::string& text, size_t i, size_t char_bytes)
+{
+  const uint32_t lead = static_cast<uint8_t>(text[i]);
+  if (char_bytes == 1)
+    return (lead & 128) ? REPLACEMENT_CHARACTER : lead;
+
+  // the lead byte starts with as many 1 bits as there are bytes
+  const uint32_t marker = (0xff00 >> char_bytes) & 0xff;
+  if ((lead & ((marker >> 1) | 128)) != marker)
+    return REPLACEMENT_CHARACTER;
+
+  uint32_t code_point = lead & (0x7f >> char_bytes);
+  for (size_t j = 1; j < char_bytes; ++j) {
+    code_point = (code_point << 6) | (static_cast<uint8_t>(text[i + j]) & 63);
+  }
+  return code_point;
+}
+
+/** Horizontal distance from the pen position of @c code_point to
+    that of the next character */
+int get_advance(TTF_Font* font, uint32_t code_point, const std::string& character)
+{
+  int advance = 0;
+  if (code_point <= 0xffff)
+  {
+    TTF_GlyphMetrics(font, static_cast<Uint16>(code_point), nullptr, nullptr, nullptr, nullptr, &advance);
+  }
+  else
+  {
+    // beyond the glyph functions of SDL_ttf
+    int h;
+    TTF_SizeUTF8(font, character.c_str(), &advance, &h);
+  }
+  return advance;
+}
+
+/** Composes the shadow and outline (@c back) or the white core of
+    the glyph in @c text_surface. Both are placed get_outline_offset()
+    pixels right of and below the top left corner of the image, so
+    that the outline on the left and top of the glyph isn't cut off. */
+SDLSurfacePtr compose(const TTFFont& font, SDL_Surface& text_surface, bool back)
+{
+  // FIXME: handle shadow offset
+  const int grow = get_grow(font);
+  const int offset = get_outline_offset(font);
+
+  SDLSurfacePtr target = SDLSurface::create_rgba(text_surface.w + grow + offset,
+                                                 text_surface.h + grow + offset);
+
+#if !SDL_VERSION_ATLEAST(2,0,5)
+  // Perform blitting in ARGB8888, instead of RGBA8888, to avoid bug in older SDL2.
+  // https://bugzilla.libsdl.org/show_bug.cgi?id=3159
+  target.reset(SDL_ConvertSurfaceFormat(target.get(), SDL_PIXELFORMAT_ARGB8888, 0));
+#endif
+
+  using P = std::tuple<int, int>;
+
+  if (back)
+  {
+    { // shadow
+      SDL_SetSurfaceAlphaMod(&text_surface, 192);
+      SDL_SetSurfaceColorMod(&text_surface, 0, 0, 0);
+      SDL_SetSurfaceBlendMode(&text_surface, SDL_BLENDMODE_BLEND);
+
+      const std::initializer_list<std::tuple<int, int> > positions[] = {
+        {},
+        {P{0, 0}},
+        {P{-1, 0}, P{1, 0}, P{0, -1}, P{0, 1}},
+        {P{-2, 0}, P{2, 0}, P{0, -2}, P{0, 2},
+         P{-1, -1}, P{1, -1}, P{-1, 1}, P{1, 1}}
+      };
+
+      int shadow_size = std::min(2, font.get_shadow_size());
+      for (const auto& p : positions[shadow_size])
+      {
+        SDL_Rect dstrect{offset + std::get<0>(p) + 2, offset + std::get<1>(p) + 2,
+                         text_surface.w, text_surface.h};
+        SDL_BlitSurface(&text_surface, nullptr, target.get(), &dstrect);
+      }
+    }
+
+    { // outline
+      SDL_SetSurfaceAlphaMod(&text_surface, 255);
+      SDL_SetSurfaceColorMod(&text_surface, 0, 0, 0);
+      SDL_SetSurfaceBlendMode(&text_surface, SDL_BLENDMODE_BLEND);
+
+      const std::initializer_list<std::tuple<int, int> > positions[] = {
+        {},
+        {P{-1, 0}, P{1, 0}, P{0, -1}, P{0, 1}},
+        {P{-2, 0}, P{2, 0}, P{0, -2}, P{0, 2},
+         P{-1, -1}, P{1, -1}, P{-1, 1}, P{1, 1}}
+      };
+
+      for (const auto& p : positions[offset])
+      {
+        SDL_Rect dstrect{offset + std::get<0>(p), offset + std::get<1>(p),
+                         text_surface.w, text_surface.h};
+        SDL_BlitSurface(&text_surface, nullptr, target.get(), &dstrect);
+      }
+    }
+  }
+  else
+  { // white core
+    SDL_SetSurfaceAlphaMod(&text_surface, 255);
+    SDL_SetSurfaceColorMod(&text_surface, 255, 255, 255);
+    SDL_SetSurfaceBlendMode(&text_surface, SDL_BLENDMODE_BLEND);
+
+    SDL_Rect dstrect{offset, offset, text_surface.w, text_surface.h};
+    SDL_BlitSurface(&text_surface, nullptr, target.get(), &dstrect);
+  }
+
+#if !SDL_VERSION_ATLEAST(2,0,5)
+  target.reset(SDL_ConvertSurfaceFormat(target.get(), SDL_PIXELFORMAT_RGBA8888, 0));
+#endif
+
+  return target;
+}
+
+bool by_page(const TTFLayout::Quad& lhs, const TTFLayout::Quad& rhs)
+{
+  return lhs.page < rhs.page;
+}
+
+} // namespace
+
+TTFLayout::TTFLayout(int text_width, int grow) :
+  width(static_cast<float>(text_width + grow)),
+  back(),
+  core()
+{
+}
+
+void
+TTFLayout::add_quad(std::vector<Quad>& quads, size_t page, const Rect& region, int x, int y)
+{
+  quads.push_back({ page, Rectf(region),
+                    Rectf(Vector(static_cast<float>(x), static_cast<float>(y)),
+                          Sizef(region.get_size())) });
+}
+
+void
+TTFLayout::finish()
+{
+  std::stable_sort(back.begin(), back.end(), by_page);
+  std::stable_sort(core.begin(), core.end(), by_page);
+  back.shrink_to_fit();
+  core.shrink_to_fit();
+}
+
+size_t
+TTFLayout::get_bytes() const
+{
+  return sizeof(TTFLayout) + (back.capacity() + core.capacity()) * sizeof(Quad);
+}
+
+TTFGlyphAtlas::Page::Page(const TexturePtr& texture_, const Size& size) :
+  texture(texture_),
+  surface(Surface::from_texture(texture_)),
+  packer(size),
+  images(0)
+{
+}
+
+TTFGlyphAtlas::TTFGlyphAtlas() :
+  m_pages(),
+  m_glyphs()
+{
+}
+
+TTFGlyphAtlas::~TTFGlyphAtlas()
+{
+}
+
+TTFLayoutPtr
+TTFGlyphAtlas::create_layout(const TTFFont& font, const std::string& text)
+{
+  TTF_Font* ttf_font = font.get_ttf_font();
+
+  int w = 0;
+  int h = 0;
+  if (TTF_SizeUTF8(ttf_font, text.c_str(), &w, &h) < 0) {
+    log_warning << "Couldn't size text '" << text << "': " << TTF_GetError() << std::endl;
+  }
+  auto layout = std::make_shared<TTFLayout>(w, get_grow(font));
+
+  // the glyph images start where their outline does
+  const int offset = get_outline_offset(font);
+
+  // the pen moves by the advance of each glyph plus the kerning
+  // between it and the next one
+  int x = 0;
+  uint32_t previous = 0;
+  for (size_t i = 0; i < text.size();)
+  {
+    const size_t char_bytes = get_char_bytes(text, i);
+    const uint32_t code_point = get_code_point(text, i, char_bytes);
+    const std::string character = (code_point == REPLACEMENT_CHARACTER) ?
+      std::string("\xef\xbf\xbd") : text.substr(i, char_bytes);
+
+    if (previous != 0 && previous <= 0xffff && code_point <= 0xffff) {
+      x += TTF_GetFontKerningSizeGlyphs(ttf_font, static_cast<Uint16>(previous),
+                                        static_cast<Uint16>(code_point));
+    }
+
+    if (character != " ")
+    {
+      const Glyph& glyph = get_glyph(font, code_point, character);
+      if (glyph.back) {
+        TTFLayout::add_quad(layout->back, glyph.back->page, glyph.back->region, x - offset, -offset);
+      }
+      if (glyph.core) {
+        TTFLayout::add_quad(layout->core, glyph.core->page, glyph.core->region, x - offset, -offset);
+      }
+    }
+
+    x += get_advance(ttf_font, code_point, character);
+    previous = code_point;
+    i += char_bytes;
+  }
+
+  layout->finish();
+
+  return layout;
+}
+
+const TTFGlyphAtlas::Glyph&
+TTFGlyphAtlas::get_glyph(const TTFFont& font, uint32_t code_point, const std::string& character)
+{
+  const Key key(font.get_ttf_font(), code_point);
+  auto it = m_glyphs.find(key);
+  if (it != m_glyphs.end())
+    return it->second;
+
+  Glyph& glyph = m_glyphs[key];
+
+  SDLSurfacePtr text_surface(TTF_RenderUTF8_Blended(font.get_ttf_font(),
+                                                    character.c_str(),
+                                                    SDL_Color{255, 255, 255, 255}));
+  if (!text_surface)
+  {
+    log_warning << "Couldn't render glyph '" << character << "': " << SDL_GetError() << std::endl;
+    return glyph;
+  }
+
+  if (font.get_shadow_size() > 0 || font.get_border() > 0)
+  {
+    glyph.back = add_image(*compose(font, *text_surface, true));
+  }
+  glyph.core = add_image(*compose(font, *text_surface, false));
+
+  return glyph;
+}
+
+boost::optional<TTFGlyphAtlas::Image>
+TTFGlyphAtlas::add_image(const SDL_Surface& image)
+{
+  const Size size(image.w + 2 * PADDING, image.h + 2 * PADDING);
+  if (size.width > PAGE_SIZE || size.height > PAGE_SIZE)
+  {
+    log_warning << "glyph of " << image.w << "x" << image.h << " is too large for the atlas" << std::endl;
+    return boost::none;
+  }
+
+  boost::optional<Rect> rect;
+  size_t page = 0;
+  for (; page < m_pages.size(); ++page) {
+    if (m_pages[page]) {
+      rect = m_pages[page]->packer.insert(size);
+      if (rect)
+        break;
+    }
+  }
+
+  if (!rect)
+  {
+    // reuse the slot of a released page, if there is one
+    page = 0;
+    while (page < m_pages.size() && m_pages[page]) {
+      ++page;
+    }
+    if (page == m_pages.size()) {
+      m_pages.emplace_back();
+    }
+
+    // pages start out transparent, SDL_CreateRGBSurface() clears the pixels
+    SDLSurfacePtr blank = SDLSurface::create_rgba(PAGE_SIZE, PAGE_SIZE);
+    TexturePtr texture = VideoSystem::current()->new_texture(*blank, Sampler());
+    m_pages[page] = std::make_unique<Page>(texture, Size(PAGE_SIZE, PAGE_SIZE));
+    log_debug << "glyph atlas: added page " << page << std::endl;
+
+    rect = m_pages[page]->packer.insert(size);
+    assert(rect);
+  }
+
+  m_pages[page]->texture->update(image, rect->left + PADDING, rect->top + PADDING);
+  m_pages[page]->images += 1;
+
+  return Image{ page, Rect(rect->left + PADDING, rect->top + PADDING, Size(image.w, image.h)) };
+}
+
+void
+TTFGlyphAtlas::draw(Canvas& canvas, const TTFLayout& layout, const Vector& pos,
+                    const Color& color, int layer) const
+{
+  draw_quads(canvas, layout.back, pos, color, layer);
+  draw_quads(canvas, layout.core, pos, color, layer);
+}
+
+void
+TTFGlyphAtlas::draw_quads(Canvas& canvas, const std::vector<TTFLayout::Quad>& quads, const Vector& pos,
+                          const Color& color, int layer) const
+{
+  for (size_t begin = 0; begin < quads.size();)
+  {
+    const size_t page = quads[begin].page;
+    size_t end = begin;
+    while (end < quads.size() && quads[end].page == page) {
+      ++end;
+    }
+
+    std::vector<Rectf> srcrects;
+    std::vector<Rectf> dstrects;
+    srcrects.reserve(end - begin);
+    dstrects.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i)
+    {
+      srcrects.push_back(quads[i].srcrect);
+      dstrects.push_back(quads[i].dstrect.moved(pos));
+    }
+
+    assert(m_pages[page]);
+    canvas.draw_surface_batch(m_pages[page]->surface, std::move(srcrects), std::move(dstrects),
+                              color, layer);
+    begin = end;
+  }
+}
+
+void
+TTFGlyphAtlas::forget_font(TTF_Font* font)
+{
+  for (auto it = m_glyphs.begin(); it != m_glyphs.end();)
+  {
+    if (std::get<0>(it->first) == font)
+    {
+      const Glyph& glyph = it->second;
+      if (glyph.back) {
+        release_image(*glyph.back);
+      }
+      if (glyph.core) {
+        release_image(*glyph.core);
+      }
+      it = m_glyphs.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void
+TTFGlyphAtlas::release_image(const Image& image)
+{
+  auto& page = m_pages[image.page];
+  assert(page && page->images > 0);
+
+  page->images -= 1;
+  if (page->images == 0)
+  {
+    // the packer can't hand out the room of single glyphs again, but
+    // a page without any glyphs can go as a whole
+    page.reset();
+    log_debug << "glyph atlas: released page " << image.page << std::endl;
+  }
+}
+
+size_t
+TTFGlyphAtlas::get_page_count() const
+{
+  return static_cast<size_t>(std::count_if(m_pages.begin(), m_pages.end(),
+                                           [](const std::unique_ptr<Page>& page) {
+                                             return page != nullptr;
+                                           }));
+}
+
+size_t
+TTFGlyphAtlas::get_bytes() const
+{
+  return get_page_count() * static_cast<size_t>(PAGE_SIZE) * static_cast<size_t>(PAGE_SIZE) * 4;
+}
+
+/* EOF */
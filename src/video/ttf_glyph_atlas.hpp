@@ -0,0 +1,154 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HEADER_SUPERTUX_VIDEO_TTF_GLYPH_ATLAS_HPP
+#define HEADER_SUPERTUX_VIDEO_TTF_GLYPH_ATLAS_HPP
+
+#include <SDL_ttf.h>
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <boost/optional.hpp>
+
+#include "math/rect.hpp"
+#include "math/rectf.hpp"
+#include "video/skyline_packer.hpp"
+#include "video/surface_ptr.hpp"
+#include "video/texture_ptr.hpp"
+
+class Canvas;
+class Color;
+class TTFFont;
+class Vector;
+struct SDL_Surface;
+
+/** The glyphs of one line of text, positioned relative to its top
+    left corner. Shadows and outlines are kept apart from the glyphs
+    themselves, so that they can all be drawn first, just like when
+    the line is rendered as a whole. */
+struct TTFLayout
+{
+  struct Quad
+  {
+    size_t page;
+    Rectf srcrect;
+    Rectf dstrect;
+  };
+
+  /** @c text_width is the width of the bare text, @c grow the room
+      needed for its shadow and outline */
+  TTFLayout(int text_width, int grow);
+
+  /** Appends the glyph image covering @c region of @c page to
+      @c quads, at @c x, @c y relative to the start of the line */
+  static void add_quad(std::vector<Quad>& quads, size_t page, const Rect& region, int x, int y);
+
+  /** Sorts the quads by page, keeping the glyph order within each
+      page, and trims them */
+  void finish();
+
+  float width;
+
+  /** Both sorted by page once finished */
+  std::vector<Quad> back;
+  std::vector<Quad> core;
+
+  size_t get_bytes() const;
+};
+
+typedef std::shared_ptr<const TTFLayout> TTFLayoutPtr;
+
+/** Rasterizes the glyphs of TTFFonts once into texture pages shared
+    by all fonts, so that drawing text needs neither SDL_ttf nor new
+    textures once its glyphs have been seen. */
+class TTFGlyphAtlas final
+{
+public:
+  TTFGlyphAtlas();
+  ~TTFGlyphAtlas();
+
+  /** Lays out a single line of @c text, rasterizing the glyphs that
+      aren't in the atlas yet */
+  TTFLayoutPtr create_layout(const TTFFont& font, const std::string& text);
+
+  /** Draws @c layout as one batch per page, with its top left corner
+      at @c pos */
+  void draw(Canvas& canvas, const TTFLayout& layout, const Vector& pos,
+            const Color& color, int layer) const;
+
+  /** Drops the glyphs of @c font, as the next font might get the
+      same address, and releases the pages no other glyph is on */
+  void forget_font(TTF_Font* font);
+
+  size_t get_page_count() const;
+  size_t get_glyph_count() const { return m_glyphs.size(); }
+
+  /** Returns the size of the pixels of all pages */
+  size_t get_bytes() const;
+
+private:
+  struct Page
+  {
+    Page(const TexturePtr& texture_, const Size& size);
+
+    TexturePtr texture;
+    SurfacePtr surface;
+    SkylinePacker packer;
+
+    /** Number of glyph images on the page */
+    size_t images;
+  };
+
+  struct Image
+  {
+    size_t page;
+    Rect region;
+  };
+
+  struct Glyph
+  {
+    boost::optional<Image> back;
+    boost::optional<Image> core;
+  };
+
+  /** TTF_Font and the code point of the character */
+  using Key = std::tuple<TTF_Font*, uint32_t>;
+
+private:
+  const Glyph& get_glyph(const TTFFont& font, uint32_t code_point, const std::string& character);
+  boost::optional<Image> add_image(const SDL_Surface& image);
+  void release_image(const Image& image);
+  void draw_quads(Canvas& canvas, const std::vector<TTFLayout::Quad>& quads, const Vector& pos,
+                  const Color& color, int layer) const;
+
+private:
+  /** Released pages are left as nullptr, as the layouts refer to
+      the pages by index */
+  std::vector<std::unique_ptr<Page> > m_pages;
+  std::map<Key, Glyph> m_glyphs;
+
+private:
+  TTFGlyphAtlas(const TTFGlyphAtlas&) = delete;
+  TTFGlyphAtlas& operator=(const TTFGlyphAtlas&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -17,39 +17,38 @@
 #include "video/ttf_surface_manager.hpp"
 
 #include <SDL_ttf.h>
-#include <numeric>
 #include <sstream>
 #include <iostream>
 
 #include "supertux/globals.hpp"
-#include "video/sdl_surface_ptr.hpp"
-#include "video/surface.hpp"
+#include "supertux/memory_usage.hpp"
 #include "video/ttf_font.hpp"
-#include "video/ttf_surface.hpp"
-#include "video/video_system.hpp"
 
-TTFSurfaceManager::CacheEntry::CacheEntry(const TTFSurfacePtr& s) :
-  ttf_surface(s),
-  last_access(g_game_time)
+TTFSurfaceManager::CacheEntry::CacheEntry(const TTFLayoutPtr& l) :
+  layout(l),
+  last_access(g_game_time),
+  bytes(l->get_bytes())
 {
 }
 
 TTFSurfaceManager::TTFSurfaceManager() :
+  m_atlas(),
   m_cache(),
-  m_cache_iter(m_cache.end())
+  m_cache_iter(m_cache.end()),
+  m_cache_bytes(0)
 {
 }
 
-TTFSurfacePtr
-TTFSurfaceManager::create_surface(const TTFFont& font, const std::string& text)
+TTFLayoutPtr
+TTFSurfaceManager::get_layout(const TTFFont& font, const std::string& text)
 {
   auto key = Key(font.get_ttf_font(), text);
   auto it = m_cache.find(key);
   if (it != m_cache.end())
   {
-    auto& entry = m_cache[key];
+    auto& entry = it->second;
     entry.last_access = g_game_time;
-    return entry.ttf_surface;
+    return entry.layout;
   }
   else
   {
@@ -57,30 +56,59 @@ TTFSurfaceManager::create_surface(const TTFFont& font, const std::string& text)
 #if 0
     // Font debug output should go to 'std::cerr', not any of the
     // log_* functions, as those are mirrored on the console which
-    // in turn will lead to the creation of more TTFSurface's and
+    // in turn will lead to the creation of more layouts and
     // screw up the results.
     print_debug_info(std::cerr);
 #endif
 
     cache_cleanup_step();
 
-    TTFSurfacePtr ttf_surface = TTFSurface::create(font, text);
-    m_cache[key] = ttf_surface;
-    return ttf_surface;
+    TTFLayoutPtr layout = m_atlas.create_layout(font, text);
+    CacheEntry& entry = m_cache[key];
+    entry = CacheEntry(layout);
+    m_cache_bytes += entry.bytes;
+    return layout;
   }
 }
 
-int
-TTFSurfaceManager::get_cached_surface_width(const TTFFont& font,
+float
+TTFSurfaceManager::get_cached_layout_width(const TTFFont& font,
   const std::string& text)
 {
   auto key = Key(font.get_ttf_font(), text);
   auto it = m_cache.find(key);
   if (it == m_cache.end())
-    return -1;
-  auto& entry = m_cache[key];
+    return -1.0f;
+  auto& entry = it->second;
   entry.last_access = g_game_time;
-  return entry.ttf_surface->get_width();
+  return entry.layout->width;
+}
+
+void
+TTFSurfaceManager::draw(Canvas& canvas, const TTFLayout& layout, const Vector& pos,
+                        const Color& color, int layer) const
+{
+  m_atlas.draw(canvas, layout, pos, color, layer);
+}
+
+void
+TTFSurfaceManager::forget_font(const TTFFont& font)
+{
+  m_atlas.forget_font(font.get_ttf_font());
+
+  for (auto it = m_cache.begin(); it != m_cache.end();)
+  {
+    if (std::get<0>(it->first) == font.get_ttf_font())
+    {
+      m_cache_bytes -= it->second.bytes;
+      it = m_cache.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  m_cache_iter = m_cache.end();
 }
 
 void
@@ -96,6 +124,7 @@ TTFSurfaceManager::cache_cleanup_step()
 
   while (g_game_time - m_cache_iter->second.last_access > 10.0f)
   {
+    m_cache_bytes -= m_cache_iter->second.bytes;
     m_cache_iter = m_cache.erase(m_cache_iter);
     if (m_cache_iter == m_cache.end())
     {
@@ -109,10 +138,22 @@ TTFSurfaceManager::cache_cleanup_step()
 void
 TTFSurfaceManager::print_debug_info(std::ostream& out)
 {
-  int cache_bytes = std::accumulate(m_cache.begin(), m_cache.end(), 0, [](int accumulator, const std::pair<Key, CacheEntry>& entry) {
-    return accumulator + entry.second.ttf_surface->get_width() * entry.second.ttf_surface->get_height() * 4;
-  });
-  out << "TTFSurfaceManager.cache_size: " << m_cache.size() << "  " << cache_bytes / 1000 << "KB" << std::endl;
+  out << "TTFSurfaceManager.cache_size: " << m_cache.size() << "  " << m_cache_bytes / 1000 << "KB"
+      << "  glyphs: " << m_atlas.get_glyph_count() << " on " << m_atlas.get_page_count() << " pages" << std::endl;
+}
+
+void
+TTFSurfaceManager::get_memory_usage(MemoryUsage& usage) const
+{
+  usage.add_category("glyphs", "gpu", m_atlas.get_bytes(), m_atlas.get_glyph_count());
+
+  usage.add_category("text", "cpu", m_cache_bytes, m_cache.size());
+  if (usage.wants_entries())
+  {
+    for (const auto& it : m_cache) {
+      usage.add_entry(std::get<1>(it.first), it.second.bytes);
+    }
+  }
 }
 
 /* EOF */
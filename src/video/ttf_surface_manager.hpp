@@ -24,42 +24,63 @@
 
 #include "util/currenton.hpp"
 #include "video/color.hpp"
-#include "video/surface_ptr.hpp"
-#include "video/ttf_surface.hpp"
+#include "video/ttf_glyph_atlas.hpp"
 
+class Canvas;
+class MemoryUsage;
 class TTFFont;
+class Vector;
 
+/** Keeps the glyph atlas of the TTFFonts and the layouts of the
+    lines of text drawn recently */
 class TTFSurfaceManager final : public Currenton<TTFSurfaceManager>
 {
 public:
   TTFSurfaceManager();
 
-  TTFSurfacePtr create_surface(const TTFFont& font, const std::string& text);
+  /** Returns the layout of a single line of @c text */
+  TTFLayoutPtr get_layout(const TTFFont& font, const std::string& text);
 
-  // Returns -1 if there is no cached text surface
-  int get_cached_surface_width(const TTFFont& font, const std::string& text);
+  // Returns -1 if there is no cached layout
+  float get_cached_layout_width(const TTFFont& font, const std::string& text);
+
+  void draw(Canvas& canvas, const TTFLayout& layout, const Vector& pos,
+            const Color& color, int layer) const;
+
+  /** Drops the glyphs and layouts of @c font, called when it is
+      closed */
+  void forget_font(const TTFFont& font);
 
   void print_debug_info(std::ostream& out);
 
+  /** Adds the glyph atlas pages and the cached layouts */
+  void get_memory_usage(MemoryUsage& usage) const;
+
 private:
   void cache_cleanup_step();
 
 private:
   struct CacheEntry
   {
-    CacheEntry() : ttf_surface(), last_access() {}
-    CacheEntry(const TTFSurfacePtr& s);
+    CacheEntry() : layout(), last_access(), bytes() {}
+    CacheEntry(const TTFLayoutPtr& l);
 
-    TTFSurfacePtr ttf_surface;
+    TTFLayoutPtr layout;
     float last_access;
+    size_t bytes;
   };
 
 private:
+  TTFGlyphAtlas m_atlas;
+
   using Key = std::tuple<void*, std::string>;
   std::map<Key, CacheEntry> m_cache;
 
   std::map<Key, CacheEntry>::iterator m_cache_iter;
 
+  /** Sum of the bytes of the entries in m_cache */
+  size_t m_cache_bytes;
+
 private:
   TTFSurfaceManager(const TTFSurfaceManager&) = delete;
   TTFSurfaceManager& operator=(const TTFSurfaceManager&) = delete;
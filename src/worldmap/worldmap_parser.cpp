@@ -16,6 +16,7 @@
 
 #include "worldmap/worldmap_parser.hpp"
 
+#include <SDL.h>
 #include <physfs.h>
 
 #include "object/ambient_light.hpp"
@@ -26,6 +27,7 @@
 #include "object/tilemap.hpp"
 #include "physfs/physfs_file_system.hpp"
 #include "physfs/util.hpp"
+#include "supertux/level_metadata_cache.hpp"
 #include "supertux/tile_manager.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
@@ -46,7 +48,10 @@
 namespace worldmap {
 
 WorldMapParser::WorldMapParser(WorldMap& worldmap) :
-  m_worldmap(worldmap)
+  m_worldmap(worldmap),
+  m_level_count(0),
+  m_level_cached(0),
+  m_level_ticks(0)
 {
 }
 
@@ -145,6 +150,12 @@ WorldMapParser::load_worldmap(const std::string& filename)
 
     m_worldmap.flush_game_objects();
 
+    log_info << "Read information of " << m_level_count << " levels in "
+             << static_cast<float>(m_level_ticks) / 1000.0f << " seconds, "
+             << m_level_cached << " from the cache" << std::endl;
+    if (LevelMetadataCache::current())
+      LevelMetadataCache::current()->save();
+
     if (m_worldmap.get_solid_tilemaps().empty())
       throw std::runtime_error("No solid tilemap specified");
 
@@ -184,16 +195,31 @@ WorldMapParser::load_level_information(LevelTile& level)
       return;
     }
 
-    register_translation_directory(filename);
-    auto doc = ReaderDocument::from_file(filename);
-    auto root = doc.get_root();
-    if (root.get_name() != "supertux-level") {
-      return;
-    } else {
-      auto level_mapping = root.get_mapping();
-      level_mapping.get("name", level.m_title);
-      level_mapping.get("target-time", level.m_target_time);
+    const Uint32 start_ticks = SDL_GetTicks();
+    m_level_count += 1;
+
+    if (auto* cache = LevelMetadataCache::current())
+    {
+      const int hits = cache->get_hits();
+      const LevelMetadata metadata = cache->get(filename);
+      m_level_cached += cache->get_hits() - hits;
+      if (!metadata.name.empty())
+        level.m_title = metadata.name;
+      level.m_target_time = metadata.target_time;
     }
+    else
+    {
+      register_translation_directory(filename);
+      auto doc = ReaderDocument::from_file(filename);
+      auto root = doc.get_root();
+      if (root.get_name() == "supertux-level") {
+        auto level_mapping = root.get_mapping();
+        level_mapping.get("name", level.m_title);
+        level_mapping.get("target-time", level.m_target_time);
+      }
+    }
+
+    m_level_ticks += SDL_GetTicks() - start_ticks;
   } catch(std::exception& e) {
     log_warning << "Problem when reading level information: " << e.what() << std::endl;
     return;
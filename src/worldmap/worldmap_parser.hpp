@@ -18,6 +18,7 @@
 #ifndef HEADER_SUPERTUX_WORLDMAP_WORLDMAP_PARSER_HPP
 #define HEADER_SUPERTUX_WORLDMAP_WORLDMAP_PARSER_HPP
 
+#include <stdint.h>
 #include <string>
 
 namespace worldmap {
@@ -36,6 +37,13 @@ public:
 private:
   WorldMap& m_worldmap;
 
+  /** Number of levels, how many of them came from the
+      LevelMetadataCache and the time in milliseconds spent in
+      load_level_information() */
+  int m_level_count;
+  int m_level_cached;
+  uint32_t m_level_ticks;
+
 private:
   WorldMapParser(const WorldMapParser&) = delete;
   WorldMapParser& operator=(const WorldMapParser&) = delete;
@@ -0,0 +1,54 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "supertux/benchmark.hpp"
+
+TEST(BenchmarkTest, percentiles)
+{
+  Benchmark benchmark;
+  ASSERT_EQ(0.0f, benchmark.get_step_percentile(50.0f));
+
+  for (int i = 100; i >= 1; --i) {
+    benchmark.add_step(static_cast<float>(i), 10, 5);
+  }
+
+  ASSERT_EQ(100u, benchmark.get_step_count());
+  ASSERT_EQ(1.0f, benchmark.get_step_percentile(0.0f));
+  ASSERT_EQ(50.0f, benchmark.get_step_percentile(50.0f));
+  ASSERT_EQ(99.0f, benchmark.get_step_percentile(99.0f));
+  ASSERT_EQ(100.0f, benchmark.get_step_percentile(100.0f));
+  ASSERT_EQ(0.0f, benchmark.get_frame_percentile(50.0f));
+}
+
+TEST(BenchmarkTest, print)
+{
+  Benchmark benchmark;
+  benchmark.add_step(0.001f, 10, 4);
+  benchmark.add_step(0.003f, 20, 8);
+
+  std::ostringstream out;
+  benchmark.print(out);
+  ASSERT_NE(std::string::npos, out.str().find("2 steps"));
+  ASSERT_NE(std::string::npos, out.str().find("objects alive: mean 15, max 20"));
+  ASSERT_NE(std::string::npos, out.str().find("total 12"));
+}
+
+/* EOF */
@@ -0,0 +1,94 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "collision/collision_grid.hpp"
+#include "collision/collision_hit.hpp"
+#include "collision/collision_listener.hpp"
+#include "collision/collision_object.hpp"
+
+namespace {
+
+class DummyListener final : public CollisionListener
+{
+public:
+  DummyListener() {}
+
+  virtual void collision_solid(const CollisionHit&) override {}
+  virtual bool collides(GameObject&, const CollisionHit&) const override { return true; }
+  virtual HitResponse collision(GameObject&, const CollisionHit&) override { return CONTINUE; }
+  virtual void collision_tile(uint32_t) override {}
+  virtual bool listener_is_valid() const override { return true; }
+};
+
+std::vector<CollisionObject*> query(const CollisionGrid& grid, const Rectf& rect)
+{
+  std::vector<CollisionObject*> result;
+  grid.query(rect, 0, result);
+  return result;
+}
+
+} // namespace
+
+TEST(CollisionGridTest, query)
+{
+  DummyListener listener;
+  CollisionObject far_away(COLGROUP_STATIC, listener);
+  CollisionObject wide(COLGROUP_STATIC, listener);
+  CollisionObject small(COLGROUP_MOVING, listener);
+
+  far_away.set_size(32.0f, 32.0f);
+  far_away.set_pos(Vector(5000.0f, 5000.0f));
+  wide.set_size(400.0f, 32.0f);
+  wide.set_pos(Vector(0.0f, 0.0f));
+  small.set_size(32.0f, 32.0f);
+  small.set_pos(Vector(100.0f, 0.0f));
+
+  CollisionGrid grid;
+  grid.add(far_away);
+  grid.add(wide);
+  grid.add(small);
+
+  // objects come back once each and in the order they were added
+  ASSERT_EQ(std::vector<CollisionObject*>({ &wide, &small }), query(grid, Rectf(0.0f, 0.0f, 300.0f, 32.0f)));
+  ASSERT_EQ(std::vector<CollisionObject*>({ &far_away }), query(grid, Rectf(4990.0f, 4990.0f, 5000.0f, 5000.0f)));
+
+  // objects sharing a cell with the rectangle but not overlapping it are left out
+  ASSERT_EQ(std::vector<CollisionObject*>(), query(grid, Rectf(200.0f, 40.0f, 210.0f, 50.0f)));
+
+  // moving an object keeps the grid up to date
+  small.set_pos(Vector(5000.0f, 5100.0f));
+  ASSERT_EQ(std::vector<CollisionObject*>({ &far_away, &small }), query(grid, Rectf(4990.0f, 4990.0f, 5100.0f, 5100.0f)));
+  ASSERT_EQ(std::vector<CollisionObject*>({ &wide }), query(grid, Rectf(100.0f, 0.0f, 132.0f, 32.0f)));
+
+  grid.remove(far_away);
+  ASSERT_EQ(std::vector<CollisionObject*>({ &small }), query(grid, Rectf(4990.0f, 4990.0f, 5100.0f, 5100.0f)));
+}
+
+TEST(CollisionGridTest, large_objects)
+{
+  DummyListener listener;
+  CollisionObject huge(COLGROUP_TOUCHABLE, listener);
+  huge.set_size(100000.0f, 100000.0f);
+
+  CollisionGrid grid;
+  grid.add(huge);
+
+  ASSERT_EQ(std::vector<CollisionObject*>({ &huge }), query(grid, Rectf(50000.0f, 50000.0f, 50001.0f, 50001.0f)));
+}
+
+/* EOF */
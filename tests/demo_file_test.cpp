@@ -0,0 +1,101 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "supertux/demo_file.hpp"
+
+namespace {
+
+std::vector<uint8_t> read_all(DemoReader& reader)
+{
+  std::vector<uint8_t> result;
+  uint8_t controls;
+  while (reader.read_step(controls)) {
+    result.push_back(controls);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(DemoFileTest, round_trip)
+{
+  std::vector<uint8_t> steps;
+  for (int i = 0; i < 10000; ++i) {
+    // input changes every few dozen steps, like in real demos
+    steps.push_back(static_cast<uint8_t>((i / 37) % 5 == 0 ? 0x02 : (i / 37) % 3));
+  }
+
+  // the writer owns its stream, keep the buffer out of it
+  std::stringbuf buffer;
+  {
+    DemoWriter writer(std::make_unique<std::ostream>(&buffer), 1234, 0xdeadbeef);
+    for (size_t i = 0; i < steps.size(); ++i) {
+      writer.write_step(steps[i], Vector(static_cast<float>(i), 2.0f));
+    }
+  }
+
+  // the old format took six bytes per step
+  ASSERT_LT(buffer.str().size() * 20, steps.size() * 6);
+
+  DemoReader reader(std::make_unique<std::istringstream>(buffer.str()));
+  ASSERT_EQ(2, reader.get_version());
+  ASSERT_TRUE(reader.has_random_seed());
+  ASSERT_EQ(1234, reader.get_random_seed());
+  ASSERT_EQ(0xdeadbeefu, reader.get_level_hash());
+
+  uint8_t controls;
+  std::vector<uint8_t> result;
+  int keyframes = 0;
+  while (reader.read_step(controls)) {
+    result.push_back(controls);
+    if (const auto* keyframe = reader.get_keyframe()) {
+      ASSERT_EQ(result.size() - 1, keyframe->step);
+      ASSERT_EQ(static_cast<float>(keyframe->step), keyframe->player_pos.x);
+      keyframes += 1;
+    }
+  }
+  ASSERT_EQ(steps, result);
+  ASSERT_EQ((10000 + 255) / 256, keyframes);
+  ASSERT_TRUE(reader.is_finished());
+  ASSERT_EQ(10000u, reader.get_step());
+}
+
+TEST(DemoFileTest, old_format)
+{
+  std::string data = "random_seed=        42";
+  data.push_back('\0');
+  data += std::string("\1\0\0\0\1\0", 6);
+  data += std::string("\0\1\0\0\0\1", 6);
+
+  DemoReader reader(std::make_unique<std::istringstream>(data));
+  ASSERT_EQ(1, reader.get_version());
+  ASSERT_TRUE(reader.has_random_seed());
+  ASSERT_EQ(42, reader.get_random_seed());
+  ASSERT_EQ(std::vector<uint8_t>({ 0x11, 0x22 }), read_all(reader));
+
+  // files without seed start right with the steps
+  DemoReader unseeded(std::make_unique<std::istringstream>(std::string("\0\0\0\0\1\0", 6)));
+  ASSERT_FALSE(unseeded.has_random_seed());
+  ASSERT_EQ(std::vector<uint8_t>({ 0x10 }), read_all(unseeded));
+}
+
+/* EOF */
@@ -0,0 +1,85 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sexp/parser.hpp>
+#include <sstream>
+
+#include "util/document_cache.hpp"
+
+namespace {
+
+sexp::Value parse(const std::string& text)
+{
+  std::istringstream in(text);
+  return sexp::Parser::from_stream(in, sexp::Parser::USE_ARRAYS);
+}
+
+} // namespace
+
+TEST(DocumentCacheTest, roundtrip)
+{
+  const sexp::Value sx = parse(
+    "(supertux-level\n"
+    "  (version 3)\n"
+    "  (name (_ \"Hello World\"))\n"
+    "  (on #t) (off #f)\n"
+    "  (numbers 0 -1 1 -2147483648 2147483647)\n"
+    "  (reals 0.5 -1.25 1e10)\n"
+    "  (empty)\n"
+    "  (mixed 1 \"two\" three 4.0)\n"
+    "  (sector (tilemap (tiles 0 0 12 1024 7 0 0 0)))\n"
+    ")\n");
+
+  const std::string data = DocumentCache::encode(sx);
+  ASSERT_EQ(sx, DocumentCache::decode(data));
+}
+
+TEST(DocumentCacheTest, integer_arrays)
+{
+  const sexp::Value sx = parse("(tilemap (tiles (raw-integers 0)))");
+  const std::vector<std::vector<int> > integer_arrays = { { 0, 12, -1, 2147483647 }, {}, { 7 } };
+
+  std::vector<std::vector<int> > result;
+  ASSERT_EQ(sx, DocumentCache::decode(DocumentCache::encode(sx, integer_arrays), result));
+  ASSERT_EQ(integer_arrays, result);
+
+  // documents without integer lists still decode
+  ASSERT_EQ(sx, DocumentCache::decode(DocumentCache::encode(sx), result));
+  ASSERT_TRUE(result.empty());
+}
+
+TEST(DocumentCacheTest, broken_data)
+{
+  const std::string data = DocumentCache::encode(parse("(tiles 1 2 3 4 5 6 7 8 9)"));
+
+  // every truncation has to be noticed
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_THROW(DocumentCache::decode(data.substr(0, i)), std::runtime_error);
+  }
+  ASSERT_THROW(DocumentCache::decode(data + '\0'), std::runtime_error);
+  ASSERT_THROW(DocumentCache::decode(std::string(1, '\xff')), std::runtime_error);
+}
+
+TEST(DocumentCacheTest, hash)
+{
+  ASSERT_EQ(14695981039346656037ull, DocumentCache::hash(""));
+  ASSERT_NE(DocumentCache::hash("(a 1)"), DocumentCache::hash("(a 2)"));
+}
+
+/* EOF */
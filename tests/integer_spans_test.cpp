@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include "util/integer_spans.hpp"
+
+TEST(IntegerSpansTest, extract)
+{
+  const std::string text =
+    "(tilemap\n"
+    "  (name \"(tiles 1 2 3)\") ; (tiles 4 5 6)\n"
+    "  (tiles 7 -8\n  9 0)\n"
+    "  (tiles-extra 1 2 3)\n"
+    "  (tiles 1 two 3)\n"
+    "  (tiles 10 11 12))\n";
+
+  std::vector<IntegerSpan> spans;
+  const std::string result = extract_integer_spans(text, "tiles", 3, spans);
+
+  ASSERT_EQ(
+    "(tilemap\n"
+    "  (name \"(tiles 1 2 3)\") ; (tiles 4 5 6)\n"
+    "  (tiles (raw-integers 0))\n"
+    "  (tiles-extra 1 2 3)\n"
+    "  (tiles 1 two 3)\n"
+    "  (tiles (raw-integers 1)))\n",
+    result);
+  ASSERT_EQ(2u, spans.size());
+  ASSERT_EQ(4u, spans[0].count);
+
+  std::vector<int> values;
+  read_integer_span(text, spans[0], values);
+  ASSERT_EQ(std::vector<int>({ 7, -8, 9, 0 }), values);
+
+  std::vector<unsigned int> tiles;
+  read_integer_span(text, spans[1], tiles);
+  ASSERT_EQ(std::vector<unsigned int>({ 10, 11, 12 }), tiles);
+}
+
+TEST(IntegerSpansTest, too_short_or_too_long)
+{
+  std::vector<IntegerSpan> spans;
+
+  // too few integers
+  ASSERT_EQ("(tiles 1 2)", extract_integer_spans("(tiles 1 2)", "tiles", 3, spans));
+
+  // numbers that might not fit into an int are left to the parser
+  ASSERT_EQ("(tiles 1 2 12345678901)", extract_integer_spans("(tiles 1 2 12345678901)", "tiles", 3, spans));
+
+  // unterminated
+  ASSERT_EQ("(tiles 1 2 3", extract_integer_spans("(tiles 1 2 3", "tiles", 3, spans));
+
+  ASSERT_TRUE(spans.empty());
+}
+
+/* EOF */
@@ -0,0 +1,70 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "supertux/memory_usage.hpp"
+
+TEST(MemoryUsageTest, get_top)
+{
+  MemoryUsage usage(true);
+  usage.add_category("textures", "gpu", 3000, 2);
+  usage.add_entry("a.png", 1000);
+  usage.add_entry("b.png", 2000);
+  usage.add_category("sounds", "audio", 1500, 1);
+  usage.add_entry("c.wav", 1500);
+
+  ASSERT_EQ(4500u, usage.get_total());
+
+  const auto top = usage.get_top(2);
+  ASSERT_EQ(2u, top.size());
+  ASSERT_EQ("textures: b.png", top[0].name);
+  ASSERT_EQ(2000u, top[0].bytes);
+  ASSERT_EQ("sounds: c.wav", top[1].name);
+}
+
+TEST(MemoryUsageTest, totals_only)
+{
+  MemoryUsage usage(false);
+  usage.add_category("textures", "gpu", 3000, 2);
+  usage.add_entry("a.png", 1000);
+
+  ASSERT_EQ(3000u, usage.get_total());
+  ASSERT_TRUE(usage.get_categories()[0].entries.empty());
+  ASSERT_TRUE(usage.get_top(10).empty());
+}
+
+TEST(MemoryUsageTest, write_json)
+{
+  MemoryUsage usage(true);
+  usage.add_category("ttf", "gpu", 64, 2);
+  usage.add_entry("say \"hi\"", 48);
+  usage.add_entry("a\\b", 16);
+  usage.add_category("sprites", "cpu", 0, 0);
+
+  std::ostringstream out;
+  usage.write_json(out, 1);
+  ASSERT_EQ("{\"total\":64,\"categories\":[\n"
+            "{\"name\":\"ttf\",\"location\":\"gpu\",\"bytes\":64,\"count\":2,"
+            "\"largest\":[{\"name\":\"say \\\"hi\\\"\",\"bytes\":48}]},\n"
+            "{\"name\":\"sprites\",\"location\":\"cpu\",\"bytes\":0,\"count\":0,\"largest\":[]}\n"
+            "]}\n", out.str());
+}
+
+/* EOF */
@@ -0,0 +1,144 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "collision/collision.hpp"
+#include "collision/packed_rects.hpp"
+#include "math/rectf.hpp"
+
+namespace {
+
+std::vector<Rectf> random_rects(size_t count)
+{
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> pos(0.0f, 10000.0f);
+  std::uniform_real_distribution<float> size(1.0f, 64.0f);
+
+  std::vector<Rectf> rects;
+  for (size_t i = 0; i < count; ++i) {
+    rects.push_back(Rectf(Vector(pos(rng), pos(rng)), Sizef(size(rng), size(rng))));
+  }
+  return rects;
+}
+
+} // namespace
+
+TEST(PackedRectsTest, get_overlapping)
+{
+  PackedRects rects;
+  rects.push_back(0.0f, 0.0f, 10.0f, 10.0f);
+  rects.push_back(20.0f, 0.0f, 30.0f, 10.0f);
+  rects.push_back(10.0f, 10.0f, 20.0f, 20.0f);
+
+  std::vector<size_t> result;
+  rects.get_overlapping(Rectf(5.0f, 5.0f, 9.0f, 9.0f), result);
+  ASSERT_EQ(std::vector<size_t>({ 0 }), result);
+
+  // touching edges overlap
+  result.clear();
+  rects.get_overlapping(Rectf(10.0f, 0.0f, 20.0f, 5.0f), result);
+  ASSERT_EQ(std::vector<size_t>({ 0, 1 }), result);
+
+  rects.swap_remove(0);
+  rects.set(0, 100.0f, 100.0f, 110.0f, 110.0f);
+  result.clear();
+  rects.get_overlapping(Rectf(0.0f, 0.0f, 50.0f, 50.0f), result);
+  ASSERT_EQ(std::vector<size_t>({ 1 }), result);
+}
+
+TEST(PackedRectsTest, matches_intersects)
+{
+  // odd count, so the SIMD loops leave a remainder
+  const std::vector<Rectf> source = random_rects(10007);
+
+  PackedRects rects;
+  for (const auto& rect : source) {
+    rects.push_back(rect.get_left(), rect.get_top(), rect.get_right(), rect.get_bottom());
+  }
+
+  for (const auto& query : random_rects(100)) {
+    const Rectf area = query.grown(200.0f);
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < source.size(); ++i) {
+      if (collision::intersects(area, source[i])) {
+        expected.push_back(i);
+      }
+    }
+
+    std::vector<size_t> result;
+    rects.get_overlapping(area, result);
+    ASSERT_EQ(expected, result);
+
+    result.clear();
+    rects.get_overlapping_scalar(area, result);
+    ASSERT_EQ(expected, result);
+  }
+}
+
+TEST(PackedRectsTest, benchmark)
+{
+  const size_t count = 10000;
+  const int rounds = 200;
+  const std::vector<Rectf> source = random_rects(count);
+  const std::vector<Rectf> queries = random_rects(rounds);
+
+  // the way CollisionSystem used to see the rectangles: one heap
+  // object per rectangle, reached through a pointer
+  std::vector<std::unique_ptr<Rectf> > objects;
+  PackedRects rects;
+  for (const auto& rect : source) {
+    objects.push_back(std::make_unique<Rectf>(rect));
+    rects.push_back(rect.get_left(), rect.get_top(), rect.get_right(), rect.get_bottom());
+  }
+
+  size_t hits_objects = 0;
+  const auto start_objects = std::chrono::steady_clock::now();
+  for (const auto& query : queries) {
+    for (const auto& object : objects) {
+      if (collision::intersects(query, *object)) {
+        hits_objects += 1;
+      }
+    }
+  }
+  const auto end_objects = std::chrono::steady_clock::now();
+
+  size_t hits_packed = 0;
+  std::vector<size_t> result;
+  const auto start_packed = std::chrono::steady_clock::now();
+  for (const auto& query : queries) {
+    result.clear();
+    rects.get_overlapping(query, result);
+    hits_packed += result.size();
+  }
+  const auto end_packed = std::chrono::steady_clock::now();
+
+  ASSERT_EQ(hits_objects, hits_packed);
+
+  using std::chrono::microseconds;
+  std::cout << "[          ] " << rounds << " queries against " << count << " rects: "
+            << std::chrono::duration_cast<microseconds>(end_objects - start_objects).count() << "us per object, "
+            << std::chrono::duration_cast<microseconds>(end_packed - start_packed).count() << "us packed"
+            << std::endl;
+}
+
+/* EOF */
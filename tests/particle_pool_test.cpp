@@ -0,0 +1,102 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "object/particle_pool.hpp"
+
+namespace {
+
+void fill_random(ParticlePool& pool, size_t count)
+{
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> pos(-5000.0f, 5000.0f);
+  std::uniform_real_distribution<float> speed(-100.0f, 100.0f);
+
+  for (size_t i = 0; i < count; ++i) {
+    const size_t index = pool.add(pos(rng), pos(rng), static_cast<uint8_t>(i % 3));
+    pool.speed[index] = speed(rng);
+  }
+}
+
+} // namespace
+
+TEST(ParticlePoolTest, add_and_remove)
+{
+  ParticlePool pool;
+  const size_t channel = pool.add_channel();
+
+  for (int i = 0; i < 5; ++i) {
+    const size_t index = pool.add(static_cast<float>(i), 0.0f, 0);
+    pool.channel(channel)[index] = static_cast<float>(i * 10);
+  }
+  ASSERT_EQ(5u, pool.size());
+  ASSERT_EQ(1.0f, pool.alpha[4]);
+
+  pool.swap_remove(1);
+  ASSERT_EQ(4u, pool.size());
+  ASSERT_EQ(4.0f, pool.x[1]);
+  ASSERT_EQ(40.0f, pool.channel(channel)[1]);
+
+  pool.shrink(2);
+  ASSERT_EQ(2u, pool.size());
+  ASSERT_EQ(2u, pool.channel(channel).size());
+
+  pool.clear();
+  ASSERT_TRUE(pool.empty());
+}
+
+TEST(ParticlePoolTest, move_matches_scalar)
+{
+  // odd count, so the SIMD loops leave a remainder
+  ParticlePool pool;
+  ParticlePool scalar;
+  fill_random(pool, 1003);
+  fill_random(scalar, 1003);
+
+  for (int i = 0; i < 10; ++i) {
+    pool.move(Vector(0.016f, -0.032f));
+    scalar.move_scalar(Vector(0.016f, -0.032f));
+  }
+
+  ASSERT_EQ(scalar.x, pool.x);
+  ASSERT_EQ(scalar.y, pool.y);
+}
+
+TEST(ParticlePoolTest, wrap_matches_scalar)
+{
+  ParticlePool pool;
+  fill_random(pool, 1003);
+
+  const Vector scroll(123.5f, -77.25f);
+  const Sizef size(1280.0f, 800.0f);
+
+  std::vector<float> x, y, scalar_x, scalar_y;
+  pool.wrap(scroll, size, x, y);
+  pool.wrap_scalar(scroll, size, scalar_x, scalar_y);
+  ASSERT_EQ(scalar_x, x);
+  ASSERT_EQ(scalar_y, y);
+
+  for (size_t i = 0; i < pool.size(); ++i) {
+    ASSERT_NEAR(fmodf(pool.x[i] - scroll.x, size.width), x[i], 0.01f);
+    ASSERT_NEAR(fmodf(pool.y[i] - scroll.y, size.height), y[i], 0.01f);
+  }
+}
+
+/* EOF */
@@ -0,0 +1,85 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "util/profiler.hpp"
+
+namespace {
+
+/** Returns the thread id of the first event named @c name in @c trace,
+    or -1 if there is none */
+int get_tid(const std::string& trace, const std::string& name)
+{
+  const std::string event = "\"name\":\"" + name + "\",";
+  const size_t pos = trace.find(event);
+  if (pos == std::string::npos)
+    return -1;
+
+  const std::string key = "\"tid\":";
+  const size_t tid = trace.find(key, pos);
+  if (tid == std::string::npos)
+    return -1;
+
+  return std::stoi(trace.substr(tid + key.size()));
+}
+
+} // namespace
+
+TEST(ProfilerTest, write_trace)
+{
+  Profiler::frame();
+  {
+    ProfileScope outer("outer");
+    ProfileScope inner("inner \"quoted\"");
+  }
+  std::thread([] { ProfileScope scope("worker"); }).join();
+  Profiler::frame();
+  {
+    ProfileScope scope("next frame");
+  }
+  Profiler::frame();
+
+  std::ostringstream out;
+  Profiler::write_trace(out, 1);
+  ASSERT_NE(std::string::npos, out.str().find("\"traceEvents\""));
+  ASSERT_NE(std::string::npos, out.str().find("\"name\":\"next frame\",\"ph\":\"X\""));
+  ASSERT_EQ(std::string::npos, out.str().find("outer"));
+
+  out.str("");
+  Profiler::write_trace(out, 2);
+  ASSERT_NE(std::string::npos, out.str().find("\"outer\""));
+  ASSERT_NE(std::string::npos, out.str().find("\"inner \\\"quoted\\\"\""));
+
+  // thread ids depend on the order in which threads first recorded a
+  // scope, so only check that the worker got one of its own
+  const int main_tid = get_tid(out.str(), "outer");
+  const int worker_tid = get_tid(out.str(), "worker");
+  ASSERT_NE(-1, main_tid);
+  ASSERT_NE(-1, worker_tid);
+  ASSERT_NE(main_tid, worker_tid);
+
+  std::vector<float> frame_times;
+  Profiler::get_frame_times(frame_times);
+  ASSERT_EQ(2u, frame_times.size());
+}
+
+/* EOF */
@@ -0,0 +1,71 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "video/skyline_packer.hpp"
+
+TEST(SkylinePackerTest, insert)
+{
+  SkylinePacker packer(Size(64, 64));
+
+  ASSERT_EQ(Rect(0, 0, 32, 16), packer.insert(Size(32, 16)).get());
+  ASSERT_EQ(Rect(32, 0, 64, 32), packer.insert(Size(32, 32)).get());
+
+  // goes on top of the lower segment
+  ASSERT_EQ(Rect(0, 16, 32, 48), packer.insert(Size(32, 32)).get());
+
+  ASSERT_FALSE(packer.insert(Size(65, 1)));
+  ASSERT_FALSE(packer.insert(Size(64, 33)));
+  ASSERT_EQ(Rect(0, 48, 64, 64), packer.insert(Size(64, 16)).get());
+  ASSERT_FALSE(packer.insert(Size(1, 1)));
+
+  ASSERT_EQ(4, packer.get_count());
+  ASSERT_EQ(64, packer.get_height());
+  // the 32x16 area right of the third rect is lost
+  ASSERT_FLOAT_EQ(0.875f, packer.get_occupancy());
+}
+
+TEST(SkylinePackerTest, no_overlap)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> size(1, 80);
+
+  SkylinePacker packer(Size(512, 512));
+  std::vector<Rect> rects;
+  for (int i = 0; i < 1000; ++i)
+  {
+    auto rect = packer.insert(Size(size(rng), size(rng)));
+    if (!rect)
+      continue;
+
+    ASSERT_TRUE(Rect(0, 0, 512, 512).contains(*rect));
+    for (const auto& other : rects) {
+      ASSERT_TRUE(rect->right <= other.left || rect->left >= other.right ||
+                  rect->bottom <= other.top || rect->top >= other.bottom);
+    }
+    rects.push_back(*rect);
+  }
+
+  ASSERT_EQ(static_cast<int>(rects.size()), packer.get_count());
+  ASSERT_GT(packer.get_occupancy(), 0.5f);
+}
+
+/* EOF */
@@ -0,0 +1,77 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include "util/tile_encoding.hpp"
+
+TEST(TileEncodingTest, roundtrip)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<unsigned int> tile(0, 4000);
+
+  for (size_t count : { 0, 1, 2, 3, 4, 5, 100, 1000 }) {
+    std::vector<unsigned int> tiles;
+    for (size_t i = 0; i < count; ++i) {
+      // mix single tiles and runs
+      tiles.insert(tiles.end(), (i % 3 == 0) ? 10 : 1, tile(rng));
+    }
+    tiles.push_back(UINT32_MAX);
+
+    std::vector<unsigned int> result;
+    TileEncoding::decode(TileEncoding::encode(tiles), result);
+    ASSERT_EQ(tiles, result);
+  }
+}
+
+TEST(TileEncodingTest, empty_layer)
+{
+  // a 1000x200 layer with a single row of ground
+  std::vector<unsigned int> tiles(1000 * 200, 0);
+  for (size_t i = 199 * 1000; i < tiles.size(); ++i) {
+    tiles[i] = 7 + (i % 4);
+  }
+
+  std::ostringstream text;
+  for (const auto& tile : tiles) {
+    text << tile << " ";
+  }
+
+  const std::string encoded = TileEncoding::encode(tiles);
+  ASSERT_LT(encoded.size() * 10, text.str().size());
+
+  std::vector<unsigned int> result;
+  TileEncoding::decode(encoded, result);
+  ASSERT_EQ(tiles, result);
+}
+
+TEST(TileEncodingTest, broken)
+{
+  std::vector<unsigned int> tiles;
+  ASSERT_THROW(TileEncoding::decode("!!!!", tiles), std::runtime_error);
+
+  // run length without a tile
+  ASSERT_THROW(TileEncoding::decode("BQ==", tiles), std::runtime_error);
+
+  // run of zero tiles
+  ASSERT_THROW(TileEncoding::decode("AAE=", tiles), std::runtime_error);
+}
+
+/* EOF */
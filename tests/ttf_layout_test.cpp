@@ -0,0 +1,59 @@
+//  SuperTux
+//  Copyright (C) 2021 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gtest/gtest.h>
+
+#include "video/ttf_glyph_atlas.hpp"
+
+TEST(TTFLayoutTest, width)
+{
+  // the shadow and outline stick out of the text
+  ASSERT_FLOAT_EQ(104.0f, TTFLayout(100, 4).width);
+  ASSERT_FLOAT_EQ(0.0f, TTFLayout(0, 0).width);
+}
+
+TEST(TTFLayoutTest, sorted_by_page)
+{
+  TTFLayout layout(50, 2);
+  TTFLayout::add_quad(layout.core, 1, Rect(0, 0, 8, 10), 0, 0);
+  TTFLayout::add_quad(layout.core, 0, Rect(8, 0, 14, 10), 9, 0);
+  TTFLayout::add_quad(layout.core, 1, Rect(16, 0, 24, 12), 16, 0);
+  TTFLayout::add_quad(layout.core, 0, Rect(24, 0, 28, 10), 25, 0);
+  TTFLayout::add_quad(layout.back, 2, Rect(0, 0, 10, 12), -1, -1);
+  layout.finish();
+
+  ASSERT_EQ(4, layout.core.size());
+  const size_t pages[] = { 0, 0, 1, 1 };
+  const float xs[] = { 9.0f, 25.0f, 0.0f, 16.0f };
+  for (size_t i = 0; i < layout.core.size(); ++i)
+  {
+    // the glyph order stays the same within each page
+    ASSERT_EQ(pages[i], layout.core[i].page);
+    ASSERT_FLOAT_EQ(xs[i], layout.core[i].dstrect.get_left());
+  }
+
+  const TTFLayout::Quad& quad = layout.core[2];
+  ASSERT_EQ(Rectf(0.0f, 0.0f, 8.0f, 10.0f), quad.srcrect);
+  ASSERT_EQ(Rectf(0.0f, 0.0f, 8.0f, 10.0f), quad.dstrect);
+
+  ASSERT_EQ(1, layout.back.size());
+  ASSERT_EQ(2, layout.back[0].page);
+  // outlines start left of and above the glyph
+  ASSERT_EQ(Rectf(-1.0f, -1.0f, 9.0f, 11.0f), layout.back[0].dstrect);
+}
+
+/* EOF */